@@ -134,6 +134,11 @@ struct x86_cpuboot x86_cpuboot[] = {
  * will enter the kernel at fn(arg), running on the specified stack.
  */
 
+void arch_spin_relax(void)
+{
+	__asm__ volatile("pause");
+}
+
 void arch_start_cpu(int cpu_num, k_thread_stack_t *stack, int sz,
 		    arch_cpustart_t fn, void *arg)
 {
@@ -175,6 +175,18 @@ void arch_sched_ipi(void)
 {
 	z_loapic_ipi(0, LOAPIC_ICR_IPI_OTHERS, CONFIG_SCHED_IPI_VECTOR);
 }
+
+void arch_sched_directed_ipi(uint32_t cpu_bitmap)
+{
+	unsigned int num_cpus = arch_num_cpus();
+
+	for (int i = 0; i < num_cpus; i++) {
+		if ((cpu_bitmap & BIT(i)) != 0U) {
+			z_loapic_ipi(x86_cpu_loapics[i], LOAPIC_ICR_IPI_SPECIFIC,
+				     CONFIG_SCHED_IPI_VECTOR);
+		}
+	}
+}
 #endif
 
 /* The first bit is used to indicate whether the list of reserved interrupts
@@ -81,6 +81,89 @@ struct json_obj_token {
 	size_t length;
 };
 
+/**
+ * @brief Token of a streaming JSON document
+ *
+ * Strings and numbers are NUL terminated copies held by the buffer of
+ * the parser, valid until the next call. Like the other parsers, it
+ * doesn't unescape strings.
+ */
+struct json_stream_token {
+	/** Type: an object or array start or end, or a value */
+	enum json_tokens type;
+	/** Whether the string is an object key */
+	bool key;
+	/** Contents of a string without the quotes, or of a number */
+	char *start;
+	/** Length of the contents */
+	size_t length;
+};
+
+/**
+ * @brief Streaming JSON parser state
+ *
+ * All the state needed to resume parsing where the previous input chunk
+ * stopped: the token in progress is accumulated in the buffer given
+ * to json_stream_init(), and the nesting of objects and arrays in a
+ * bitmap.
+ */
+struct json_stream {
+	/** @cond INTERNAL_HIDDEN */
+	char *buf;
+	size_t buf_size;
+	/* Start of the buffer available to the next token, the data
+	 * before it is kept.
+	 */
+	size_t kept;
+	/* End of the token in progress */
+	size_t len;
+	/* Bit n set if nesting level n is an object, not an array */
+	uint32_t objects;
+	uint8_t depth;
+	/* Lexer and grammar state */
+	uint8_t lex;
+	uint8_t expect;
+	/* Progress in a literal or \u escape */
+	uint8_t lit;
+	/** @endcond */
+};
+
+/** @cond INTERNAL_HIDDEN */
+/* Object or array decoded by a json_stream_obj */
+struct json_stream_frame {
+	/* Fields of an object, or element of an array */
+	const struct json_obj_descr *descr;
+	/* Number of fields, or maximum number of elements */
+	size_t descr_len;
+	/* Struct of an object, or array */
+	void *val;
+	/* Number of elements of an array, if stored */
+	size_t *count;
+	/* Decoded fields of an object, or number of elements */
+	int32_t decoded;
+	bool array;
+};
+/** @endcond */
+
+#if defined(CONFIG_JSON_STREAM_MAX_DEPTH) || defined(__DOXYGEN__)
+/**
+ * @brief Streaming decoder of a JSON object into a struct
+ */
+struct json_stream_obj {
+	/** @cond INTERNAL_HIDDEN */
+	struct json_stream stream;
+	/* Objects and arrays being decoded */
+	struct json_stream_frame frames[CONFIG_JSON_STREAM_MAX_DEPTH];
+	uint8_t depth;
+	/* Nesting level of the value being skipped, if any */
+	uint8_t skip;
+	/* Field of the value following a key, NULL to skip it */
+	const struct json_obj_descr *field;
+	int result;
+	/** @endcond */
+};
+#endif
+
 
 struct json_obj_descr {
 	const char *field_name;
@@ -658,6 +741,89 @@ int json_arr_separate_object_parse_init(struct json_obj *json, char *payload, si
 int json_arr_separate_parse_object(struct json_obj *json, const struct json_obj_descr *descr,
 				   size_t descr_len, void *val);
 
+/**
+ * @brief Initialize a streaming JSON parser
+ *
+ * The streaming parser takes a document in chunks of any size, and
+ * returns its tokens one by one as soon as they are complete, so that
+ * the document never needs to be held in memory as a whole. It only
+ * needs @a buf to hold the longest string or number of the document,
+ * and accepts up to 32 levels of nesting. The document must be an
+ * object or an array.
+ *
+ * @param stream Parser state.
+ * @param buf Buffer for the token in progress.
+ * @param buf_size Size of @a buf, at least the length of the longest
+ *                 string or number of the document plus one.
+ */
+void json_stream_init(struct json_stream *stream, char *buf, size_t buf_size);
+
+/**
+ * @brief Get the next token of a streaming JSON document
+ *
+ * Consumes the input up to the end of the next token, or all of it.
+ * Colons and commas are checked but not returned.
+ *
+ * @param stream Parser state.
+ * @param data Pointer to the input, advanced past the consumed data.
+ * @param len Pointer to the length of the input, decreased by the length
+ *            of the consumed data.
+ * @param tok Filled with the token.
+ *
+ * @retval 1 A token was returned in @a tok.
+ * @retval 0 The document is complete, any further input must be
+ *           whitespace.
+ * @retval -EAGAIN The input was consumed without completing a token, call
+ *                 again with the next chunk.
+ * @retval -EINVAL The document is invalid.
+ * @retval -ENOMEM A string or number doesn't fit in the buffer.
+ * @retval -E2BIG The document is nested too deeply.
+ */
+int json_stream_next(struct json_stream *stream, const char **data,
+		     size_t *len, struct json_stream_token *tok);
+
+#if defined(CONFIG_JSON_STREAM_MAX_DEPTH) || defined(__DOXYGEN__)
+/**
+ * @brief Initialize the streaming decoding of a JSON object
+ *
+ * Decodes the same descriptors as json_obj_parse(), with the values
+ * stored in the struct as soon as they are parsed, except for
+ * @ref JSON_TOK_OBJ_ARRAY fields which aren't supported. Strings are
+ * copied to @a buf, which must be large enough to hold all the string,
+ * @ref JSON_TOK_FLOAT and @ref JSON_TOK_OPAQUE values of the fields
+ * plus the longest other token, each with a NUL terminator. Keys which
+ * aren't in the descriptor are skipped along with their values, objects
+ * and arrays included.
+ *
+ * @param obj Decoder state.
+ * @param descr Pointer to the descriptor array.
+ * @param descr_len Number of elements in the descriptor array. Must be
+ *                  less than 31.
+ * @param val Pointer to the struct to hold the decoded values.
+ * @param buf Buffer for the strings and the token in progress.
+ * @param buf_size Size of @a buf.
+ */
+void json_stream_obj_parse_init(struct json_stream_obj *obj,
+				const struct json_obj_descr *descr,
+				size_t descr_len, void *val,
+				char *buf, size_t buf_size);
+
+/**
+ * @brief Decode a chunk of a streaming JSON object
+ *
+ * @param obj Decoder state.
+ * @param data Next chunk of the JSON-encoded object.
+ * @param len Length of the chunk.
+ *
+ * @return -EAGAIN if the object is incomplete, the bitmap of decoded
+ *         fields as returned by json_obj_parse() once it is complete,
+ *         or a negative error code, as defined in errno.h, if it is
+ *         invalid or doesn't fit in the descriptor or the buffer.
+ */
+int json_stream_obj_parse(struct json_stream_obj *obj, const char *data,
+			  size_t len);
+#endif
+
 /**
  * @brief Escapes the string so it can be used to encode JSON objects
  *
@@ -1738,10 +1738,23 @@ static inline uint64_t k_cycle_get_64(void)
  * @cond INTERNAL_HIDDEN
  */
 
+/* Threads may be pending on the queue */
+#define Z_QUEUE_WAITING_THREADS BIT(0)
+/* The queue was polled: lockless appends must signal pollers, so they
+ * always take the locked path from then on.
+ */
+#define Z_QUEUE_WAITING_POLL BIT(1)
+
 struct k_queue {
 	sys_sflist_t data_q;
 	struct k_spinlock lock;
 	_wait_q_t wait_q;
+#ifdef CONFIG_QUEUE_LOCKFREE_APPEND
+	/* Items appended locklessly, most recent first */
+	atomic_ptr_t pending;
+	/* Z_QUEUE_WAITING_* flags, set when someone may need waking up */
+	atomic_t waiting;
+#endif
 
 	_POLL_EVENT;
 
@@ -1979,6 +1992,11 @@ __syscall int k_queue_is_empty(struct k_queue *queue);
 
 static inline int z_impl_k_queue_is_empty(struct k_queue *queue)
 {
+#ifdef CONFIG_QUEUE_LOCKFREE_APPEND
+	if (atomic_ptr_get(&queue->pending) != NULL) {
+		return 0;
+	}
+#endif
 	return (int)sys_sflist_is_empty(&queue->data_q);
 }
 
@@ -3037,6 +3055,22 @@ __syscall int k_sem_take(struct k_sem *sem, k_timeout_t timeout);
  */
 __syscall void k_sem_give(struct k_sem *sem);
 
+/**
+ * @brief Give a semaphore several times at once.
+ *
+ * This routine is equivalent to calling k_sem_give() @a n times, but
+ * wakes all the threads it releases in a single pass, with a single
+ * rescheduling decision.  Up to @a n waiting threads are woken up, in
+ * the order k_sem_give() would wake them, and any remaining units are
+ * added to the count of @a sem, up to its maximum permitted count.
+ *
+ * @funcprops \isr_ok
+ *
+ * @param sem Address of the semaphore.
+ * @param n Number of units to give.
+ */
+__syscall void k_sem_give_n(struct k_sem *sem, unsigned int n);
+
 /**
  * @brief Resets a semaphore's count to zero.
  *
@@ -3306,6 +3340,45 @@ void k_work_queue_start(struct k_work_q *queue,
 			k_thread_stack_t *stack, size_t stack_size,
 			int prio, const struct k_work_queue_config *cfg);
 
+/** @brief Initialize a work queue served by a pool of threads.
+ *
+ * This works like k_work_queue_start() but starts @p nthreads threads
+ * taking work items from the queue, so that independent items can be
+ * processed in parallel on SMP systems.  A work item is still never run
+ * by two threads at once, and flushing or cancelling it waits for the
+ * thread running it as with a single thread.  Items are started in
+ * order, but may complete out of order.
+ *
+ * @note Requires @kconfig{CONFIG_WORK_QUEUE_POOL}.
+ *
+ * @param queue pointer to the queue structure. It must be initialized
+ *        in zeroed/bss memory or with @ref k_work_queue_init before
+ *        use.
+ *
+ * @param threads array of @p nthreads - 1 thread structures, for the
+ *        threads besides the one returned by k_work_queue_thread_get().
+ *        May be NULL if @p nthreads is 1.
+ *
+ * @param stacks array of @p nthreads pointers to thread stack areas, the
+ *        first one being for the thread returned by
+ *        k_work_queue_thread_get().
+ *
+ * @param stack_size size of each of the thread stack areas, in bytes.
+ *
+ * @param nthreads number of threads serving the queue, at least 1.
+ *
+ * @param prio initial priority of all the threads
+ *
+ * @param cfg optional additional configuration parameters.  Pass @c
+ * NULL if not required, to use the defaults documented in
+ * k_work_queue_config.
+ */
+void k_work_queue_start_pool(struct k_work_q *queue,
+			     struct k_thread *threads,
+			     k_thread_stack_t *const *stacks,
+			     size_t stack_size, int nthreads, int prio,
+			     const struct k_work_queue_config *cfg);
+
 /** @brief Access the thread that animates a work queue.
  *
  * This is necessary to grant a work queue thread access to things the work
@@ -3373,6 +3446,29 @@ int k_work_queue_unplug(struct k_work_q *queue);
 void k_work_init_delayable(struct k_work_delayable *dwork,
 			   k_work_handler_t handler);
 
+/** @brief Set how late a delayable work item may be submitted.
+ *
+ * Once set, scheduling the work item with k_work_schedule(),
+ * k_work_reschedule() or their variants allows the kernel to submit it up
+ * to @p slack after the requested delay.  Delayable work items whose
+ * expiries fall within each other's slack then share a single timeout,
+ * which keeps the timeout list short and saves wakeups from idle.
+ *
+ * The slack only applies to the scheduling operations invoked after it is
+ * set.  It is reset by k_work_init_delayable().
+ *
+ * @note Requires @kconfig{CONFIG_WORK_DELAYABLE_SLACK}.
+ *
+ * @funcprops \isr_ok
+ *
+ * @param dwork pointer to the delayable work item.
+ *
+ * @param slack how late the work item may be submitted, @c K_NO_WAIT to
+ * have it submitted on time.
+ */
+void k_work_delayable_slack_set(struct k_work_delayable *dwork,
+				k_timeout_t slack);
+
 /**
  * @brief Get the parent delayable work structure from a work pointer.
  *
@@ -3739,6 +3835,22 @@ struct k_work_delayable {
 
 	/* The queue to which the work should be submitted. */
 	struct k_work_q *queue;
+
+#ifdef CONFIG_WORK_DELAYABLE_SLACK
+	/* How late the work may be submitted, in ticks. */
+	k_ticks_t slack;
+
+	/* The item whose timeout also submits this one: itself if it
+	 * submits other items, or null if not coalesced.
+	 */
+	struct k_work_delayable *leader;
+
+	/* Link in the list of leaders, or in the followers of leader. */
+	sys_snode_t coalesce_node;
+
+	/* Items submitted along with this one, if a leader. */
+	sys_slist_t followers;
+#endif
 };
 
 #define Z_WORK_DELAYABLE_INITIALIZER(work_handler) { \
@@ -3782,6 +3894,10 @@ struct k_work_delayable {
 struct z_work_flusher {
 	struct k_work work;
 	struct k_sem sem;
+#ifdef CONFIG_WORK_QUEUE_POOL
+	/* The work item being flushed */
+	struct k_work *target;
+#endif
 };
 
 /* Record used to wait for work to complete a cancellation.
@@ -3846,6 +3962,16 @@ struct k_work_queue_config {
 	 * control.
 	 */
 	bool no_yield;
+
+	/** Control whether the threads of a work queue pool are pinned
+	 * to CPUs.
+	 *
+	 * Set this to @c true to pin the threads started by
+	 * k_work_queue_start_pool() to the CPUs in turn, so that each
+	 * CPU serves the queue.  This requires @kconfig{CONFIG_SCHED_CPU_MASK}
+	 * and is ignored by k_work_queue_start().
+	 */
+	bool pin_cpus;
 };
 
 /** @brief A structure used to hold work until it can be processed. */
@@ -3868,6 +3994,15 @@ struct k_work_q {
 
 	/* Flags describing queue state. */
 	uint32_t flags;
+
+#ifdef CONFIG_WORK_QUEUE_POOL
+	/* Threads animating the work besides thread, and their number. */
+	struct k_thread *pool;
+	uint16_t pool_size;
+
+	/* Number of work items being run. */
+	uint16_t running;
+#endif
 };
 
 /* Provide the implementation for inline functions declared above */
@@ -3892,12 +4027,23 @@ static inline bool k_work_delayable_is_pending(
 static inline k_ticks_t k_work_delayable_expires_get(
 	const struct k_work_delayable *dwork)
 {
+#ifdef CONFIG_WORK_DELAYABLE_SLACK
+	/* Coalesced items wait on the timeout of their leader */
+	if (dwork->leader != NULL) {
+		dwork = dwork->leader;
+	}
+#endif
 	return z_timeout_expires(&dwork->timeout);
 }
 
 static inline k_ticks_t k_work_delayable_remaining_get(
 	const struct k_work_delayable *dwork)
 {
+#ifdef CONFIG_WORK_DELAYABLE_SLACK
+	if (dwork->leader != NULL) {
+		dwork = dwork->leader;
+	}
+#endif
 	return z_timeout_remaining(&dwork->timeout);
 }
 
@@ -4246,6 +4392,8 @@ extern int k_work_poll_cancel(struct k_work_poll *work);
 struct k_msgq {
 	/** Message queue wait queue */
 	_wait_q_t wait_q;
+	/** Threads waiting in place of, or because of, zero-copy access */
+	_wait_q_t busy_q;
 	/** Lock */
 	struct k_spinlock lock;
 	/** Message size */
@@ -4278,6 +4426,7 @@ struct k_msgq {
 #define Z_MSGQ_INITIALIZER(obj, q_buffer, q_msg_size, q_max_msgs) \
 	{ \
 	.wait_q = Z_WAIT_Q_INIT(&obj.wait_q), \
+	.busy_q = Z_WAIT_Q_INIT(&obj.busy_q), \
 	.msg_size = q_msg_size, \
 	.max_msgs = q_max_msgs, \
 	.buffer_start = q_buffer, \
@@ -4294,6 +4443,8 @@ struct k_msgq {
 
 
 #define K_MSGQ_FLAG_ALLOC	BIT(0)
+#define K_MSGQ_FLAG_RESERVED	BIT(1)
+#define K_MSGQ_FLAG_CLAIMED	BIT(2)
 
 /**
  * @brief Message Queue Attributes
@@ -4408,6 +4559,8 @@ int k_msgq_cleanup(struct k_msgq *msgq);
  * @retval 0 Message sent.
  * @retval -ENOMSG Returned without waiting or queue purged.
  * @retval -EAGAIN Waiting period timed out.
+ * @retval -EBUSY Returned without waiting, a slot is reserved with
+ *                k_msgq_reserve().
  */
 __syscall int k_msgq_put(struct k_msgq *msgq, const void *data, k_timeout_t timeout);
 
@@ -4430,6 +4583,8 @@ __syscall int k_msgq_put(struct k_msgq *msgq, const void *data, k_timeout_t time
  * @retval 0 Message received.
  * @retval -ENOMSG Returned without waiting.
  * @retval -EAGAIN Waiting period timed out.
+ * @retval -EBUSY Returned without waiting, the first message is claimed
+ *                with k_msgq_peek_ref().
  */
 __syscall int k_msgq_get(struct k_msgq *msgq, void *data, k_timeout_t timeout);
 
@@ -4449,12 +4604,106 @@ __syscall int k_msgq_get(struct k_msgq *msgq, void *data, k_timeout_t timeout);
  */
 __syscall int k_msgq_peek(struct k_msgq *msgq, void *data);
 
+/**
+ * @brief Reserve a slot in a message queue for in-place writing.
+ *
+ * This routine reserves the next free slot of the message queue's ring
+ * buffer and returns its address, so that the message can be built in
+ * place rather than being copied in by k_msgq_put(). The message becomes
+ * visible to receivers once k_msgq_commit() is called.
+ *
+ * Only one slot can be reserved at a time: until the reservation is
+ * committed, k_msgq_put() and other reservations wait for it, or fail
+ * with -EBUSY if they were not to wait.
+ *
+ * @note This routine is not available to user mode threads, as it hands
+ * out a pointer into the kernel-owned ring buffer.
+ *
+ * @funcprops \isr_ok
+ *
+ * @param msgq Address of the message queue.
+ * @param msg Address of the pointer set to the reserved slot.
+ * @param timeout Waiting period for a free slot,
+ *                or one of the special values K_NO_WAIT and
+ *                K_FOREVER.
+ *
+ * @retval 0 Slot reserved.
+ * @retval -ENOMSG Returned without waiting.
+ * @retval -EAGAIN Waiting period timed out.
+ * @retval -EBUSY Returned without waiting, a slot is already reserved.
+ */
+int k_msgq_reserve(struct k_msgq *msgq, void **msg, k_timeout_t timeout);
+
+/**
+ * @brief Send a message written in place to a message queue.
+ *
+ * This routine sends the message written to the slot obtained from
+ * k_msgq_reserve().
+ *
+ * @funcprops \isr_ok
+ *
+ * @param msgq Address of the message queue.
+ *
+ * @retval 0 Message sent.
+ * @retval -EINVAL No slot is reserved.
+ */
+int k_msgq_commit(struct k_msgq *msgq);
+
+/**
+ * @brief Read a message in place from a message queue.
+ *
+ * This routine returns the address of the first message in the message
+ * queue's ring buffer, waiting for one if the queue is empty. Unlike
+ * k_msgq_peek() nothing is copied. The message stays in the queue until
+ * k_msgq_release() is called.
+ *
+ * Only one message can be claimed at a time: until it is released,
+ * k_msgq_get() and other calls to this routine wait for it, or fail with
+ * -EBUSY if they were not to wait.
+ *
+ * @note This routine is not available to user mode threads, as it hands
+ * out a pointer into the kernel-owned ring buffer.
+ *
+ * @funcprops \isr_ok
+ *
+ * @param msgq Address of the message queue.
+ * @param msg Address of the pointer set to the message.
+ * @param timeout Waiting period for a message,
+ *                or one of the special values K_NO_WAIT and
+ *                K_FOREVER.
+ *
+ * @retval 0 Message claimed.
+ * @retval -ENOMSG Returned without waiting.
+ * @retval -EAGAIN Waiting period timed out.
+ * @retval -EBUSY Returned without waiting, a message is already claimed.
+ */
+int k_msgq_peek_ref(struct k_msgq *msgq, void **msg, k_timeout_t timeout);
+
+/**
+ * @brief Remove a message read in place from a message queue.
+ *
+ * This routine removes the message obtained from k_msgq_peek_ref() from
+ * the queue, making its slot available to senders again.
+ *
+ * @funcprops \isr_ok
+ *
+ * @param msgq Address of the message queue.
+ *
+ * @retval 0 Message removed.
+ * @retval -EINVAL No message is claimed.
+ */
+int k_msgq_release(struct k_msgq *msgq);
+
 /**
  * @brief Purge a message queue.
  *
  * This routine discards all unreceived messages in a message queue's ring
  * buffer. Any threads that are blocked waiting to send a message to the
- * message queue are unblocked and see an -ENOMSG error code.
+ * message queue are unblocked and see an -ENOMSG error code. If a slot
+ * is reserved with k_msgq_reserve() or a message claimed with
+ * k_msgq_peek_ref(), this routine first waits for it to be committed or
+ * released (and so must not be called from an ISR, nor by the thread
+ * holding it).
  *
  * @param msgq Address of the message queue.
  */
@@ -4875,6 +5124,17 @@ __syscall void k_pipe_buffer_flush(struct k_pipe *pipe);
  * @cond INTERNAL_HIDDEN
  */
 
+#ifdef CONFIG_MEM_SLAB_PERCPU_CACHE
+/* Per-CPU stash of free blocks, used ahead of the shared free list */
+struct z_mem_slab_cache {
+	struct k_spinlock lock;
+	char *free_list;
+	uint32_t count;
+	uint32_t hits;
+	uint32_t misses;
+};
+#endif
+
 struct k_mem_slab {
 	_wait_q_t wait_q;
 	struct k_spinlock lock;
@@ -4882,10 +5142,18 @@ struct k_mem_slab {
 	size_t block_size;
 	char *buffer;
 	char *free_list;
+	/* Blocks off the shared free list, including per-CPU cached ones */
 	uint32_t num_used;
 #ifdef CONFIG_MEM_SLAB_TRACE_MAX_UTILIZATION
 	uint32_t max_used;
 #endif
+#ifdef CONFIG_MEM_SLAB_PERCPU_CACHE
+	/* Set while threads may be waiting for a block, which forces
+	 * every allocation and free through the shared free list.
+	 */
+	bool bypass_cache;
+	struct z_mem_slab_cache cache[CONFIG_MP_MAX_NUM_CPUS];
+#endif
 
 	SYS_PORT_TRACING_TRACKING_FIELD(k_mem_slab)
 };
@@ -5026,6 +5294,12 @@ extern int k_mem_slab_alloc(struct k_mem_slab *slab, void **mem,
  */
 extern void k_mem_slab_free(struct k_mem_slab *slab, void **mem);
 
+/** @cond INTERNAL_HIDDEN */
+#ifdef CONFIG_MEM_SLAB_PERCPU_CACHE
+uint32_t z_mem_slab_num_cached(struct k_mem_slab *slab);
+#endif
+/** @endcond */
+
 /**
  * @brief Get the number of used blocks in a memory slab.
  *
@@ -5038,7 +5312,11 @@ extern void k_mem_slab_free(struct k_mem_slab *slab, void **mem);
  */
 static inline uint32_t k_mem_slab_num_used_get(struct k_mem_slab *slab)
 {
+#ifdef CONFIG_MEM_SLAB_PERCPU_CACHE
+	return slab->num_used - z_mem_slab_num_cached(slab);
+#else
 	return slab->num_used;
+#endif
 }
 
 /**
@@ -5073,7 +5351,7 @@ static inline uint32_t k_mem_slab_max_used_get(struct k_mem_slab *slab)
  */
 static inline uint32_t k_mem_slab_num_free_get(struct k_mem_slab *slab)
 {
-	return slab->num_blocks - slab->num_used;
+	return slab->num_blocks - k_mem_slab_num_used_get(slab);
 }
 
 /**
@@ -5103,6 +5381,36 @@ int k_mem_slab_runtime_stats_get(struct k_mem_slab *slab, struct sys_memory_stat
  */
 int k_mem_slab_runtime_stats_reset_max(struct k_mem_slab *slab);
 
+/**
+ * @brief Per-CPU cache statistics of a memory slab
+ */
+struct k_mem_slab_cache_stats {
+	/** Blocks currently held in per-CPU caches */
+	uint32_t cached_blocks;
+	/** Allocations served from a per-CPU cache */
+	uint32_t hits;
+	/** Allocations that had to take the shared free list */
+	uint32_t misses;
+};
+
+/**
+ * @brief Get the per-CPU cache statistics for a memory slab
+ *
+ * This routine sums the per-CPU cache counters of the slab @a slab.
+ * Blocks held in the caches are reported as free by
+ * k_mem_slab_runtime_stats_get().
+ *
+ * @note Available when CONFIG_MEM_SLAB_PERCPU_CACHE is enabled.
+ *
+ * @param slab Address of the memory slab
+ * @param stats Pointer to memory into which to copy the cache statistics
+ *
+ * @retval 0 Success
+ * @retval -EINVAL Any parameter points to NULL
+ */
+int k_mem_slab_cache_stats_get(struct k_mem_slab *slab,
+			       struct k_mem_slab_cache_stats *stats);
+
 /** @} */
 
 /**
@@ -5112,10 +5420,28 @@ int k_mem_slab_runtime_stats_reset_max(struct k_mem_slab *slab);
 
 /* kernel synchronized heap struct */
 
+#ifdef CONFIG_K_HEAP_CACHE
+/* Per-CPU free lists of small blocks, one per power-of-two size
+ * class starting at 16 bytes, used ahead of the sys_heap.
+ */
+struct z_heap_cache {
+	struct k_spinlock lock;
+	void *free_list[CONFIG_K_HEAP_CACHE_CLASSES];
+	uint8_t count[CONFIG_K_HEAP_CACHE_CLASSES];
+	uint32_t hits;
+	uint32_t misses;
+};
+#endif
+
 struct k_heap {
 	struct sys_heap heap;
 	_wait_q_t wait_q;
 	struct k_spinlock lock;
+#ifdef CONFIG_K_HEAP_CACHE
+	/* Set while allocations fail, forcing frees to the sys_heap */
+	bool bypass_cache;
+	struct z_heap_cache cache[CONFIG_MP_MAX_NUM_CPUS];
+#endif
 };
 
 /**
@@ -5191,6 +5517,34 @@ void *k_heap_alloc(struct k_heap *h, size_t bytes,
  */
 void k_heap_free(struct k_heap *h, void *mem);
 
+/**
+ * @brief Small block cache statistics of a k_heap
+ */
+struct k_heap_cache_stats {
+	/** Bytes currently held in per-CPU caches */
+	size_t cached_bytes;
+	/** Allocations served from a per-CPU cache */
+	uint32_t hits;
+	/** Small allocations that had to go to the sys_heap */
+	uint32_t misses;
+};
+
+/**
+ * @brief Get the small block cache statistics of a k_heap
+ *
+ * Cached blocks are still accounted as allocated by the underlying
+ * sys_heap statistics.
+ *
+ * @note Available when CONFIG_K_HEAP_CACHE is enabled.
+ *
+ * @param h Heap to query
+ * @param stats Pointer to memory into which to copy the statistics
+ *
+ * @retval 0 Success
+ * @retval -EINVAL Any parameter points to NULL
+ */
+int k_heap_cache_stats_get(struct k_heap *h, struct k_heap_cache_stats *stats);
+
 /* Hand-calculated minimum heap sizes needed to return a successful
  * 1-byte allocation.  See details in lib/os/heap.[ch]
  */
@@ -5482,6 +5836,11 @@ struct k_poll_event {
 	/** unused bits in 32-bit word */
 	uint32_t unused:_POLL_EVENT_NUM_UNUSED_BITS;
 
+#ifdef CONFIG_POLL_SET
+	/** PRIVATE - DO NOT TOUCH */
+	sys_dnode_t _ready_node;
+#endif
+
 	/** per-type data */
 	union {
 		void *obj;
@@ -5641,6 +6000,91 @@ __syscall void k_poll_signal_check(struct k_poll_signal *sig,
 
 __syscall int k_poll_signal_raise(struct k_poll_signal *sig, int result);
 
+#if defined(CONFIG_POLL_SET) || defined(__DOXYGEN__)
+
+/**
+ * @brief Persistent poll set
+ *
+ * Events added to a poll set stay registered with their objects until
+ * removed, so waiting on the set costs nothing per registered event:
+ * objects record their events in the set's ready list as they signal
+ * them, and k_poll_set_wait() only looks at that list.
+ */
+struct k_poll_set {
+	/** PRIVATE - DO NOT TOUCH */
+	struct z_poller poller;
+	struct k_spinlock lock;
+	_wait_q_t wait_q;
+
+	/* Events signaled since they were last returned */
+	sys_dlist_t ready;
+
+	/* Events returned by the last k_poll_set_wait() */
+	sys_dlist_t returned;
+};
+
+/**
+ * @brief Initialize a poll set.
+ *
+ * @param set Poll set to initialize.
+ */
+void k_poll_set_init(struct k_poll_set *set);
+
+/**
+ * @brief Add an event to a poll set.
+ *
+ * Registers @a event, initialized with k_poll_event_init() or one of
+ * the static initializers, with its object for as long as it stays in
+ * the set.  The event must not be passed to k_poll() or another set
+ * in the meantime.  If the event condition is already met, the next
+ * k_poll_set_wait() returns it.
+ *
+ * @param set Poll set.
+ * @param event Event to add.
+ *
+ * @retval 0 Event added.
+ * @retval -EBUSY Event is already registered, by this set or elsewhere.
+ */
+int k_poll_set_add(struct k_poll_set *set, struct k_poll_event *event);
+
+/**
+ * @brief Remove an event from a poll set.
+ *
+ * Must not be called while a thread waits on the set.
+ *
+ * @param set Poll set.
+ * @param event Event to remove.
+ *
+ * @retval 0 Event removed.
+ * @retval -EINVAL Event is not part of this set.
+ */
+int k_poll_set_remove(struct k_poll_set *set, struct k_poll_event *event);
+
+/**
+ * @brief Wait for events of a poll set to become ready.
+ *
+ * Stores up to @a max ready events of the set into @a ready, with
+ * their state field set as k_poll() would.  Readiness is level
+ * triggered: an event returned here whose condition still holds on
+ * the next call, say a FIFO that was not drained, is returned again.
+ *
+ * A set is meant to be waited on by a single thread at a time.  This
+ * routine may be called from an ISR only with a K_NO_WAIT timeout.
+ *
+ * @param set Poll set.
+ * @param ready Array receiving pointers to the ready events.
+ * @param max Size of @a ready, must be at least 1.
+ * @param timeout Waiting period for an event to be ready,
+ *                or one of the special values K_NO_WAIT and K_FOREVER.
+ *
+ * @return Number of events stored into @a ready, or -EAGAIN if none
+ *         became ready within the waiting period.
+ */
+int k_poll_set_wait(struct k_poll_set *set, struct k_poll_event **ready,
+		    int max, k_timeout_t timeout);
+
+#endif /* CONFIG_POLL_SET */
+
 /**
  * @internal
  */
@@ -5874,6 +6318,28 @@ int k_thread_runtime_stats_get(k_tid_t thread,
  */
 int k_thread_runtime_stats_all_get(k_thread_runtime_stats_t *stats);
 
+/**
+ * @brief Get the scheduling latency statistics of a thread
+ *
+ * Requires CONFIG_SCHED_THREAD_LATENCY.
+ *
+ * @param thread ID of thread.
+ * @param stats Pointer to struct to copy statistics into.
+ * @return -EINVAL if null pointers, otherwise 0
+ */
+int k_thread_latency_stats_get(k_tid_t thread,
+			       k_thread_latency_stats_t *stats);
+
+/**
+ * @brief Reset the scheduling latency statistics of a thread
+ *
+ * Requires CONFIG_SCHED_THREAD_LATENCY.
+ *
+ * @param thread ID of thread.
+ * @return -EINVAL if null pointer, otherwise 0
+ */
+int k_thread_latency_stats_reset(k_tid_t thread);
+
 /**
  * @brief Enable gathering of runtime statistics for specified thread
  *
@@ -5914,6 +6380,116 @@ extern void k_sys_runtime_stats_enable(void);
  */
 extern void k_sys_runtime_stats_disable(void);
 
+/** Number of idle duration buckets in @ref k_idle_stats */
+#define K_IDLE_STATS_BUCKETS 24
+
+/**
+ * @brief Idle statistics of a CPU
+ *
+ * An idle period starts when the idle thread puts the CPU to sleep and
+ * ends at the first interrupt or context switch after that.
+ */
+struct k_idle_stats {
+	/**
+	 * Idle periods by duration: periods[0] counts those shorter
+	 * than 2 us, periods[i] those lasting [2^i, 2^(i+1)) us, and the
+	 * last bucket everything longer.
+	 */
+	uint32_t periods[K_IDLE_STATS_BUCKETS];
+	/** Total time spent in idle periods, in microseconds */
+	uint64_t idle_us;
+	/** Longest idle period, in microseconds */
+	uint32_t longest_us;
+	/** Periods ended by an expiring timeout */
+	uint32_t timeout_wakeups;
+	/** Periods ended by a timer interrupt which expired nothing */
+	uint32_t tick_wakeups;
+	/** Periods ended by any other interrupt, including IPIs */
+	uint32_t other_wakeups;
+};
+
+/**
+ * @brief Timeout callback which woke a CPU from idle
+ */
+struct k_idle_wakeup {
+	/** Callback of the expiring timeouts, e.g. the one of all k_timers */
+	_timeout_func_t fn;
+	/** Most recent timeout to wake the CPU with this callback */
+	const struct _timeout *last;
+	/** Number of wakeups */
+	uint32_t count;
+};
+
+/**
+ * @brief Get the idle statistics of a CPU
+ *
+ * Requires CONFIG_IDLE_STATS.
+ *
+ * @param cpu CPU index
+ * @param stats Pointer to struct to copy statistics into.
+ * @return -EINVAL if @a cpu is invalid or @a stats is null, otherwise 0
+ */
+int k_idle_stats_get(int cpu, struct k_idle_stats *stats);
+
+/**
+ * @brief Get the timeout callbacks which woke CPUs from idle most often
+ *
+ * Up to CONFIG_IDLE_STATS_WAKEUP_SOURCES callbacks are tracked across
+ * all CPUs.  Requires CONFIG_IDLE_STATS.
+ *
+ * @param wakeups Array to copy the entries into, most frequent first.
+ * @param max Number of entries @a wakeups can hold.
+ * @return Number of entries copied
+ */
+int k_idle_wakeups_get(struct k_idle_wakeup *wakeups, int max);
+
+/**
+ * @brief Reset the idle statistics of all CPUs
+ *
+ * Requires CONFIG_IDLE_STATS.
+ */
+void k_idle_stats_reset(void);
+
+/**
+ * @brief Contention statistics of a lock
+ */
+struct k_lock_stats {
+	/** Address of the k_spinlock or k_mutex */
+	const void *lock;
+	/** True for a k_mutex, false for a k_spinlock */
+	bool mutex;
+	/** Number of times the lock was taken */
+	uint32_t acquisitions;
+	/** Number of those which had to wait for another holder */
+	uint32_t contended;
+	/** Total time spent waiting for the lock, in cycles */
+	uint64_t wait_cycles;
+	/** Longest time the lock was held, in cycles */
+	uint32_t max_hold_cycles;
+	/** Return address of the call which took the lock for that hold */
+	void *max_hold_site;
+};
+
+/**
+ * @brief Get the statistics of the most contended locks
+ *
+ * Locks are sorted by number of contended acquisitions, then by total
+ * wait time.  Recursive k_mutex locks by the owner are not counted.
+ * Requires CONFIG_LOCK_STATS.
+ *
+ * @param stats Array to copy the entries into.
+ * @param max Number of entries @a stats can hold.
+ * @return Number of entries copied
+ */
+int k_lock_stats_get(struct k_lock_stats *stats, int max);
+
+/**
+ * @brief Reset the statistics of all locks
+ *
+ * Requires CONFIG_LOCK_STATS.
+ */
+void k_lock_stats_reset(void);
+
 #ifdef __cplusplus
 }
 #endif
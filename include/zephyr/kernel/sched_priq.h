@@ -57,4 +57,26 @@ struct _priq_mq {
 
 struct k_thread *z_priq_mq_best(struct _priq_mq *pq);
 
+/* Bitmap-indexed variant of the multi-queue, with one list per
+ * priority covering the full configured priority range.  Each list
+ * is kept sorted by deadline so that the head of the first non-empty
+ * list is always the best thread, keeping selection O(1) while still
+ * honoring SCHED_DEADLINE.  Sorted insertion only walks threads of
+ * the same priority, and threads without (or with later) deadlines
+ * are appended in constant time.
+ */
+#define Z_PRIQ_BITMAP_LEVELS (CONFIG_NUM_COOP_PRIORITIES + \
+			      CONFIG_NUM_PREEMPT_PRIORITIES + 1)
+#define Z_PRIQ_BITMAP_WORDS ceiling_fraction(Z_PRIQ_BITMAP_LEVELS, 32)
+
+struct _priq_bitmap {
+	sys_dlist_t queues[Z_PRIQ_BITMAP_LEVELS];
+	/* bit i%32 of word i/32 set if queues[i] is non-empty */
+	uint32_t bitmask[Z_PRIQ_BITMAP_WORDS];
+};
+
+void z_priq_bitmap_add(struct _priq_bitmap *pq, struct k_thread *thread);
+void z_priq_bitmap_remove(struct _priq_bitmap *pq, struct k_thread *thread);
+struct k_thread *z_priq_bitmap_best(struct _priq_bitmap *pq);
+
 #endif /* ZEPHYR_INCLUDE_SCHED_PRIQ_H_ */
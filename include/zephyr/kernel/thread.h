@@ -53,6 +53,25 @@ struct _pipe_desc {
 	struct k_thread *thread;         /* Back pointer to pended thread */
 };
 
+/** Number of buckets in a @ref k_thread_latency_stats histogram */
+#define K_THREAD_LATENCY_BUCKETS 24
+
+/**
+ * Scheduling latency of a thread: the time from it being made ready
+ * (woken up, started, resumed...) to it being switched in.  Being
+ * preempted and put back in the run queue is not counted.
+ */
+typedef struct k_thread_latency_stats {
+	/**
+	 * Latencies by log2 of their duration in cycles: hist[0] counts
+	 * those of 0 cycles, hist[i] those in [2^(i-1), 2^i) cycles, and
+	 * the last bucket everything longer.
+	 */
+	uint32_t hist[K_THREAD_LATENCY_BUCKETS];
+	/** Longest latency, in cycles */
+	uint32_t max_cycles;
+} k_thread_latency_stats_t;
+
 /* can be used for creating 'dummy' threads, e.g. for pending on objects */
 struct _thread_base {
 
@@ -140,6 +159,12 @@ struct _thread_base {
 #ifdef CONFIG_SCHED_THREAD_USAGE
 	struct k_cycle_stats  usage;   /* Track thread usage statistics */
 #endif
+
+#ifdef CONFIG_SCHED_THREAD_LATENCY
+	/* Cycle count when made ready, 0 if not waiting to be switched in */
+	uint32_t ready_cycles;
+	k_thread_latency_stats_t latency;
+#endif
 };
 
 typedef struct _thread_base _thread_base_t;
@@ -221,6 +246,13 @@ typedef struct k_thread_runtime_stats {
 	 */
 
 	uint64_t idle_cycles;
+
+	/*
+	 * Also zero for individual threads. For CPUs, this is the number
+	 * of scheduler IPIs sent to other CPUs.
+	 */
+
+	uint64_t ipi_count;
 #endif
 
 #if defined(__cplusplus) && !defined(CONFIG_SCHED_THREAD_USAGE) &&                                 \
@@ -260,8 +292,6 @@ struct k_thread {
 #endif
 
 #if defined(CONFIG_EVENTS)
-	struct k_thread *next_event_link;
-
 	uint32_t   events;
 	uint32_t   event_options;
 #endif
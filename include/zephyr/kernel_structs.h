@@ -92,6 +92,13 @@ struct _ready_q {
 	struct _priq_rb runq;
 #elif defined(CONFIG_SCHED_MULTIQ)
 	struct _priq_mq runq;
+#elif defined(CONFIG_SCHED_BITMAP)
+	struct _priq_bitmap runq;
+#endif
+
+#ifdef CONFIG_SCHED_CPU_RUNQ
+	/* number of threads in runq */
+	unsigned int count;
 #endif
 };
 
@@ -110,7 +117,7 @@ struct _cpu {
 	/* one assigned idle thread per CPU */
 	struct k_thread *idle_thread;
 
-#ifdef CONFIG_SCHED_CPU_MASK_PIN_ONLY
+#if defined(CONFIG_SCHED_CPU_MASK_PIN_ONLY) || defined(CONFIG_SCHED_CPU_RUNQ)
 	struct _ready_q ready_q;
 #endif
 
@@ -146,6 +153,11 @@ struct _cpu {
 
 #ifdef CONFIG_SCHED_THREAD_USAGE_ALL
 	struct k_cycle_stats usage;
+
+#ifdef CONFIG_SMP
+	/* number of scheduler IPIs sent by this CPU */
+	uint32_t ipi_count;
+#endif
 #endif
 #endif
 
@@ -189,8 +201,11 @@ struct z_kernel {
 #endif
 
 #if defined(CONFIG_SMP) && defined(CONFIG_SCHED_IPI_SUPPORTED)
-	/* Need to signal an IPI at the next scheduling point */
-	bool pending_ipi;
+	/* Mask of CPUs to signal an IPI at the next scheduling point
+	 * (any non-zero value means all of them unless
+	 * CONFIG_SCHED_IPI_TARGETED)
+	 */
+	atomic_t pending_ipi;
 #endif
 };
 
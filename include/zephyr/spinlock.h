@@ -92,6 +92,19 @@ bool z_spin_lock_mem_coherent(struct k_spinlock *l);
 
 #endif /* CONFIG_SPIN_VALIDATE */
 
+/* Contention statistics hooks, see k_lock_stats_get().  The cycle
+ * counter is only read while the lock isn't held, as the timer driver
+ * may take that very lock to read it.
+ */
+#ifdef CONFIG_LOCK_STATS
+uint32_t z_lock_stats_now(void);
+uint32_t z_spin_lock_stats_spin(struct k_spinlock *l);
+void z_spin_lock_stats_acquired(struct k_spinlock *l, uint32_t wait_start,
+				uint32_t now);
+void z_spin_lock_stats_releasing(struct k_spinlock *l);
+void z_spin_lock_stats_released(void);
+#endif /* CONFIG_LOCK_STATS */
+
 /**
  * @brief Spinlock key type
  *
@@ -151,7 +164,18 @@ static ALWAYS_INLINE k_spinlock_key_t k_spin_lock(struct k_spinlock *l)
 # endif
 #endif
 
-#ifdef CONFIG_SMP
+#ifdef CONFIG_LOCK_STATS
+	uint32_t now = z_lock_stats_now();
+	uint32_t wait_start = 0U;
+
+# ifdef CONFIG_SMP
+	if (!atomic_cas(&l->locked, 0, 1)) {
+		wait_start = now;
+		now = z_spin_lock_stats_spin(l);
+	}
+# endif
+	z_spin_lock_stats_acquired(l, wait_start, now);
+#elif defined(CONFIG_SMP)
 	while (!atomic_cas(&l->locked, 0, 1)) {
 	}
 #endif
@@ -202,6 +226,10 @@ static ALWAYS_INLINE void k_spin_unlock(struct k_spinlock *l,
 #endif /* CONFIG_SPIN_LOCK_TIME_LIMIT */
 #endif /* CONFIG_SPIN_VALIDATE */
 
+#ifdef CONFIG_LOCK_STATS
+	z_spin_lock_stats_releasing(l);
+#endif
+
 #ifdef CONFIG_SMP
 	/* Strictly we don't need atomic_clear() here (which is an
 	 * exchange operation that returns the old value).  We are always
@@ -212,6 +240,10 @@ static ALWAYS_INLINE void k_spin_unlock(struct k_spinlock *l,
 	 */
 	atomic_clear(&l->locked);
 #endif
+
+#ifdef CONFIG_LOCK_STATS
+	z_spin_lock_stats_released();
+#endif
 	arch_irq_unlock(key.key);
 }
 
@@ -224,9 +256,15 @@ static ALWAYS_INLINE void k_spin_release(struct k_spinlock *l)
 #ifdef CONFIG_SPIN_VALIDATE
 	__ASSERT(z_spin_unlock_valid(l), "Not my spinlock %p", l);
 #endif
+#ifdef CONFIG_LOCK_STATS
+	z_spin_lock_stats_releasing(l);
+#endif
 #ifdef CONFIG_SMP
 	atomic_clear(&l->locked);
 #endif
+#ifdef CONFIG_LOCK_STATS
+	z_spin_lock_stats_released();
+#endif
 }
 
 /** @} */
@@ -460,6 +460,27 @@ static inline uint32_t arch_proc_id(void);
  */
 void arch_sched_ipi(void);
 
+#ifdef CONFIG_ARCH_HAS_DIRECTED_IPIS
+/**
+ * Send an interrupt to a set of CPUs
+ *
+ * This will invoke z_sched_ipi() on the CPUs whose (Zephyr) ID bit is
+ * set in @p cpu_bitmap.
+ *
+ * @param cpu_bitmap Bitmap of CPUs to interrupt
+ */
+void arch_sched_directed_ipi(uint32_t cpu_bitmap);
+#endif
+
+/**
+ * Relax the CPU inside a busy-wait loop
+ *
+ * Called on each iteration of loops polling memory written by another
+ * CPU.  Architectures may override the default, which is arch_nop(),
+ * with a hint that saves power or yields to a sibling hardware thread.
+ */
+void arch_spin_relax(void);
+
 #endif /* CONFIG_SMP */
 
 /**
@@ -26,12 +26,30 @@ struct sys_bitarray {
 	/* Bundle of bits */
 	uint32_t *bundles;
 
+#ifdef CONFIG_SYS_BITARRAY_SUMMARY
+	/* Bit n set if bundle n is all set, for allocations to skip
+	 * 32 full bundles at a time
+	 */
+	uint32_t *summary;
+#endif
+
 	/* Spinlock guarding access to this bit array */
 	struct k_spinlock lock;
 };
 
 typedef struct sys_bitarray sys_bitarray_t;
 
+#ifdef CONFIG_SYS_BITARRAY_SUMMARY
+#define _SYS_BITARRAY_SUMMARY_DEFINE(name, total_bits, sba_mod)		\
+	sba_mod uint32_t _sys_bitarray_summary_##name			\
+		[((total_bits) + 1024 - 1) / 1024] = {0};
+#define _SYS_BITARRAY_SUMMARY_INIT(name)				\
+	.summary = _sys_bitarray_summary_##name,
+#else
+#define _SYS_BITARRAY_SUMMARY_DEFINE(name, total_bits, sba_mod)
+#define _SYS_BITARRAY_SUMMARY_INIT(name)
+#endif
+
 /**
  * @brief Create a bitarray object.
  *
@@ -43,12 +61,14 @@ typedef struct sys_bitarray sys_bitarray_t;
 	sba_mod uint32_t _sys_bitarray_bundles_##name			\
 		[(((total_bits + 8 - 1) / 8) + sizeof(uint32_t) - 1)	\
 		 / sizeof(uint32_t)] = {0};				\
+	_SYS_BITARRAY_SUMMARY_DEFINE(name, total_bits, sba_mod)		\
 	sba_mod sys_bitarray_t name = {					\
 		.num_bits = total_bits,					\
 		.num_bundles = (((total_bits + 8 - 1) / 8)		\
 				+ sizeof(uint32_t) - 1)			\
 			       / sizeof(uint32_t),			\
 		.bundles = _sys_bitarray_bundles_##name,		\
+		_SYS_BITARRAY_SUMMARY_INIT(name)			\
 	}
 
 /**
@@ -140,6 +160,10 @@ int sys_bitarray_test_and_clear_bit(sys_bitarray_t *bitarray, size_t bit, int *p
  * marked as allocated and the offset to the start of this region is
  * returned via @p offset.
  *
+ * The first region large enough is used. Searching for it takes time
+ * proportional to its offset divided by 32, or by 1024 over full
+ * bundles of 32 bits with @kconfig{CONFIG_SYS_BITARRAY_SUMMARY}.
+ *
  * @param[in]  bitarray Bitarray struct
  * @param[in]  num_bits Number of bits to allocate
  * @param[out] offset   Offset to the start of allocated region if
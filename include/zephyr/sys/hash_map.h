@@ -0,0 +1,264 @@
+/*
+ * Copyright (c) 2022 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ * @brief Open addressing hash map
+ *
+ * Maps integer or string keys to pointers, in a power of two array of
+ * slots probed linearly with Robin Hood hashing: on insertion an entry
+ * takes the place of any entry closer to its home slot, and removal
+ * shifts the following entries back instead of leaving tombstones. This
+ * keeps probe sequences short up to high load factors, and lets lookups
+ * of missing keys stop early.
+ *
+ * The map stores the key and a pointer to the user data, which it never
+ * allocates nor copies: string keys in particular must remain valid and
+ * unchanged as long as they are in the map, typically by pointing into
+ * the object the value points to. A fixed capacity map works on an
+ * array provided by the user and never allocates at all, a dynamic map
+ * grows its array through an allocator function as entries are added.
+ *
+ * As with the other data structures, accesses are not synchronized.
+ */
+
+#ifndef ZEPHYR_INCLUDE_SYS_HASH_MAP_H_
+#define ZEPHYR_INCLUDE_SYS_HASH_MAP_H_
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <zephyr/toolchain.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @defgroup hash_map_apis Hash Map
+ * @ingroup datastructure_apis
+ * @{
+ */
+
+/** Kind of keys of a hash map. */
+enum sys_hash_map_key_type {
+	/** Keys are integers, compared by value. */
+	SYS_HASH_MAP_KEY_INT,
+	/** Keys are pointers to NUL terminated strings, compared by content. */
+	SYS_HASH_MAP_KEY_STR,
+};
+
+/**
+ * @brief Allocator of a dynamic hash map
+ *
+ * Has the semantics of realloc(), though the map only ever uses it to
+ * allocate a new array (@p ptr is NULL) or to free one (@p size is 0).
+ *
+ * @param ptr Memory to free, or NULL.
+ * @param size Size to allocate, or 0.
+ *
+ * @return The allocated memory, NULL when freeing or on failure.
+ */
+typedef void *(*sys_hash_map_alloc_t)(void *ptr, size_t size);
+
+/** @cond INTERNAL_HIDDEN */
+struct sys_hash_map_slot {
+	uintptr_t key;
+	void *value;
+	/* 0 if the slot is empty, the key hash with the top bit set
+	 * otherwise
+	 */
+	uint32_t hash;
+};
+/** @endcond */
+
+/** Hash map */
+struct sys_hash_map {
+	/** @cond INTERNAL_HIDDEN */
+	struct sys_hash_map_slot *slots;
+	/* NULL for a fixed capacity map */
+	sys_hash_map_alloc_t alloc;
+	/* Number of slots, a power of two */
+	uint32_t capacity;
+	/* Number of entries */
+	uint32_t size;
+	uint8_t key_type;
+	/** @endcond */
+};
+
+/** @cond INTERNAL_HIDDEN */
+#define _SYS_HASH_MAP_DEFINE_FIXED(name, type, cap, mod)			\
+	BUILD_ASSERT(((cap) > 0) && (((cap) & ((cap) - 1)) == 0),		\
+		     "hash map capacity must be a power of two");		\
+	mod struct sys_hash_map_slot _sys_hash_map_slots_##name[cap];	\
+	mod struct sys_hash_map name = {					\
+		.slots = _sys_hash_map_slots_##name,				\
+		.capacity = (cap),						\
+		.key_type = (type),						\
+	}
+
+#define _SYS_HASH_MAP_DEFINE_DYNAMIC(name, type, alloc_fn, mod)		\
+	mod struct sys_hash_map name = {					\
+		.alloc = (alloc_fn),						\
+		.key_type = (type),						\
+	}
+/** @endcond */
+
+/**
+ * @brief Define a fixed capacity hash map
+ *
+ * @param name Name of the hash map.
+ * @param type Type of keys, see @ref sys_hash_map_key_type.
+ * @param cap Maximum number of entries, a power of two.
+ */
+#define SYS_HASH_MAP_DEFINE_FIXED(name, type, cap)				\
+	_SYS_HASH_MAP_DEFINE_FIXED(name, type, cap,)
+
+/**
+ * @brief Define a static fixed capacity hash map
+ *
+ * @param name Name of the hash map.
+ * @param type Type of keys, see @ref sys_hash_map_key_type.
+ * @param cap Maximum number of entries, a power of two.
+ */
+#define SYS_HASH_MAP_DEFINE_FIXED_STATIC(name, type, cap)			\
+	_SYS_HASH_MAP_DEFINE_FIXED(name, type, cap, static)
+
+/**
+ * @brief Define a dynamic hash map
+ *
+ * @param name Name of the hash map.
+ * @param type Type of keys, see @ref sys_hash_map_key_type.
+ * @param alloc_fn Allocator, see @ref sys_hash_map_alloc_t.
+ */
+#define SYS_HASH_MAP_DEFINE_DYNAMIC(name, type, alloc_fn)			\
+	_SYS_HASH_MAP_DEFINE_DYNAMIC(name, type, alloc_fn,)
+
+/**
+ * @brief Define a static dynamic hash map
+ *
+ * @param name Name of the hash map.
+ * @param type Type of keys, see @ref sys_hash_map_key_type.
+ * @param alloc_fn Allocator, see @ref sys_hash_map_alloc_t.
+ */
+#define SYS_HASH_MAP_DEFINE_DYNAMIC_STATIC(name, type, alloc_fn)		\
+	_SYS_HASH_MAP_DEFINE_DYNAMIC(name, type, alloc_fn, static)
+
+/**
+ * @brief Initialize a fixed capacity hash map
+ *
+ * @param map Hash map.
+ * @param type Type of keys.
+ * @param slots Array of @p capacity slots, owned by the map until it is
+ *              initialized again.
+ * @param capacity Maximum number of entries, a power of two.
+ */
+void sys_hash_map_init_fixed(struct sys_hash_map *map,
+			     enum sys_hash_map_key_type type,
+			     struct sys_hash_map_slot *slots, size_t capacity);
+
+/**
+ * @brief Initialize a dynamic hash map
+ *
+ * The map starts empty and allocates nothing until the first insertion.
+ *
+ * @param map Hash map.
+ * @param type Type of keys.
+ * @param alloc Allocator.
+ */
+void sys_hash_map_init_dynamic(struct sys_hash_map *map,
+			       enum sys_hash_map_key_type type,
+			       sys_hash_map_alloc_t alloc);
+
+/**
+ * @brief Insert or replace an entry
+ *
+ * A dynamic map doubles its capacity when it is three quarters full.
+ *
+ * @param map Hash map.
+ * @param key Key, or pointer to the key string cast to uintptr_t.
+ * @param value Value, must not be NULL.
+ * @param old_value If not NULL, set to the replaced value, or to NULL
+ *                  if there was no entry for @p key.
+ *
+ * @retval 0 The entry was inserted.
+ * @retval 1 The value of an existing entry was replaced.
+ * @retval -ENOSPC A fixed capacity map is full.
+ * @retval -ENOMEM A dynamic map failed to grow.
+ */
+int sys_hash_map_insert(struct sys_hash_map *map, uintptr_t key, void *value,
+			void **old_value);
+
+/**
+ * @brief Look an entry up
+ *
+ * @param map Hash map.
+ * @param key Key, or pointer to the key string cast to uintptr_t.
+ *
+ * @return The value of the entry, or NULL if there is none.
+ */
+void *sys_hash_map_get(const struct sys_hash_map *map, uintptr_t key);
+
+/**
+ * @brief Remove an entry
+ *
+ * @param map Hash map.
+ * @param key Key, or pointer to the key string cast to uintptr_t.
+ *
+ * @return The value of the removed entry, or NULL if there was none.
+ */
+void *sys_hash_map_remove(struct sys_hash_map *map, uintptr_t key);
+
+/**
+ * @brief Remove all the entries
+ *
+ * A dynamic map also frees its array.
+ *
+ * @param map Hash map.
+ */
+void sys_hash_map_clear(struct sys_hash_map *map);
+
+/**
+ * @brief Hash map visitor
+ *
+ * @param key Key of the entry.
+ * @param value Value of the entry.
+ * @param user_data User data given to sys_hash_map_foreach().
+ */
+typedef void (*sys_hash_map_cb_t)(uintptr_t key, void *value,
+				  void *user_data);
+
+/**
+ * @brief Call a function on each entry, in no particular order
+ *
+ * The map must not be modified while iterating.
+ *
+ * @param map Hash map.
+ * @param cb Function to call.
+ * @param user_data User data passed to @p cb.
+ */
+void sys_hash_map_foreach(const struct sys_hash_map *map, sys_hash_map_cb_t cb,
+			  void *user_data);
+
+/**
+ * @brief Get the number of entries of a hash map
+ *
+ * @param map Hash map.
+ *
+ * @return Number of entries.
+ */
+static inline size_t sys_hash_map_size(const struct sys_hash_map *map)
+{
+	return map->size;
+}
+
+/** @} */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ZEPHYR_INCLUDE_SYS_HASH_MAP_H_ */
@@ -107,6 +107,12 @@ struct k_mem_paging_stats_t {
 		/** Number of page faults with IRQ unlocked */
 		unsigned long			irq_unlocked;
 
+		/**
+		 * Number of data pages paged in by read-ahead, each a
+		 * page fault avoided if it is accessed before eviction
+		 */
+		unsigned long			read_ahead;
+
 #ifndef CONFIG_DEMAND_PAGING_ALLOW_IRQ
 		/** Number of page faults while in ISR */
 		unsigned long			in_isr;
@@ -620,6 +626,28 @@ void k_mem_paging_backing_store_page_out(uintptr_t location);
  */
 void k_mem_paging_backing_store_page_in(uintptr_t location);
 
+/**
+ * Copy several data pages from the provided locations
+ *
+ * Only used for read-ahead (see CONFIG_DEMAND_PAGING_READ_AHEAD) and only
+ * needs to be implemented by backing stores selecting
+ * CONFIG_BACKING_STORE_PAGE_IN_BATCH. For each index i below @a count,
+ * copies the data page at @a locations[i] to @a dests[i], which is mapped
+ * read-write to the intended destination page frame. Backing stores should
+ * fetch all the pages in as few requests as they can.
+ *
+ * Calls to this, k_mem_paging_backing_store_page_in() and
+ * k_mem_paging_backing_store_page_out() will always be serialized, but
+ * interrupts may be enabled.
+ *
+ * @param locations Location tokens for the data pages
+ * @param dests Destinations of the data pages
+ * @param count Number of data pages
+ */
+void k_mem_paging_backing_store_page_in_batch(const uintptr_t *locations,
+					      void *const *dests,
+					      size_t count);
+
 /**
  * Update internal accounting after a page-in
  *
@@ -643,6 +671,48 @@ void k_mem_paging_backing_store_page_in(uintptr_t location);
 void k_mem_paging_backing_store_page_finalize(struct z_page_frame *pf,
 					      uintptr_t location);
 
+#if defined(CONFIG_BACKING_STORE_RAM_COMPRESSED) || defined(__DOXYGEN__)
+/** Number of pool chunks a data page takes at most */
+#define K_MEM_PAGING_COMPRESSED_PAGE_CHUNKS \
+	ceiling_fraction(CONFIG_MMU_PAGE_SIZE, \
+			 CONFIG_BACKING_STORE_RAM_COMPRESSED_CHUNK_SIZE)
+
+/** Statistics of the compressed RAM backing store */
+struct k_mem_paging_compressed_stats_t {
+	/** Number of data pages stored */
+	unsigned long pages;
+
+	/** Number of stored data pages made only of zeroes */
+	unsigned long zero_pages;
+
+	/** Number of stored data pages kept uncompressed */
+	unsigned long raw_pages;
+
+	/** Sum of the compressed sizes of the stored data pages */
+	size_t compressed_bytes;
+
+	/** Pool memory taken by the stored data pages */
+	size_t pool_bytes;
+
+	/** Stored data pages by number of pool chunks taken */
+	unsigned long chunks[K_MEM_PAGING_COMPRESSED_PAGE_CHUNKS + 1];
+
+	/**
+	 * Number of data pages stored outside of the pool, waiting for it
+	 * to have room for them (0 or 1)
+	 */
+	unsigned long spare_pages;
+};
+
+/**
+ * Get the statistics of the compressed RAM backing store
+ *
+ * @param stats Pointer to struct to copy statistics into
+ */
+void k_mem_paging_compressed_stats_get(
+	struct k_mem_paging_compressed_stats_t *stats);
+#endif /* CONFIG_BACKING_STORE_RAM_COMPRESSED */
+
 /**
  * Backing store initialization function.
  *
@@ -0,0 +1,260 @@
+/*
+ * Copyright (c) 2022 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ * @brief Multiple producer, single consumer ring buffer
+ *
+ * A lock-free variant of the ring buffer for several producers, typically
+ * interrupt handlers or threads on different CPUs, feeding a single
+ * consumer. It keeps the claim/finish shape of the ring buffer API, but
+ * each claim reserves a record: a contiguous area preceded by a 32-bit
+ * header, which is never split nor interleaved with the data of other
+ * producers.
+ *
+ * Producers reserve records with a compare and swap of the head index,
+ * and write their data without any lock. Finishing a record sets a flag
+ * in its header, and the consumer sees records in the order they were
+ * reserved: a record reserved later but finished earlier only becomes
+ * visible once all the records before it are finished. Producers never
+ * wait for each other, so they may be preempted, or preempt each other,
+ * at any point.
+ *
+ * Headers are recognized without a shared commit index because the
+ * consumer clears the memory of the records it releases: a header still
+ * zero has been reserved but not written yet. The buffer size must be a
+ * power of two.
+ */
+
+#ifndef ZEPHYR_INCLUDE_SYS_MPSC_RING_BUFFER_H_
+#define ZEPHYR_INCLUDE_SYS_MPSC_RING_BUFFER_H_
+
+#include <stdint.h>
+#include <zephyr/sys/atomic.h>
+#include <zephyr/sys/util.h>
+#include <zephyr/toolchain.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @defgroup mpsc_ring_buffer_apis MPSC Ring Buffer APIs
+ * @ingroup datastructure_apis
+ * @{
+ */
+
+/** Maximum size of a multiple producer ring buffer (in bytes). */
+#define MPSC_RING_BUFFER_MAX_SIZE 0x40000000U
+
+/**
+ * @brief A structure to represent a multiple producer ring buffer
+ */
+struct mpsc_ring_buf {
+	/** @cond INTERNAL_HIDDEN */
+	uint32_t *buffer;
+	/* Size in bytes, a power of two */
+	uint32_t size;
+	/* Bytes reserved by producers, free running */
+	atomic_t put_head;
+	/* Bytes released by the consumer, free running */
+	atomic_t get_tail;
+	/* Bytes of the current record finished, and claimed, by the
+	 * consumer
+	 */
+	uint32_t get_offset;
+	uint32_t get_claimed;
+	/** @endcond */
+};
+
+/**
+ * @brief Define and initialize a multiple producer ring buffer.
+ *
+ * The ring buffer can be accessed outside the module where it is defined
+ * using:
+ *
+ * @code extern struct mpsc_ring_buf <name>; @endcode
+ *
+ * @param name  Name of the ring buffer.
+ * @param size8 Size of ring buffer (in bytes), a power of two of at
+ *              least 8.
+ */
+#define MPSC_RING_BUF_DECLARE(name, size8)					\
+	BUILD_ASSERT(((size8) >= 8) && ((size8) <= MPSC_RING_BUFFER_MAX_SIZE) && \
+		     (((size8) & ((size8) - 1)) == 0),				\
+		     "Size must be a power of two");				\
+	static uint32_t _mpsc_ring_buffer_data_##name[(size8) / 4];		\
+	struct mpsc_ring_buf name = {						\
+		.buffer = _mpsc_ring_buffer_data_##name,			\
+		.size = (size8)							\
+	}
+
+/**
+ * @brief Initialize a multiple producer ring buffer.
+ *
+ * This routine initializes a ring buffer, prior to its first use. It is
+ * only used for ring buffers not defined using MPSC_RING_BUF_DECLARE.
+ * The data buffer is cleared.
+ *
+ * @param buf  Address of ring buffer.
+ * @param size Ring buffer size (in bytes), a power of two of at least 8.
+ * @param data Ring buffer data area (word aligned).
+ */
+void mpsc_ring_buf_init(struct mpsc_ring_buf *buf, uint32_t size,
+			uint32_t *data);
+
+/**
+ * @brief Return ring buffer capacity.
+ *
+ * @param buf Address of ring buffer.
+ *
+ * @return Ring buffer capacity (in bytes), record headers included.
+ */
+static inline uint32_t mpsc_ring_buf_capacity_get(struct mpsc_ring_buf *buf)
+{
+	return buf->size;
+}
+
+/**
+ * @brief Determine free space in a ring buffer.
+ *
+ * Records take 4 bytes of header, and their length is rounded up to a
+ * multiple of 4. The value may be stale as soon as it is returned when
+ * other producers are running.
+ *
+ * @param buf Address of ring buffer.
+ *
+ * @return Ring buffer free space (in bytes).
+ */
+static inline uint32_t mpsc_ring_buf_space_get(struct mpsc_ring_buf *buf)
+{
+	return buf->size - ((uint32_t)atomic_get(&buf->put_head) -
+			    (uint32_t)atomic_get(&buf->get_tail));
+}
+
+/**
+ * @brief Reserve a record for writing data to a ring buffer.
+ *
+ * Unlike @ref ring_buf_put_claim, the record is either reserved whole,
+ * contiguous, or not at all: when it does not fit before the end of the
+ * buffer, the space left there is skipped. Once data is written to the
+ * record it must be committed with @ref mpsc_ring_buf_put_finish.
+ *
+ * Records take at most half of the buffer, header included, so that
+ * they fit in an empty buffer whatever the space to skip: @p size can be
+ * up to half the capacity minus 4 bytes.
+ *
+ * This routine may be called concurrently from any number of threads and
+ * interrupt handlers.
+ *
+ * @param[in]  buf  Address of ring buffer.
+ * @param[out] data Set to the address of the record data, word aligned.
+ * @param[in]  size Record size (in bytes).
+ *
+ * @return @p size, or 0 if there is not enough free space or @p size is
+ *	   too large.
+ */
+uint32_t mpsc_ring_buf_put_claim(struct mpsc_ring_buf *buf, uint8_t **data,
+				 uint32_t size);
+
+/**
+ * @brief Commit a record reserved with @ref mpsc_ring_buf_put_claim.
+ *
+ * The number of bytes may be lower than the size of the record (or even
+ * 0, which discards it): the rest of it is skipped by the consumer, and
+ * returns to the free space after the record is read.
+ *
+ * @param buf  Address of ring buffer.
+ * @param data Address of the record data, as set by
+ *             @ref mpsc_ring_buf_put_claim.
+ * @param size Number of valid bytes in the record.
+ *
+ * @retval 0 Successful operation.
+ * @retval -EINVAL Provided @a size exceeds the size of the record, or the
+ *                 record was already committed.
+ */
+int mpsc_ring_buf_put_finish(struct mpsc_ring_buf *buf, uint8_t *data,
+			     uint32_t size);
+
+/**
+ * @brief Write a record to a ring buffer.
+ *
+ * This routine copies data to a record reserved with
+ * @ref mpsc_ring_buf_put_claim and commits it.
+ *
+ * @param buf  Address of ring buffer.
+ * @param data Address of data.
+ * @param size Data size (in bytes).
+ *
+ * @return @p size, or 0 if there is not enough free space.
+ */
+uint32_t mpsc_ring_buf_put(struct mpsc_ring_buf *buf, const uint8_t *data,
+			   uint32_t size);
+
+/**
+ * @brief Get address of valid data in a ring buffer.
+ *
+ * Data comes from the oldest record not read yet, if it is committed:
+ * successive calls carry on in that record, records reserved later are
+ * only available once it is finished with @ref mpsc_ring_buf_get_finish.
+ * Claiming UINT32_MAX bytes gets a whole record at once.
+ *
+ * @warning
+ * Only a single consumer may call the get routines at a time.
+ *
+ * @param[in]  buf  Address of ring buffer.
+ * @param[out] data Pointer to the address. It is set to a location within
+ *		    ring buffer.
+ * @param[in]  size Requested size (in bytes).
+ *
+ * @return Number of valid bytes in the provided buffer, which can be
+ *	   smaller than requested if the record has less data.
+ */
+uint32_t mpsc_ring_buf_get_claim(struct mpsc_ring_buf *buf, uint8_t **data,
+				 uint32_t size);
+
+/**
+ * @brief Indicate number of bytes read from claimed buffer.
+ *
+ * The record is released, and its memory returned to the producers, once
+ * all of its data is finished.
+ *
+ * @param buf  Address of ring buffer.
+ * @param size Number of bytes that can be freed, up to the number of
+ *	       bytes claimed since the last call.
+ *
+ * @retval 0 Successful operation.
+ * @retval -EINVAL Provided @a size exceeds the claimed bytes.
+ */
+int mpsc_ring_buf_get_finish(struct mpsc_ring_buf *buf, uint32_t size);
+
+/**
+ * @brief Read data from a ring buffer.
+ *
+ * This routine reads the committed records as a byte stream, up to the
+ * first record not committed yet.
+ *
+ * @warning
+ * Only a single consumer may call the get routines at a time.
+ *
+ * @param buf  Address of ring buffer.
+ * @param data Address of the output buffer. Can be NULL to discard data.
+ * @param size Data size (in bytes).
+ *
+ * @return Number of bytes read.
+ */
+uint32_t mpsc_ring_buf_get(struct mpsc_ring_buf *buf, uint8_t *data,
+			   uint32_t size);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ZEPHYR_INCLUDE_SYS_MPSC_RING_BUFFER_H_ */
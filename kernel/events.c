@@ -84,13 +84,24 @@ static bool are_wait_conditions_met(uint32_t desired, uint32_t current,
 	return match != 0;
 }
 
+static bool event_wake_filter(struct k_thread *thread, void *arg)
+{
+	uint32_t events = *(uint32_t *)arg;
+	unsigned int wait_condition = thread->event_options & K_EVENT_WAIT_MASK;
+
+	if (!are_wait_conditions_met(thread->events, events, wait_condition)) {
+		return false;
+	}
+
+	thread->events = events;
+
+	return true;
+}
+
 static void k_event_post_internal(struct k_event *event, uint32_t events,
 				  uint32_t events_mask)
 {
 	k_spinlock_key_t  key;
-	struct k_thread  *thread;
-	unsigned int      wait_condition;
-	struct k_thread  *head = NULL;
 
 	key = k_spin_lock(&event->lock);
 
@@ -103,40 +114,12 @@ static void k_event_post_internal(struct k_event *event, uint32_t events,
 
 	/*
 	 * Posting an event has the potential to wake multiple pended threads.
-	 * It is desirable to unpend all affected threads simultaneously. To
-	 * do so, this must be done in three steps as it is unsafe to unpend
-	 * threads from within the _WAIT_Q_FOR_EACH() loop.
-	 *
-	 * 1. Create a linked list of threads to unpend.
-	 * 2. Unpend each of the threads in the linked list
-	 * 3. Ready each of the threads in the linked list
+	 * All threads whose wait conditions are now met are unpended and
+	 * readied together, with a single rescheduling decision.
 	 */
 
-	_WAIT_Q_FOR_EACH(&event->wait_q, thread) {
-		wait_condition = thread->event_options & K_EVENT_WAIT_MASK;
-
-		if (are_wait_conditions_met(thread->events, events,
-					    wait_condition)) {
-			/*
-			 * The wait conditions have been satisfied. Add this
-			 * thread to the list of threads to unpend.
-			 */
-
-			thread->next_event_link = head;
-			head = thread;
-		}
-	}
-
-	if (head != NULL) {
-		thread = head;
-		do {
-			z_unpend_thread(thread);
-			arch_thread_return_value_set(thread, 0);
-			thread->events = events;
-			z_ready_thread(thread);
-			thread = thread->next_event_link;
-		} while (thread != NULL);
-	}
+	(void)z_sched_wake_filtered(&event->wait_q, INT_MAX, event_wake_filter,
+				    &events, 0, NULL);
 
 	z_reschedule(&event->lock, key);
 
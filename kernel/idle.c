@@ -61,6 +61,10 @@ void idle(void *unused1, void *unused2, void *unused3)
 		 */
 		(void) arch_irq_lock();
 
+#ifdef CONFIG_IDLE_STATS
+		z_idle_stats_enter();
+#endif
+
 #ifdef CONFIG_PM
 		_kernel.idle = z_get_next_timeout_expiry();
 
@@ -86,6 +90,11 @@ void idle(void *unused1, void *unused2, void *unused3)
 		k_cpu_idle();
 #endif
 
+#ifdef CONFIG_IDLE_STATS
+		/* Unless the wakeup interrupt already closed it */
+		z_idle_stats_exit();
+#endif
+
 #if !defined(CONFIG_PREEMPT_ENABLED)
 # if !defined(CONFIG_USE_SWITCH) || defined(CONFIG_SPARC)
 		/* A legacy mess: the idle thread is by definition
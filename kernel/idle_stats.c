@@ -0,0 +1,179 @@
+/*
+ * Copyright (c) 2022 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/spinlock.h>
+#include <kernel_internal.h>
+#include <string.h>
+
+/* Idle residency statistics.  An idle period opens when the idle thread
+ * is about to sleep and is closed by whichever comes first on that CPU:
+ * the timer interrupt announcing ticks, a context switch away from the
+ * idle thread, or the idle thread itself once k_cpu_idle() returns.
+ */
+
+/* Need one of these to see interrupt driven switches */
+#if !defined(CONFIG_USE_SWITCH) && !defined(CONFIG_INSTRUMENT_THREAD_SWITCHING)
+#error "No data backend configured for CONFIG_IDLE_STATS"
+#endif
+
+struct idle_cpu {
+	uint64_t start;
+	bool idle;
+	struct k_idle_stats stats;
+};
+
+static struct k_spinlock idle_stats_lock;
+static struct idle_cpu idle_cpus[CONFIG_MP_MAX_NUM_CPUS];
+static struct k_idle_wakeup wakeups[CONFIG_IDLE_STATS_WAKEUP_SOURCES];
+
+static uint64_t idle_now(void)
+{
+#ifdef CONFIG_TIMER_HAS_64BIT_CYCLE_COUNTER
+	return k_cycle_get_64();
+#else
+	return k_cycle_get_32();
+#endif
+}
+
+static void idle_end(struct idle_cpu *cpu, uint32_t *cause)
+{
+	uint64_t cycles = idle_now() - cpu->start;
+	uint32_t us;
+	int bucket;
+
+#ifndef CONFIG_TIMER_HAS_64BIT_CYCLE_COUNTER
+	cycles = (uint32_t)cycles;
+#endif
+	us = (uint32_t)MIN(k_cyc_to_us_floor64(cycles), UINT32_MAX);
+	bucket = MAX((int)find_msb_set(us), 1) - 1;
+
+	cpu->idle = false;
+	cpu->stats.periods[MIN(bucket, K_IDLE_STATS_BUCKETS - 1)]++;
+	cpu->stats.idle_us += us;
+	cpu->stats.longest_us = MAX(cpu->stats.longest_us, us);
+	(*cause)++;
+}
+
+/* Space-saving top-N: an unknown callback evicts the least frequent
+ * entry and inherits its count, so frequent callbacks are never lost.
+ */
+static void wakeup_count(struct _timeout *t)
+{
+	struct k_idle_wakeup *min = &wakeups[0];
+
+	for (int i = 0; i < ARRAY_SIZE(wakeups); i++) {
+		struct k_idle_wakeup *w = &wakeups[i];
+
+		if (w->fn == t->fn) {
+			min = w;
+			break;
+		}
+		if (w->count < min->count) {
+			min = w;
+		}
+	}
+
+	min->fn = t->fn;
+	min->last = t;
+	min->count++;
+}
+
+void z_idle_stats_enter(void)
+{
+	k_spinlock_key_t key = k_spin_lock(&idle_stats_lock);
+	struct idle_cpu *cpu = &idle_cpus[_current_cpu->id];
+
+	cpu->idle = true;
+	cpu->start = idle_now();
+
+	k_spin_unlock(&idle_stats_lock, key);
+}
+
+void z_idle_stats_exit(void)
+{
+	k_spinlock_key_t key = k_spin_lock(&idle_stats_lock);
+	struct idle_cpu *cpu = &idle_cpus[_current_cpu->id];
+
+	if (cpu->idle) {
+		idle_end(cpu, &cpu->stats.other_wakeups);
+	}
+
+	k_spin_unlock(&idle_stats_lock, key);
+}
+
+void z_idle_stats_wakeup(struct _timeout *t)
+{
+	struct idle_cpu *cpu = &idle_cpus[_current_cpu->id];
+	k_spinlock_key_t key;
+
+	/* Called with interrupts locked, and only this CPU sets it */
+	if (!cpu->idle) {
+		return;
+	}
+
+	key = k_spin_lock(&idle_stats_lock);
+
+	if (t != NULL) {
+		idle_end(cpu, &cpu->stats.timeout_wakeups);
+		wakeup_count(t);
+	} else {
+		idle_end(cpu, &cpu->stats.tick_wakeups);
+	}
+
+	k_spin_unlock(&idle_stats_lock, key);
+}
+
+int k_idle_stats_get(int cpu, struct k_idle_stats *stats)
+{
+	if ((cpu < 0) || (cpu >= arch_num_cpus()) || (stats == NULL)) {
+		return -EINVAL;
+	}
+
+	LOCKED(&idle_stats_lock) {
+		*stats = idle_cpus[cpu].stats;
+	}
+
+	return 0;
+}
+
+int k_idle_wakeups_get(struct k_idle_wakeup *out, int max)
+{
+	struct k_idle_wakeup sorted[ARRAY_SIZE(wakeups)];
+	int n = 0;
+
+	LOCKED(&idle_stats_lock) {
+		for (int i = 0; i < ARRAY_SIZE(wakeups); i++) {
+			int j = n;
+
+			if (wakeups[i].count == 0) {
+				continue;
+			}
+
+			for (; (j > 0) && (sorted[j - 1].count < wakeups[i].count);
+			     j--) {
+				sorted[j] = sorted[j - 1];
+			}
+			sorted[j] = wakeups[i];
+			n++;
+		}
+	}
+
+	n = MIN(n, MAX(max, 0));
+	memcpy(out, sorted, n * sizeof(*out));
+
+	return n;
+}
+
+void k_idle_stats_reset(void)
+{
+	LOCKED(&idle_stats_lock) {
+		for (int i = 0; i < ARRAY_SIZE(idle_cpus); i++) {
+			idle_cpus[i].stats = (struct k_idle_stats) {};
+		}
+		memset(wakeups, 0, sizeof(wakeups));
+	}
+}
@@ -289,6 +289,49 @@ void z_paging_histogram_inc(struct k_mem_paging_histogram_t *hist,
 			    uint32_t cycles);
 #endif /* CONFIG_DEMAND_PAGING_TIMING_HISTOGRAM */
 
+#ifdef CONFIG_IDLE_STATS
+/**
+ * Mark the start of an idle period on the current CPU.
+ *
+ * Called by the idle thread with interrupts locked, right before
+ * putting the CPU to sleep.
+ */
+void z_idle_stats_enter(void);
+
+/**
+ * End the idle period of the current CPU, if any, because of an
+ * interrupt other than the timer or a context switch.
+ */
+void z_idle_stats_exit(void);
+
+/**
+ * End the idle period of the current CPU, if any, because of a timer
+ * interrupt.
+ *
+ * @param t The first timeout expired by the interrupt, or NULL if
+ *          it expired none.
+ */
+void z_idle_stats_wakeup(struct _timeout *t);
+#endif /* CONFIG_IDLE_STATS */
+
+#ifdef CONFIG_LOCK_STATS
+/**
+ * Account the outermost acquisition of a mutex by its new owner.
+ *
+ * @param mutex The mutex.
+ * @param wait_start Cycle count when the owner started waiting for
+ *                   it, or 0 if it didn't have to.
+ * @param site Return address of the k_mutex_lock() call.
+ */
+void z_mutex_lock_stats_acquired(struct k_mutex *mutex, uint32_t wait_start,
+				 void *site);
+
+/**
+ * Account the final release of a mutex by its owner.
+ */
+void z_mutex_lock_stats_released(struct k_mutex *mutex);
+#endif /* CONFIG_LOCK_STATS */
+
 #ifdef __cplusplus
 }
 #endif
@@ -138,6 +138,27 @@ static inline bool z_is_thread_queued(struct k_thread *thread)
 	return z_is_thread_state_set(thread, _THREAD_QUEUED);
 }
 
+#ifdef CONFIG_SMP
+/* Whether the thread is running on any CPU.  Without the scheduler lock
+ * held this is only a snapshot, suitable for heuristics.
+ */
+static inline bool z_is_thread_running(struct k_thread *thread)
+{
+	unsigned int num_cpus = arch_num_cpus();
+
+	for (unsigned int i = 0; i < num_cpus; i++) {
+		/* Read each time around busy-wait loops */
+		struct k_thread *volatile *current = &_kernel.cpus[i].current;
+
+		if (*current == thread) {
+			return true;
+		}
+	}
+
+	return false;
+}
+#endif
+
 static inline void z_mark_thread_as_suspended(struct k_thread *thread)
 {
 	thread->base.thread_state |= _THREAD_SUSPENDED;
@@ -315,11 +336,54 @@ static ALWAYS_INLINE bool z_is_thread_timeout_expired(struct k_thread *thread)
  */
 bool z_sched_wake(_wait_q_t *wait_q, int swap_retval, void *swap_data);
 
+/**
+ * Wake up to @a max threads pending on a wait queue in a single pass
+ *
+ * Threads are taken in wait queue order, skipping those for which
+ * @a filter (if not NULL) returns false.  Every woken thread is unpended
+ * and readied under one acquisition of the scheduler lock, and the next
+ * thread to run and any IPIs are worked out once for the whole batch
+ * rather than once per thread.  @a filter is called with the scheduler
+ * lock held and must not block or call back into the scheduler.
+ *
+ * The same locking rules as for z_sched_wake() apply.
+ *
+ * @param wait_q Wait queue to wake threads from
+ * @param max Maximum number of threads to wake up
+ * @param filter Optional predicate selecting the threads to wake
+ * @param arg Argument passed to @a filter
+ * @param swap_retval Swap return value for woken threads
+ * @param swap_data Data return value to supplement swap_retval. May be NULL.
+ * @return Number of threads woken up
+ */
+int z_sched_wake_filtered(_wait_q_t *wait_q, int max,
+			  bool (*filter)(struct k_thread *thread, void *arg),
+			  void *arg, int swap_retval, void *swap_data);
+
+/**
+ * Wake up to @a max of the highest priority threads pending on a wait queue
+ *
+ * Batched equivalent of calling z_sched_wake() @a max times, see
+ * z_sched_wake_filtered().
+ *
+ * @param wait_q Wait queue to wake threads from
+ * @param max Maximum number of threads to wake up
+ * @param swap_retval Swap return value for woken threads
+ * @param swap_data Data return value to supplement swap_retval. May be NULL.
+ * @return Number of threads woken up
+ */
+static inline int z_sched_wake_n(_wait_q_t *wait_q, int max, int swap_retval,
+				 void *swap_data)
+{
+	return z_sched_wake_filtered(wait_q, max, NULL, NULL, swap_retval,
+				     swap_data);
+}
+
 /**
  * Wake up all threads pending on the provided wait queue
  *
- * Convenience function to invoke z_sched_wake() on all threads in the queue
- * until there are no more to wake up.
+ * Convenience function to invoke z_sched_wake_n() on all threads in the
+ * queue.
  *
  * @param wait_q Wait queue to wake up the highest prio thread
  * @param swap_retval Swap return value for woken thread
@@ -330,14 +394,7 @@ bool z_sched_wake(_wait_q_t *wait_q, int swap_retval, void *swap_data);
 static inline bool z_sched_wake_all(_wait_q_t *wait_q, int swap_retval,
 				    void *swap_data)
 {
-	bool woken = false;
-
-	while (z_sched_wake(wait_q, swap_retval, swap_data)) {
-		woken = true;
-	}
-
-	/* True if we woke at least one thread up */
-	return woken;
+	return z_sched_wake_n(wait_q, INT_MAX, swap_retval, swap_data) > 0;
 }
 
 /**
@@ -396,12 +453,43 @@ void z_sched_cpu_usage(uint8_t core_id, struct k_thread_runtime_stats *stats);
 void z_sched_thread_usage(struct k_thread *thread,
 			  struct k_thread_runtime_stats *stats);
 
+/** @brief Account the scheduling latency of a thread being switched in.
+ *
+ * Records the time since the thread was made ready, if it was.  Like
+ * z_sched_usage_stop() this is idempotent and must be called with
+ * local interrupts masked.
+ */
+static inline void z_sched_latency_switch(struct k_thread *thread)
+{
+#ifdef CONFIG_SCHED_THREAD_LATENCY
+	uint32_t ready = thread->base.ready_cycles;
+
+	if (ready != 0U) {
+		k_thread_latency_stats_t *stats = &thread->base.latency;
+		uint32_t cycles = k_cycle_get_32() - ready;
+
+		stats->hist[MIN(find_msb_set(cycles),
+				K_THREAD_LATENCY_BUCKETS - 1)]++;
+		stats->max_cycles = MAX(stats->max_cycles, cycles);
+		thread->base.ready_cycles = 0U;
+	}
+#else
+	ARG_UNUSED(thread);
+#endif
+}
+
 static inline void z_sched_usage_switch(struct k_thread *thread)
 {
 	ARG_UNUSED(thread);
 #ifdef CONFIG_SCHED_THREAD_USAGE
 	z_sched_usage_stop();
 	z_sched_usage_start(thread);
+#endif
+	z_sched_latency_switch(thread);
+#ifdef CONFIG_IDLE_STATS
+	if (z_is_idle_thread_object(_current)) {
+		z_idle_stats_exit();
+	}
 #endif
 }
 
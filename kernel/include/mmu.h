@@ -219,12 +219,15 @@ extern size_t z_free_page_count;
 
 #ifdef CONFIG_DEMAND_PAGING
 /* We reserve a virtual page as a scratch area for page-ins/outs at the end
- * of the address space
+ * of the address space, plus one page below it per page of read-ahead
  */
-#define Z_VM_RESERVED	CONFIG_MMU_PAGE_SIZE
+#define Z_VM_RESERVED	((1 + CONFIG_DEMAND_PAGING_READ_AHEAD) * \
+			 CONFIG_MMU_PAGE_SIZE)
 #define Z_SCRATCH_PAGE	((void *)((uintptr_t)CONFIG_KERNEL_VM_BASE + \
 				     (uintptr_t)CONFIG_KERNEL_VM_SIZE - \
 				     CONFIG_MMU_PAGE_SIZE))
+#define Z_READ_AHEAD_PAGE(n)	((void *)((uintptr_t)Z_SCRATCH_PAGE - \
+					  ((n) + 1) * CONFIG_MMU_PAGE_SIZE))
 #else
 #define Z_VM_RESERVED	0
 #endif
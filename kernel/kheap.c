@@ -10,11 +10,190 @@
 #include <zephyr/init.h>
 #include <zephyr/linker/linker-defs.h>
 
+#ifdef CONFIG_K_HEAP_CACHE
+
+#define CACHE_CLASSES   CONFIG_K_HEAP_CACHE_CLASSES
+#define CACHE_DEPTH     CONFIG_K_HEAP_CACHE_DEPTH
+#define CACHE_BATCH     (CACHE_DEPTH / 2)
+#define CACHE_MIN_SHIFT 4
+#define CACHE_MAX_BYTES BIT(CACHE_MIN_SHIFT + CACHE_CLASSES - 1)
+
+#define CLASS_BYTES(cls) BIT(CACHE_MIN_SHIFT + (cls))
+
+/* Lock ordering: the heap lock, when needed, is always taken before
+ * any of its cache locks.  The cache of the calling CPU is picked
+ * without preventing migration; landing on another CPU's cache only
+ * costs locality, as each cache is protected by its own lock.
+ */
+static struct z_heap_cache *local_cache(struct k_heap *h)
+{
+#ifdef CONFIG_SMP
+	return &h->cache[arch_curr_cpu()->id];
+#else
+	return &h->cache[0];
+#endif
+}
+
+/* Smallest size class holding @a bytes, or -1 if not cached */
+static int alloc_class(size_t align, size_t bytes)
+{
+	if (align > sizeof(void *) || bytes == 0 || bytes > CACHE_MAX_BYTES) {
+		return -1;
+	}
+
+	if (bytes <= CLASS_BYTES(0)) {
+		return 0;
+	}
+
+	return find_msb_set(bytes - 1) - CACHE_MIN_SHIFT;
+}
+
+/* Largest size class a block can serve, or -1 if not cached */
+static int free_class(struct k_heap *h, void *mem)
+{
+	size_t usable = sys_heap_usable_size(&h->heap, mem);
+
+	if (usable < CLASS_BYTES(0) || usable >= 2 * CACHE_MAX_BYTES) {
+		return -1;
+	}
+
+	return find_msb_set(usable) - 1 - CACHE_MIN_SHIFT;
+}
+
+static void push_block(struct z_heap_cache *cache, int cls, void *mem)
+{
+	*(void **)mem = cache->free_list[cls];
+	cache->free_list[cls] = mem;
+	cache->count[cls]++;
+}
+
+static void *pop_block(struct z_heap_cache *cache, int cls)
+{
+	void *mem = cache->free_list[cls];
+
+	cache->free_list[cls] = *(void **)mem;
+	cache->count[cls]--;
+	return mem;
+}
+
+static void *cache_alloc(struct k_heap *h, int cls)
+{
+	struct z_heap_cache *cache = local_cache(h);
+	k_spinlock_key_t key = k_spin_lock(&cache->lock);
+	void *mem = NULL;
+
+	if (!h->bypass_cache && cache->count[cls] != 0U) {
+		mem = pop_block(cache, cls);
+		cache->hits++;
+	} else {
+		cache->misses++;
+	}
+
+	k_spin_unlock(&cache->lock, key);
+
+	return mem;
+}
+
+static bool cache_free(struct k_heap *h, void *mem, int cls)
+{
+	struct z_heap_cache *cache = local_cache(h);
+	k_spinlock_key_t key = k_spin_lock(&cache->lock);
+	bool stashed = !h->bypass_cache && cache->count[cls] < CACHE_DEPTH;
+
+	if (stashed) {
+		push_block(cache, cls, mem);
+	}
+
+	k_spin_unlock(&cache->lock, key);
+
+	return stashed;
+}
+
+/* Tops up a size class of the local cache straight from the
+ * sys_heap, must be called with the heap lock held.
+ */
+static void cache_refill(struct k_heap *h, int cls)
+{
+	struct z_heap_cache *cache = &h->cache[_current_cpu->id];
+	k_spinlock_key_t key = k_spin_lock(&cache->lock);
+
+	while (!h->bypass_cache && cache->count[cls] < CACHE_BATCH) {
+		void *mem = sys_heap_alloc(&h->heap, CLASS_BYTES(cls));
+
+		if (mem == NULL) {
+			break;
+		}
+		push_block(cache, cls, mem);
+	}
+
+	k_spin_unlock(&cache->lock, key);
+}
+
+/* must be called with the heap lock held */
+static void cache_drain(struct k_heap *h, struct z_heap_cache *cache,
+			int cls, unsigned int n)
+{
+	k_spinlock_key_t key = k_spin_lock(&cache->lock);
+
+	while (n-- > 0U && cache->count[cls] != 0U) {
+		sys_heap_free(&h->heap, pop_block(cache, cls));
+	}
+
+	k_spin_unlock(&cache->lock, key);
+}
+
+/* Returns every cached block to the sys_heap, must be called with the
+ * heap lock held.
+ */
+static void cache_reclaim(struct k_heap *h)
+{
+	for (int i = 0; i < CONFIG_MP_MAX_NUM_CPUS; i++) {
+		for (int cls = 0; cls < CACHE_CLASSES; cls++) {
+			cache_drain(h, &h->cache[i], cls, CACHE_DEPTH);
+		}
+	}
+}
+
+int k_heap_cache_stats_get(struct k_heap *h, struct k_heap_cache_stats *stats)
+{
+	if ((h == NULL) || (stats == NULL)) {
+		return -EINVAL;
+	}
+
+	k_spinlock_key_t key = k_spin_lock(&h->lock);
+
+	*stats = (struct k_heap_cache_stats) {};
+	for (int i = 0; i < CONFIG_MP_MAX_NUM_CPUS; i++) {
+		struct z_heap_cache *cache = &h->cache[i];
+		k_spinlock_key_t ckey = k_spin_lock(&cache->lock);
+
+		for (int cls = 0; cls < CACHE_CLASSES; cls++) {
+			stats->cached_bytes += cache->count[cls] * CLASS_BYTES(cls);
+		}
+		stats->hits += cache->hits;
+		stats->misses += cache->misses;
+		k_spin_unlock(&cache->lock, ckey);
+	}
+
+	k_spin_unlock(&h->lock, key);
+
+	return 0;
+}
+
+#endif /* CONFIG_K_HEAP_CACHE */
+
 void k_heap_init(struct k_heap *h, void *mem, size_t bytes)
 {
 	z_waitq_init(&h->wait_q);
 	sys_heap_init(&h->heap, mem, bytes);
 
+#ifdef CONFIG_K_HEAP_CACHE
+	h->bypass_cache = false;
+	for (int i = 0; i < CONFIG_MP_MAX_NUM_CPUS; i++) {
+		h->cache[i] = (struct z_heap_cache) {};
+	}
+#endif
+
 	SYS_PORT_TRACING_OBJ_INIT(k_heap, h);
 }
 
@@ -69,6 +248,19 @@ void *k_heap_aligned_alloc(struct k_heap *h, size_t align, size_t bytes,
 
 	end = K_TIMEOUT_EQ(timeout, K_FOREVER) ? INT64_MAX : end;
 
+#ifdef CONFIG_K_HEAP_CACHE
+	int cls = alloc_class(align, bytes);
+
+	if (cls >= 0) {
+		ret = cache_alloc(h, cls);
+		if (ret != NULL) {
+			SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_heap, aligned_alloc, h, timeout);
+			SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_heap, aligned_alloc, h, timeout, ret);
+			return ret;
+		}
+	}
+#endif
+
 	k_spinlock_key_t key = k_spin_lock(&h->lock);
 
 	SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_heap, aligned_alloc, h, timeout);
@@ -78,7 +270,25 @@ void *k_heap_aligned_alloc(struct k_heap *h, size_t align, size_t bytes,
 	bool blocked_alloc = false;
 
 	while (ret == NULL) {
+#ifdef CONFIG_K_HEAP_CACHE
+		if (cls >= 0) {
+			/* Prefer a block reusable for its whole size class */
+			ret = sys_heap_alloc(&h->heap, CLASS_BYTES(cls));
+		}
+		if (ret == NULL) {
+			ret = sys_heap_aligned_alloc(&h->heap, align, bytes);
+		}
+		if (ret == NULL && !h->bypass_cache) {
+			/* Pull back blocks parked in the caches and retry
+			 * once before failing or waiting.
+			 */
+			h->bypass_cache = true;
+			cache_reclaim(h);
+			continue;
+		}
+#else
 		ret = sys_heap_aligned_alloc(&h->heap, align, bytes);
+#endif
 
 		now = sys_clock_tick_get();
 		if (!IS_ENABLED(CONFIG_MULTITHREADING) ||
@@ -101,6 +311,12 @@ void *k_heap_aligned_alloc(struct k_heap *h, size_t align, size_t bytes,
 		key = k_spin_lock(&h->lock);
 	}
 
+#ifdef CONFIG_K_HEAP_CACHE
+	if (ret != NULL && cls >= 0) {
+		cache_refill(h, cls);
+	}
+#endif
+
 	SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_heap, aligned_alloc, h, timeout, ret);
 
 	k_spin_unlock(&h->lock, key);
@@ -120,10 +336,31 @@ void *k_heap_alloc(struct k_heap *h, size_t bytes, k_timeout_t timeout)
 
 void k_heap_free(struct k_heap *h, void *mem)
 {
-	k_spinlock_key_t key = k_spin_lock(&h->lock);
+	k_spinlock_key_t key;
+
+#ifdef CONFIG_K_HEAP_CACHE
+	int cls = (mem != NULL) ? free_class(h, mem) : -1;
+
+	if (cls >= 0 && cache_free(h, mem, cls)) {
+		SYS_PORT_TRACING_OBJ_FUNC(k_heap, free, h);
+		return;
+	}
+#endif
+
+	key = k_spin_lock(&h->lock);
 
 	sys_heap_free(&h->heap, mem);
 
+#ifdef CONFIG_K_HEAP_CACHE
+	if (h->bypass_cache) {
+		/* memory came back, waiters retry and caching resumes */
+		h->bypass_cache = false;
+	} else if (cls >= 0) {
+		/* the local size class was full */
+		cache_drain(h, &h->cache[_current_cpu->id], cls, CACHE_BATCH);
+	}
+#endif
+
 	SYS_PORT_TRACING_OBJ_FUNC(k_heap, free, h);
 	if (IS_ENABLED(CONFIG_MULTITHREADING) && z_unpend_all(&h->wait_q) != 0) {
 		z_reschedule(&h->lock, key);
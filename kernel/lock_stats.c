@@ -0,0 +1,319 @@
+/*
+ * Copyright (c) 2022 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/spinlock.h>
+#include <kernel_internal.h>
+#include <string.h>
+
+/* Lock contention statistics, kept in an open addressing table keyed
+ * by lock address rather than in the locks themselves, so enabling
+ * this doesn't change the layout of any kernel object and a lock freed
+ * while tracked leaves a stale entry instead of a dangling pointer.
+ *
+ * An entry is claimed with a CAS on its key.  After that, its fields
+ * are only written by the holder of the lock it tracks, which makes
+ * the lock itself serialize all updates.  Readers get a snapshot which
+ * may be slightly inconsistent.
+ *
+ * For the same reason a reset doesn't touch the entries: it starts a
+ * new generation, and the next holder of each lock clears its entry.
+ */
+
+struct lock_entry {
+	atomic_ptr_t lock;
+	struct k_lock_stats stats;
+	atomic_val_t generation;
+	uint32_t hold_start;
+	void *hold_site;
+};
+
+static atomic_t generation;
+
+static struct lock_entry entries[CONFIG_LOCK_STATS_MAX_LOCKS];
+
+/* Longest probe sequence of a claimed entry.  Entries are never
+ * released, so once a lookup found the table full, a lock not found
+ * that far from its hash isn't tracked and the rest isn't scanned.
+ */
+static atomic_t max_probe;
+static bool full;
+
+/* Set while a CPU updates the statistics: the cycle counter may take
+ * a spinlock itself, which mustn't recurse in here.
+ */
+static bool busy[CONFIG_MP_MAX_NUM_CPUS];
+
+/* Hold time of a spinlock being released, kept from the point it is
+ * still held to the point the cycle counter can be read (see
+ * z_spin_lock_stats_releasing()).
+ */
+static struct {
+	struct lock_entry *entry;
+	uint32_t start;
+	void *site;
+} releasing[CONFIG_MP_MAX_NUM_CPUS];
+
+static struct lock_entry *entry_get(const void *lock, bool mutex)
+{
+	uint32_t hash = (uint32_t)((uintptr_t)lock / sizeof(void *));
+	int probes = full ? (atomic_get(&max_probe) + 1) : ARRAY_SIZE(entries);
+
+	hash = (hash * 2654435761U) >> 16;
+
+	for (int i = 0; i < probes; i++) {
+		struct lock_entry *e =
+			&entries[(hash + i) % ARRAY_SIZE(entries)];
+		void *key = atomic_ptr_get(&e->lock);
+
+		if (key == NULL) {
+			atomic_val_t old;
+
+			/* Raised before the claim, so a lookup finding
+			 * the table full can't miss this entry.
+			 */
+			do {
+				old = atomic_get(&max_probe);
+			} while ((old < i) && !atomic_cas(&max_probe, old, i));
+
+			if (atomic_ptr_cas(&e->lock, NULL, (void *)lock)) {
+				e->stats.mutex = mutex;
+				return e;
+			}
+		}
+
+		if (atomic_ptr_get(&e->lock) == lock) {
+			return e;
+		}
+	}
+
+	if (probes == ARRAY_SIZE(entries)) {
+		full = true;
+	}
+
+	return NULL;
+}
+
+/* Enter the statistics code on this CPU, with interrupts locked, or
+ * return false if it is already in there.
+ */
+static inline bool stats_enter(void)
+{
+	bool *cpu_busy = &busy[arch_curr_cpu()->id];
+
+	if (*cpu_busy) {
+		return false;
+	}
+	*cpu_busy = true;
+
+	return true;
+}
+
+static inline void stats_exit(void)
+{
+	busy[arch_curr_cpu()->id] = false;
+}
+
+uint32_t z_lock_stats_now(void)
+{
+	unsigned int key = arch_irq_lock();
+	uint32_t now = 0U;
+
+	if (stats_enter()) {
+		/* Zero is "not timed" */
+		now = MAX(k_cycle_get_32(), 1U);
+		stats_exit();
+	}
+
+	arch_irq_unlock(key);
+
+	return now;
+}
+
+static void lock_acquired(const void *lock, bool mutex, uint32_t wait_start,
+			  uint32_t now, void *site)
+{
+	unsigned int key = arch_irq_lock();
+	struct lock_entry *e;
+
+	if ((now != 0U) && stats_enter()) {
+		e = entry_get(lock, mutex);
+		if (e != NULL) {
+			atomic_val_t gen = atomic_get(&generation);
+
+			if (e->generation != gen) {
+				e->generation = gen;
+				e->stats.acquisitions = 0U;
+				e->stats.contended = 0U;
+				e->stats.wait_cycles = 0U;
+				e->stats.max_hold_cycles = 0U;
+				e->stats.max_hold_site = NULL;
+			}
+
+			e->stats.acquisitions++;
+			if (wait_start != 0U) {
+				e->stats.contended++;
+				e->stats.wait_cycles += now - wait_start;
+			}
+			e->hold_site = site;
+			e->hold_start = now;
+		}
+
+		stats_exit();
+	}
+
+	arch_irq_unlock(key);
+}
+
+static void hold_update(struct lock_entry *e, uint32_t cycles, void *site)
+{
+	if (cycles > e->stats.max_hold_cycles) {
+		e->stats.max_hold_cycles = cycles;
+		e->stats.max_hold_site = site;
+	}
+}
+
+#ifdef CONFIG_SMP
+uint32_t z_spin_lock_stats_spin(struct k_spinlock *l)
+{
+	uint32_t now;
+
+	/* The counter is read while the lock isn't held, the last
+	 * read before getting it is the acquisition time.
+	 */
+	do {
+		now = z_lock_stats_now();
+	} while (!atomic_cas(&l->locked, 0, 1));
+
+	return now;
+}
+#endif
+
+void z_spin_lock_stats_acquired(struct k_spinlock *l, uint32_t wait_start,
+				uint32_t now)
+{
+	/* k_spin_lock() is inlined, so this is in its caller */
+	lock_acquired(l, false, wait_start, now, __builtin_return_address(0));
+}
+
+void z_spin_lock_stats_releasing(struct k_spinlock *l)
+{
+	unsigned int key = arch_irq_lock();
+	int id = arch_curr_cpu()->id;
+	struct lock_entry *e;
+
+	/* Nested in z_spin_lock_stats_released() of another lock, whose
+	 * hold time is still pending: leave it alone.
+	 */
+	if (stats_enter()) {
+		releasing[id].entry = NULL;
+
+		e = entry_get(l, false);
+		if ((e != NULL) && (e->hold_site != NULL)) {
+			releasing[id].entry = e;
+			releasing[id].start = e->hold_start;
+			releasing[id].site = e->hold_site;
+			e->hold_site = NULL;
+		}
+
+		stats_exit();
+	}
+
+	arch_irq_unlock(key);
+}
+
+void z_spin_lock_stats_released(void)
+{
+	unsigned int key = arch_irq_lock();
+	int id = arch_curr_cpu()->id;
+	struct lock_entry *e = releasing[id].entry;
+	uint32_t now;
+
+	if (!busy[id] && (e != NULL)) {
+		now = z_lock_stats_now();
+
+		/* The lock is free again, so this races with its next
+		 * holder on another CPU: a maximum may get lost.
+		 */
+		if (stats_enter()) {
+			hold_update(e, now - releasing[id].start,
+				    releasing[id].site);
+			releasing[id].entry = NULL;
+			stats_exit();
+		}
+	}
+
+	arch_irq_unlock(key);
+}
+
+void z_mutex_lock_stats_acquired(struct k_mutex *mutex, uint32_t wait_start,
+				 void *site)
+{
+	lock_acquired(mutex, true, wait_start, z_lock_stats_now(), site);
+}
+
+void z_mutex_lock_stats_released(struct k_mutex *mutex)
+{
+	/* Mutexes are updated under the kernel's mutex spinlock, which
+	 * the cycle counter never takes.
+	 */
+	uint32_t now = z_lock_stats_now();
+	unsigned int key = arch_irq_lock();
+	struct lock_entry *e;
+
+	if ((now != 0U) && stats_enter()) {
+		e = entry_get(mutex, true);
+		if ((e != NULL) && (e->hold_site != NULL)) {
+			hold_update(e, now - e->hold_start, e->hold_site);
+			e->hold_site = NULL;
+		}
+
+		stats_exit();
+	}
+
+	arch_irq_unlock(key);
+}
+
+int k_lock_stats_get(struct k_lock_stats *stats, int max)
+{
+	int n = 0;
+
+	for (int i = 0; i < ARRAY_SIZE(entries); i++) {
+		struct k_lock_stats s = entries[i].stats;
+		int j = MIN(n, max - 1);
+
+		s.lock = atomic_ptr_get(&entries[i].lock);
+		if ((s.lock == NULL) || (s.acquisitions == 0U) || (j < 0) ||
+		    (entries[i].generation != atomic_get(&generation))) {
+			continue;
+		}
+
+		/* Insertion into the top max, dropping the last if full */
+		if ((n == max) &&
+		    ((s.contended < stats[j].contended) ||
+		     ((s.contended == stats[j].contended) &&
+		      (s.wait_cycles <= stats[j].wait_cycles)))) {
+			continue;
+		}
+
+		for (; (j > 0) &&
+		       ((stats[j - 1].contended < s.contended) ||
+			((stats[j - 1].contended == s.contended) &&
+			 (stats[j - 1].wait_cycles < s.wait_cycles)));
+		     j--) {
+			stats[j] = stats[j - 1];
+		}
+		stats[j] = s;
+		n = MIN(n + 1, max);
+	}
+
+	return n;
+}
+
+void k_lock_stats_reset(void)
+{
+	(void)atomic_inc(&generation);
+}
@@ -73,6 +73,154 @@ out:
 SYS_INIT(init_mem_slab_module, PRE_KERNEL_1,
 	 CONFIG_KERNEL_INIT_PRIORITY_OBJECTS);
 
+#ifdef CONFIG_MEM_SLAB_PERCPU_CACHE
+
+#define CACHE_SIZE  CONFIG_MEM_SLAB_PERCPU_CACHE_SIZE
+#define CACHE_BATCH (CACHE_SIZE / 2)
+
+/* Lock ordering: the slab lock, when needed, is always taken before
+ * any of its cache locks.  The cache of the calling CPU is picked
+ * without preventing migration; landing on another CPU's cache only
+ * costs locality, as each cache is protected by its own lock.
+ */
+static struct z_mem_slab_cache *local_cache(struct k_mem_slab *slab)
+{
+	return &slab->cache[arch_curr_cpu()->id];
+}
+
+static bool cache_alloc(struct k_mem_slab *slab, void **mem)
+{
+	struct z_mem_slab_cache *cache = local_cache(slab);
+	k_spinlock_key_t key = k_spin_lock(&cache->lock);
+	bool hit = !slab->bypass_cache && cache->count != 0U;
+
+	if (hit) {
+		*mem = cache->free_list;
+		cache->free_list = *(char **)(cache->free_list);
+		cache->count--;
+		cache->hits++;
+	} else {
+		cache->misses++;
+	}
+
+	k_spin_unlock(&cache->lock, key);
+
+	return hit;
+}
+
+static bool cache_free(struct k_mem_slab *slab, void **mem)
+{
+	struct z_mem_slab_cache *cache = local_cache(slab);
+	k_spinlock_key_t key = k_spin_lock(&cache->lock);
+	bool stashed = !slab->bypass_cache && cache->count < CACHE_SIZE;
+
+	if (stashed) {
+		**(char ***) mem = cache->free_list;
+		cache->free_list = *(char **) mem;
+		cache->count++;
+	}
+
+	k_spin_unlock(&cache->lock, key);
+
+	return stashed;
+}
+
+/* Moves up to @a n blocks from @a from to @a to, returns the count */
+static uint32_t move_blocks(char **from, char **to, uint32_t n)
+{
+	uint32_t moved = 0U;
+
+	while (moved < n && *from != NULL) {
+		char *block = *from;
+
+		*from = *(char **)block;
+		*(char **)block = *to;
+		*to = block;
+		moved++;
+	}
+
+	return moved;
+}
+
+/* must be called with the slab lock held */
+static void cache_refill(struct k_mem_slab *slab)
+{
+	struct z_mem_slab_cache *cache = &slab->cache[_current_cpu->id];
+	k_spinlock_key_t key;
+	uint32_t n;
+
+	if (slab->bypass_cache) {
+		return;
+	}
+
+	key = k_spin_lock(&cache->lock);
+	n = move_blocks(&slab->free_list, &cache->free_list,
+			MIN(CACHE_BATCH, CACHE_SIZE - cache->count));
+	cache->count += n;
+	slab->num_used += n;
+	k_spin_unlock(&cache->lock, key);
+}
+
+/* must be called with the slab lock held */
+static void cache_drain(struct k_mem_slab *slab, struct z_mem_slab_cache *cache,
+			uint32_t n)
+{
+	k_spinlock_key_t key = k_spin_lock(&cache->lock);
+
+	n = move_blocks(&cache->free_list, &slab->free_list, n);
+	cache->count -= n;
+	slab->num_used -= n;
+	k_spin_unlock(&cache->lock, key);
+}
+
+/* Returns every cached block to the shared free list, must be called
+ * with the slab lock held.
+ */
+static void cache_reclaim(struct k_mem_slab *slab)
+{
+	for (int i = 0; i < CONFIG_MP_MAX_NUM_CPUS; i++) {
+		cache_drain(slab, &slab->cache[i], UINT32_MAX);
+	}
+}
+
+uint32_t z_mem_slab_num_cached(struct k_mem_slab *slab)
+{
+	uint32_t cached = 0U;
+
+	for (int i = 0; i < CONFIG_MP_MAX_NUM_CPUS; i++) {
+		cached += slab->cache[i].count;
+	}
+
+	return cached;
+}
+
+int k_mem_slab_cache_stats_get(struct k_mem_slab *slab,
+			       struct k_mem_slab_cache_stats *stats)
+{
+	if ((slab == NULL) || (stats == NULL)) {
+		return -EINVAL;
+	}
+
+	k_spinlock_key_t key = k_spin_lock(&slab->lock);
+
+	*stats = (struct k_mem_slab_cache_stats) {};
+	for (int i = 0; i < CONFIG_MP_MAX_NUM_CPUS; i++) {
+		struct z_mem_slab_cache *cache = &slab->cache[i];
+		k_spinlock_key_t ckey = k_spin_lock(&cache->lock);
+
+		stats->cached_blocks += cache->count;
+		stats->hits += cache->hits;
+		stats->misses += cache->misses;
+		k_spin_unlock(&cache->lock, ckey);
+	}
+
+	k_spin_unlock(&slab->lock, key);
+
+	return 0;
+}
+
+#endif /* CONFIG_MEM_SLAB_PERCPU_CACHE */
+
 int k_mem_slab_init(struct k_mem_slab *slab, void *buffer,
 		    size_t block_size, uint32_t num_blocks)
 {
@@ -88,6 +236,13 @@ int k_mem_slab_init(struct k_mem_slab *slab, void *buffer,
 	slab->max_used = 0U;
 #endif
 
+#ifdef CONFIG_MEM_SLAB_PERCPU_CACHE
+	slab->bypass_cache = false;
+	for (int i = 0; i < CONFIG_MP_MAX_NUM_CPUS; i++) {
+		slab->cache[i] = (struct z_mem_slab_cache) {};
+	}
+#endif
+
 	rc = create_free_list(slab);
 	if (rc < 0) {
 		goto out;
@@ -103,17 +258,44 @@ out:
 
 int k_mem_slab_alloc(struct k_mem_slab *slab, void **mem, k_timeout_t timeout)
 {
-	k_spinlock_key_t key = k_spin_lock(&slab->lock);
+	k_spinlock_key_t key;
 	int result;
 
 	SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_mem_slab, alloc, slab, timeout);
 
+#ifdef CONFIG_MEM_SLAB_PERCPU_CACHE
+	if (cache_alloc(slab, mem)) {
+		SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_mem_slab, alloc, slab, timeout, 0);
+		return 0;
+	}
+#endif
+
+	key = k_spin_lock(&slab->lock);
+
+#ifdef CONFIG_MEM_SLAB_PERCPU_CACHE
+	if (slab->free_list == NULL) {
+		/* Pull back blocks stranded in other CPUs' caches before
+		 * failing or waiting.  Frees racing with this observe
+		 * bypass_cache and come through the slab lock instead.
+		 */
+		slab->bypass_cache = true;
+		cache_reclaim(slab);
+	}
+#endif
+
 	if (slab->free_list != NULL) {
 		/* take a free block */
 		*mem = slab->free_list;
 		slab->free_list = *(char **)(slab->free_list);
 		slab->num_used++;
 
+#ifdef CONFIG_MEM_SLAB_PERCPU_CACHE
+		if (slab->bypass_cache && z_waitq_head(&slab->wait_q) == NULL) {
+			slab->bypass_cache = false;
+		}
+		cache_refill(slab);
+#endif
+
 #ifdef CONFIG_MEM_SLAB_TRACE_MAX_UTILIZATION
 		slab->max_used = MAX(slab->num_used, slab->max_used);
 #endif
@@ -147,9 +329,19 @@ int k_mem_slab_alloc(struct k_mem_slab *slab, void **mem, k_timeout_t timeout)
 
 void k_mem_slab_free(struct k_mem_slab *slab, void **mem)
 {
-	k_spinlock_key_t key = k_spin_lock(&slab->lock);
+	k_spinlock_key_t key;
 
 	SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_mem_slab, free, slab);
+
+#ifdef CONFIG_MEM_SLAB_PERCPU_CACHE
+	if (cache_free(slab, mem)) {
+		SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_mem_slab, free, slab);
+		return;
+	}
+#endif
+
+	key = k_spin_lock(&slab->lock);
+
 	if (slab->free_list == NULL && IS_ENABLED(CONFIG_MULTITHREADING)) {
 		struct k_thread *pending_thread = z_unpend_first_thread(&slab->wait_q);
 
@@ -166,6 +358,16 @@ void k_mem_slab_free(struct k_mem_slab *slab, void **mem)
 	slab->free_list = *(char **) mem;
 	slab->num_used--;
 
+#ifdef CONFIG_MEM_SLAB_PERCPU_CACHE
+	if (slab->bypass_cache) {
+		/* nobody was waiting, caching can resume */
+		slab->bypass_cache = false;
+	} else {
+		/* the local cache was full */
+		cache_drain(slab, &slab->cache[_current_cpu->id], CACHE_BATCH);
+	}
+#endif
+
 	SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_mem_slab, free, slab);
 
 	k_spin_unlock(&slab->lock, key);
@@ -179,8 +381,10 @@ int k_mem_slab_runtime_stats_get(struct k_mem_slab *slab, struct sys_memory_stat
 
 	k_spinlock_key_t key = k_spin_lock(&slab->lock);
 
-	stats->allocated_bytes = slab->num_used * slab->block_size;
-	stats->free_bytes = (slab->num_blocks - slab->num_used) * slab->block_size;
+	uint32_t num_used = k_mem_slab_num_used_get(slab);
+
+	stats->allocated_bytes = num_used * slab->block_size;
+	stats->free_bytes = (slab->num_blocks - num_used) * slab->block_size;
 #ifdef CONFIG_MEM_SLAB_TRACE_MAX_UTILIZATION
 	stats->max_allocated_bytes = slab->max_used * slab->block_size;
 #else
@@ -1312,6 +1312,112 @@ static inline struct z_page_frame *do_eviction_select(bool *dirty)
 	return pf;
 }
 
+#if CONFIG_DEMAND_PAGING_READ_AHEAD > 0
+static inline void paging_stats_read_ahead_add(struct k_thread *faulting_thread,
+					       size_t count)
+{
+#ifdef CONFIG_DEMAND_PAGING_STATS
+	paging_stats.pagefaults.read_ahead += count;
+#ifdef CONFIG_DEMAND_PAGING_THREAD_STATS
+	faulting_thread->paging_stats.pagefaults.read_ahead += count;
+#else
+	ARG_UNUSED(faulting_thread);
+#endif /* CONFIG_DEMAND_PAGING_THREAD_STATS */
+#endif /* CONFIG_DEMAND_PAGING_STATS */
+}
+
+/* Page in the paged out data pages following the one at addr, saving the
+ * page faults sequential accesses would take on them. This is
+ * speculative, so only free page frames are used, and it stops at the
+ * first data page that isn't paged out.
+ *
+ * Called with interrupts locked, they are unlocked during the transfer
+ * with CONFIG_DEMAND_PAGING_ALLOW_IRQ like for the faulting page.
+ */
+static void read_ahead(void *addr, struct k_thread *faulting_thread,
+		       int *key_ptr)
+{
+	struct z_page_frame *pfs[CONFIG_DEMAND_PAGING_READ_AHEAD];
+	uintptr_t locations[CONFIG_DEMAND_PAGING_READ_AHEAD];
+	uint8_t *pos = UINT_TO_POINTER(POINTER_TO_UINT(addr)
+				       & ~(CONFIG_MMU_PAGE_SIZE - 1));
+	size_t count = 0;
+
+	while (count < CONFIG_DEMAND_PAGING_READ_AHEAD) {
+		struct z_page_frame *pf;
+
+		pos += CONFIG_MMU_PAGE_SIZE;
+		if ((pos >= (uint8_t *)Z_VIRT_REGION_END_ADDR) ||
+		    (arch_page_location_get(pos, &locations[count]) !=
+		     ARCH_PAGE_LOCATION_PAGED_OUT)) {
+			break;
+		}
+
+		pf = free_page_frame_list_get();
+		if (pf == NULL) {
+			break;
+		}
+#ifdef CONFIG_DEMAND_PAGING_ALLOW_IRQ
+		pf->flags |= Z_PAGE_FRAME_BUSY;
+#endif /* CONFIG_DEMAND_PAGING_ALLOW_IRQ */
+		pfs[count++] = pf;
+	}
+
+	if (count == 0) {
+		return;
+	}
+
+#ifdef CONFIG_BACKING_STORE_PAGE_IN_BATCH
+	void *dests[CONFIG_DEMAND_PAGING_READ_AHEAD];
+
+	for (size_t i = 0; i < count; i++) {
+		dests[i] = Z_READ_AHEAD_PAGE(i);
+		arch_mem_map(dests[i], z_page_frame_to_phys(pfs[i]),
+			     CONFIG_MMU_PAGE_SIZE,
+			     K_MEM_PERM_RW | K_MEM_CACHE_WB);
+	}
+#endif /* CONFIG_BACKING_STORE_PAGE_IN_BATCH */
+
+#ifdef CONFIG_DEMAND_PAGING_ALLOW_IRQ
+	irq_unlock(*key_ptr);
+#endif /* CONFIG_DEMAND_PAGING_ALLOW_IRQ */
+
+#ifdef CONFIG_BACKING_STORE_PAGE_IN_BATCH
+	k_mem_paging_backing_store_page_in_batch(locations, dests, count);
+#else
+	for (size_t i = 0; i < count; i++) {
+		arch_mem_scratch(z_page_frame_to_phys(pfs[i]));
+		do_backing_store_page_in(locations[i]);
+	}
+#endif /* CONFIG_BACKING_STORE_PAGE_IN_BATCH */
+
+#ifdef CONFIG_DEMAND_PAGING_ALLOW_IRQ
+	*key_ptr = irq_lock();
+#endif /* CONFIG_DEMAND_PAGING_ALLOW_IRQ */
+
+	pos = UINT_TO_POINTER(POINTER_TO_UINT(addr)
+			      & ~(CONFIG_MMU_PAGE_SIZE - 1));
+	for (size_t i = 0; i < count; i++) {
+		struct z_page_frame *pf = pfs[i];
+
+#ifdef CONFIG_BACKING_STORE_PAGE_IN_BATCH
+		arch_mem_unmap(dests[i], CONFIG_MMU_PAGE_SIZE);
+#endif /* CONFIG_BACKING_STORE_PAGE_IN_BATCH */
+#ifdef CONFIG_DEMAND_PAGING_ALLOW_IRQ
+		pf->flags &= ~Z_PAGE_FRAME_BUSY;
+#endif /* CONFIG_DEMAND_PAGING_ALLOW_IRQ */
+		pos += CONFIG_MMU_PAGE_SIZE;
+		pf->flags |= Z_PAGE_FRAME_MAPPED;
+		pf->addr = pos;
+
+		arch_mem_page_in(pos, z_page_frame_to_phys(pf));
+		k_mem_paging_backing_store_page_finalize(pf, locations[i]);
+	}
+
+	paging_stats_read_ahead_add(faulting_thread, count);
+}
+#endif /* CONFIG_DEMAND_PAGING_READ_AHEAD > 0 */
+
 static bool do_page_fault(void *addr, bool pin)
 {
 	struct z_page_frame *pf;
@@ -1431,6 +1537,9 @@ static bool do_page_fault(void *addr, bool pin)
 
 	arch_mem_page_in(addr, z_page_frame_to_phys(pf));
 	k_mem_paging_backing_store_page_finalize(pf, page_in_location);
+#if CONFIG_DEMAND_PAGING_READ_AHEAD > 0
+	read_ahead(addr, faulting_thread, &key);
+#endif /* CONFIG_DEMAND_PAGING_READ_AHEAD > 0 */
 out:
 	irq_unlock(key);
 #ifdef CONFIG_DEMAND_PAGING_ALLOW_IRQ
@@ -32,6 +32,120 @@ static inline void handle_poll_events(struct k_msgq *msgq, uint32_t state)
 }
 #endif /* CONFIG_POLL */
 
+static inline void msgq_ptr_advance(struct k_msgq *msgq, char **ptr)
+{
+	*ptr += msgq->msg_size;
+	if (*ptr == msgq->buffer_end) {
+		*ptr = msgq->buffer_start;
+	}
+}
+
+/* Give a new message to the first thread waiting to receive one, if
+ * any.  @a msg may be the slot at write_ptr itself, when committing a
+ * reservation.
+ */
+static bool msgq_hand_off(struct k_msgq *msgq, const void *msg)
+{
+	struct k_thread *pending_thread;
+
+	pending_thread = z_unpend_first_thread(&msgq->wait_q);
+	if (pending_thread == NULL) {
+		return false;
+	}
+
+	(void)memcpy(pending_thread->base.swap_data, msg, msgq->msg_size);
+	arch_thread_return_value_set(pending_thread, 0);
+	z_ready_thread(pending_thread);
+
+	return true;
+}
+
+/* Let the first thread waiting to send a message use the slot which
+ * was just freed, if any.
+ */
+static bool msgq_refill(struct k_msgq *msgq)
+{
+	struct k_thread *pending_thread;
+
+	pending_thread = z_unpend_first_thread(&msgq->wait_q);
+	if (pending_thread == NULL) {
+		return false;
+	}
+
+	/* add thread's message to queue */
+	(void)memcpy(msgq->write_ptr, pending_thread->base.swap_data,
+		     msgq->msg_size);
+	msgq_ptr_advance(msgq, &msgq->write_ptr);
+	msgq->used_msgs++;
+	arch_thread_return_value_set(pending_thread, 0);
+	z_ready_thread(pending_thread);
+
+	return true;
+}
+
+/* Threads which can't go ahead because of a reservation or a claim, and
+ * those waiting in k_msgq_reserve() or k_msgq_peek_ref(), wait on busy_q
+ * rather than wait_q, so that wait_q only ever holds copying senders of
+ * a full queue or copying receivers of an empty one.  They are all woken
+ * up whenever the queue changes, and check it again.
+ */
+static inline bool msgq_wake_busy(struct k_msgq *msgq)
+{
+	return z_sched_wake_all(&msgq->busy_q, 0, NULL);
+}
+
+static k_timeout_t msgq_timeout_left(k_timeout_t timeout, int64_t end)
+{
+	if (K_TIMEOUT_EQ(timeout, K_FOREVER)) {
+		return K_FOREVER;
+	}
+
+	return K_TICKS(MAX(end - sys_clock_tick_get(), 0));
+}
+
+/* Wait on busy_q until the queue changes or the waiting period ending
+ * at @a end is over.  Called and returns with the lock held.
+ *
+ * @retval 0 Woken up, the queue is to be checked again.
+ * @retval -EAGAIN Waiting period over, or K_NO_WAIT.
+ */
+static int msgq_wait_busy(struct k_msgq *msgq, k_spinlock_key_t *key,
+			  k_timeout_t timeout, int64_t end)
+{
+	if (K_TIMEOUT_EQ(timeout, K_NO_WAIT) ||
+	    (!K_TIMEOUT_EQ(timeout, K_FOREVER) &&
+	     ((end - sys_clock_tick_get()) <= 0))) {
+		return -EAGAIN;
+	}
+
+	(void)z_pend_curr(&msgq->lock, *key, &msgq->busy_q,
+			  msgq_timeout_left(timeout, end));
+	*key = k_spin_lock(&msgq->lock);
+
+	return 0;
+}
+
+/* Wait for the reservation or claim in @a flag to end.
+ *
+ * @retval 0 Not reserved or claimed (anymore).
+ * @retval -EBUSY Still reserved or claimed, with K_NO_WAIT.
+ * @retval -EAGAIN Waiting period timed out.
+ */
+static int msgq_wait_unflagged(struct k_msgq *msgq, k_spinlock_key_t *key,
+			       uint8_t flag, k_timeout_t timeout, int64_t end)
+{
+	while ((msgq->flags & flag) != 0U) {
+		if (K_TIMEOUT_EQ(timeout, K_NO_WAIT)) {
+			return -EBUSY;
+		}
+		if (msgq_wait_busy(msgq, key, timeout, end) != 0) {
+			return -EAGAIN;
+		}
+	}
+
+	return 0;
+}
+
 void k_msgq_init(struct k_msgq *msgq, char *buffer, size_t msg_size,
 		 uint32_t max_msgs)
 {
@@ -44,6 +158,7 @@ void k_msgq_init(struct k_msgq *msgq, char *buffer, size_t msg_size,
 	msgq->used_msgs = 0;
 	msgq->flags = 0;
 	z_waitq_init(&msgq->wait_q);
+	z_waitq_init(&msgq->busy_q);
 	msgq->lock = (struct k_spinlock) {};
 #ifdef CONFIG_POLL
 	sys_dlist_init(&msgq->poll_events);
@@ -96,7 +211,8 @@ int k_msgq_cleanup(struct k_msgq *msgq)
 {
 	SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_msgq, cleanup, msgq);
 
-	CHECKIF(z_waitq_head(&msgq->wait_q) != NULL) {
+	CHECKIF((z_waitq_head(&msgq->wait_q) != NULL) ||
+		(z_waitq_head(&msgq->busy_q) != NULL)) {
 		SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_msgq, cleanup, msgq, -EBUSY);
 
 		return -EBUSY;
@@ -117,39 +233,36 @@ int z_impl_k_msgq_put(struct k_msgq *msgq, const void *data, k_timeout_t timeout
 {
 	__ASSERT(!arch_is_in_isr() || K_TIMEOUT_EQ(timeout, K_NO_WAIT), "");
 
-	struct k_thread *pending_thread;
+	int64_t end = sys_clock_timeout_end_calc(timeout);
 	k_spinlock_key_t key;
+	bool resched = false;
 	int result;
 
 	key = k_spin_lock(&msgq->lock);
 
 	SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_msgq, put, msgq, timeout);
 
-	if (msgq->used_msgs < msgq->max_msgs) {
+	/* the next slot belongs to a zero-copy sender until committed */
+	result = msgq_wait_unflagged(msgq, &key, K_MSGQ_FLAG_RESERVED,
+				     timeout, end);
+	if (result != 0) {
+		/* still reserved */
+	} else if (msgq->used_msgs < msgq->max_msgs) {
 		/* message queue isn't full */
-		pending_thread = z_unpend_first_thread(&msgq->wait_q);
-		if (pending_thread != NULL) {
+		if (msgq_hand_off(msgq, data)) {
 			SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_msgq, put, msgq, timeout, 0);
 
-			/* give message to waiting thread */
-			(void)memcpy(pending_thread->base.swap_data, data,
-			       msgq->msg_size);
-			/* wake up waiting thread */
-			arch_thread_return_value_set(pending_thread, 0);
-			z_ready_thread(pending_thread);
 			z_reschedule(&msgq->lock, key);
 			return 0;
 		} else {
 			/* put message in queue */
 			(void)memcpy(msgq->write_ptr, data, msgq->msg_size);
-			msgq->write_ptr += msgq->msg_size;
-			if (msgq->write_ptr == msgq->buffer_end) {
-				msgq->write_ptr = msgq->buffer_start;
-			}
+			msgq_ptr_advance(msgq, &msgq->write_ptr);
 			msgq->used_msgs++;
 #ifdef CONFIG_POLL
 			handle_poll_events(msgq, K_POLL_STATE_MSGQ_DATA_AVAILABLE);
 #endif /* CONFIG_POLL */
+			resched = msgq_wake_busy(msgq);
 		}
 		result = 0;
 	} else if (K_TIMEOUT_EQ(timeout, K_NO_WAIT)) {
@@ -161,14 +274,19 @@ int z_impl_k_msgq_put(struct k_msgq *msgq, const void *data, k_timeout_t timeout
 		/* wait for put message success, failure, or timeout */
 		_current->base.swap_data = (void *) data;
 
-		result = z_pend_curr(&msgq->lock, key, &msgq->wait_q, timeout);
+		result = z_pend_curr(&msgq->lock, key, &msgq->wait_q,
+				     msgq_timeout_left(timeout, end));
 		SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_msgq, put, msgq, timeout, result);
 		return result;
 	}
 
 	SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_msgq, put, msgq, timeout, result);
 
-	k_spin_unlock(&msgq->lock, key);
+	if (resched) {
+		z_reschedule(&msgq->lock, key);
+	} else {
+		k_spin_unlock(&msgq->lock, key);
+	}
 
 	return result;
 }
@@ -207,46 +325,37 @@ int z_impl_k_msgq_get(struct k_msgq *msgq, void *data, k_timeout_t timeout)
 {
 	__ASSERT(!arch_is_in_isr() || K_TIMEOUT_EQ(timeout, K_NO_WAIT), "");
 
+	int64_t end = sys_clock_timeout_end_calc(timeout);
 	k_spinlock_key_t key;
-	struct k_thread *pending_thread;
+	bool resched = false;
 	int result;
 
 	key = k_spin_lock(&msgq->lock);
 
 	SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_msgq, get, msgq, timeout);
 
-	if (msgq->used_msgs > 0U) {
+	/* the first message is being read in place until released */
+	result = msgq_wait_unflagged(msgq, &key, K_MSGQ_FLAG_CLAIMED,
+				     timeout, end);
+	if (result != 0) {
+		/* still claimed */
+	} else if (msgq->used_msgs > 0U) {
 		/* take first available message from queue */
 		(void)memcpy(data, msgq->read_ptr, msgq->msg_size);
-		msgq->read_ptr += msgq->msg_size;
-		if (msgq->read_ptr == msgq->buffer_end) {
-			msgq->read_ptr = msgq->buffer_start;
-		}
+		msgq_ptr_advance(msgq, &msgq->read_ptr);
 		msgq->used_msgs--;
 
 		/* handle first thread waiting to write (if any) */
-		pending_thread = z_unpend_first_thread(&msgq->wait_q);
-		if (pending_thread != NULL) {
+		if (msgq_refill(msgq)) {
 			SYS_PORT_TRACING_OBJ_FUNC_BLOCKING(k_msgq, get, msgq, timeout);
 
-			/* add thread's message to queue */
-			(void)memcpy(msgq->write_ptr, pending_thread->base.swap_data,
-			       msgq->msg_size);
-			msgq->write_ptr += msgq->msg_size;
-			if (msgq->write_ptr == msgq->buffer_end) {
-				msgq->write_ptr = msgq->buffer_start;
-			}
-			msgq->used_msgs++;
-
-			/* wake up waiting thread */
-			arch_thread_return_value_set(pending_thread, 0);
-			z_ready_thread(pending_thread);
 			z_reschedule(&msgq->lock, key);
 
 			SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_msgq, get, msgq, timeout, 0);
 
 			return 0;
 		}
+		resched = msgq_wake_busy(msgq);
 		result = 0;
 	} else if (K_TIMEOUT_EQ(timeout, K_NO_WAIT)) {
 		/* don't wait for a message to become available */
@@ -257,14 +366,19 @@ int z_impl_k_msgq_get(struct k_msgq *msgq, void *data, k_timeout_t timeout)
 		/* wait for get message success or timeout */
 		_current->base.swap_data = data;
 
-		result = z_pend_curr(&msgq->lock, key, &msgq->wait_q, timeout);
+		result = z_pend_curr(&msgq->lock, key, &msgq->wait_q,
+				     msgq_timeout_left(timeout, end));
 		SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_msgq, get, msgq, timeout, result);
 		return result;
 	}
 
 	SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_msgq, get, msgq, timeout, result);
 
-	k_spin_unlock(&msgq->lock, key);
+	if (resched) {
+		z_reschedule(&msgq->lock, key);
+	} else {
+		k_spin_unlock(&msgq->lock, key);
+	}
 
 	return result;
 }
@@ -315,6 +429,128 @@ static inline int z_vrfy_k_msgq_peek(struct k_msgq *msgq, void *data)
 #include <syscalls/k_msgq_peek_mrsh.c>
 #endif
 
+int k_msgq_reserve(struct k_msgq *msgq, void **msg, k_timeout_t timeout)
+{
+	__ASSERT(!arch_is_in_isr() || K_TIMEOUT_EQ(timeout, K_NO_WAIT), "");
+
+	int64_t end = sys_clock_timeout_end_calc(timeout);
+	k_spinlock_key_t key;
+	int result;
+
+	key = k_spin_lock(&msgq->lock);
+
+	for (;;) {
+		if ((msgq->flags & K_MSGQ_FLAG_RESERVED) != 0U) {
+			result = -EBUSY;
+		} else if (msgq->used_msgs < msgq->max_msgs) {
+			msgq->flags |= K_MSGQ_FLAG_RESERVED;
+			*msg = msgq->write_ptr;
+			result = 0;
+			break;
+		} else {
+			result = -ENOMSG;
+		}
+
+		/* wait for a commit or a free slot */
+		if (msgq_wait_busy(msgq, &key, timeout, end) != 0) {
+			if (!K_TIMEOUT_EQ(timeout, K_NO_WAIT)) {
+				result = -EAGAIN;
+			}
+			break;
+		}
+	}
+
+	k_spin_unlock(&msgq->lock, key);
+
+	return result;
+}
+
+int k_msgq_commit(struct k_msgq *msgq)
+{
+	k_spinlock_key_t key;
+
+	key = k_spin_lock(&msgq->lock);
+
+	if ((msgq->flags & K_MSGQ_FLAG_RESERVED) == 0U) {
+		k_spin_unlock(&msgq->lock, key);
+		return -EINVAL;
+	}
+
+	msgq->flags &= ~K_MSGQ_FLAG_RESERVED;
+
+	if (!msgq_hand_off(msgq, msgq->write_ptr)) {
+		msgq_ptr_advance(msgq, &msgq->write_ptr);
+		msgq->used_msgs++;
+#ifdef CONFIG_POLL
+		handle_poll_events(msgq, K_POLL_STATE_MSGQ_DATA_AVAILABLE);
+#endif /* CONFIG_POLL */
+	}
+	(void)msgq_wake_busy(msgq);
+
+	z_reschedule(&msgq->lock, key);
+
+	return 0;
+}
+
+int k_msgq_peek_ref(struct k_msgq *msgq, void **msg, k_timeout_t timeout)
+{
+	__ASSERT(!arch_is_in_isr() || K_TIMEOUT_EQ(timeout, K_NO_WAIT), "");
+
+	int64_t end = sys_clock_timeout_end_calc(timeout);
+	k_spinlock_key_t key;
+	int result;
+
+	key = k_spin_lock(&msgq->lock);
+
+	for (;;) {
+		if ((msgq->flags & K_MSGQ_FLAG_CLAIMED) != 0U) {
+			result = -EBUSY;
+		} else if (msgq->used_msgs > 0U) {
+			msgq->flags |= K_MSGQ_FLAG_CLAIMED;
+			*msg = msgq->read_ptr;
+			result = 0;
+			break;
+		} else {
+			result = -ENOMSG;
+		}
+
+		/* wait for a release or a message */
+		if (msgq_wait_busy(msgq, &key, timeout, end) != 0) {
+			if (!K_TIMEOUT_EQ(timeout, K_NO_WAIT)) {
+				result = -EAGAIN;
+			}
+			break;
+		}
+	}
+
+	k_spin_unlock(&msgq->lock, key);
+
+	return result;
+}
+
+int k_msgq_release(struct k_msgq *msgq)
+{
+	k_spinlock_key_t key;
+
+	key = k_spin_lock(&msgq->lock);
+
+	if ((msgq->flags & K_MSGQ_FLAG_CLAIMED) == 0U) {
+		k_spin_unlock(&msgq->lock, key);
+		return -EINVAL;
+	}
+
+	msgq->flags &= ~K_MSGQ_FLAG_CLAIMED;
+	msgq_ptr_advance(msgq, &msgq->read_ptr);
+	msgq->used_msgs--;
+
+	(void)msgq_refill(msgq);
+	(void)msgq_wake_busy(msgq);
+
+	z_reschedule(&msgq->lock, key);
+
+	return 0;
+}
+
 void z_impl_k_msgq_purge(struct k_msgq *msgq)
 {
 	k_spinlock_key_t key;
@@ -324,6 +560,15 @@ void z_impl_k_msgq_purge(struct k_msgq *msgq)
 
 	SYS_PORT_TRACING_OBJ_FUNC(k_msgq, purge, msgq);
 
+	/* A reserved slot or claimed message is still being accessed in
+	 * place, and its slot mustn't be handed out again meanwhile.
+	 */
+	while ((msgq->flags &
+		(K_MSGQ_FLAG_RESERVED | K_MSGQ_FLAG_CLAIMED)) != 0U) {
+		__ASSERT(!arch_is_in_isr(), "purge would wait in ISR");
+		(void)msgq_wait_busy(msgq, &key, K_FOREVER, INT64_MAX);
+	}
+
 	/* wake up any threads that are waiting to write */
 	while ((pending_thread = z_unpend_first_thread(&msgq->wait_q)) != NULL) {
 		arch_thread_return_value_set(pending_thread, -ENOMSG);
@@ -332,6 +577,7 @@ void z_impl_k_msgq_purge(struct k_msgq *msgq)
 
 	msgq->used_msgs = 0;
 	msgq->read_ptr = msgq->write_ptr;
+	(void)msgq_wake_busy(msgq);
 
 	z_reschedule(&msgq->lock, key);
 }
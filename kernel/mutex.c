@@ -92,11 +92,47 @@ static bool adjust_owner_prio(struct k_mutex *mutex, int32_t new_prio)
 	return false;
 }
 
+#ifdef CONFIG_MUTEX_ADAPTIVE_SPIN
+/* Wait for an owner running on another CPU to release the mutex,
+ * without holding the lock meanwhile.  Gives up as soon as the owner
+ * (which changes when the mutex is handed to a pended thread) is not
+ * running, since it may then hold the mutex for arbitrarily long and
+ * would need its priority boosted.  Threads already pended are handed
+ * the mutex before us, so there is no point spinning behind them.
+ * Called and returns with the lock held.
+ */
+static void mutex_spin(struct k_mutex *mutex, k_spinlock_key_t *key)
+{
+	struct k_thread *volatile *owner = &mutex->owner;
+
+	if (z_waitq_head(&mutex->wait_q) != NULL) {
+		return;
+	}
+
+	k_spin_unlock(&lock, *key);
+
+	for (int i = 0; i < CONFIG_MUTEX_SPIN_BUDGET; i++) {
+		struct k_thread *thread = *owner;
+
+		if ((thread == NULL) || !z_is_thread_running(thread)) {
+			break;
+		}
+		arch_spin_relax();
+	}
+
+	*key = k_spin_lock(&lock);
+}
+#endif
+
 int z_impl_k_mutex_lock(struct k_mutex *mutex, k_timeout_t timeout)
 {
 	int new_prio;
 	k_spinlock_key_t key;
 	bool resched = false;
+#ifdef CONFIG_LOCK_STATS
+	void *site = __builtin_return_address(0);
+	uint32_t wait_start = 0U;
+#endif
 
 	__ASSERT(!arch_is_in_isr(), "mutexes cannot be used inside ISRs");
 
@@ -104,6 +140,20 @@ int z_impl_k_mutex_lock(struct k_mutex *mutex, k_timeout_t timeout)
 
 	key = k_spin_lock(&lock);
 
+#ifdef CONFIG_LOCK_STATS
+	if ((mutex->lock_count != 0U) && (mutex->owner != _current)) {
+		/* Zero means we didn't wait */
+		wait_start = MAX(k_cycle_get_32(), 1U);
+	}
+#endif
+
+#ifdef CONFIG_MUTEX_ADAPTIVE_SPIN
+	if ((mutex->lock_count != 0U) && (mutex->owner != _current) &&
+	    !K_TIMEOUT_EQ(timeout, K_NO_WAIT)) {
+		mutex_spin(mutex, &key);
+	}
+#endif
+
 	if (likely((mutex->lock_count == 0U) || (mutex->owner == _current))) {
 
 		mutex->owner_orig_prio = (mutex->lock_count == 0U) ?
@@ -113,6 +163,12 @@ int z_impl_k_mutex_lock(struct k_mutex *mutex, k_timeout_t timeout)
 		mutex->lock_count++;
 		mutex->owner = _current;
 
+#ifdef CONFIG_LOCK_STATS
+		if (mutex->lock_count == 1U) {
+			z_mutex_lock_stats_acquired(mutex, wait_start, site);
+		}
+#endif
+
 		LOG_DBG("%p took mutex %p, count: %d, orig prio: %d",
 			_current, mutex, mutex->lock_count,
 			mutex->owner_orig_prio);
@@ -151,6 +207,9 @@ int z_impl_k_mutex_lock(struct k_mutex *mutex, k_timeout_t timeout)
 		got_mutex ? 'y' : 'n');
 
 	if (got_mutex == 0) {
+#ifdef CONFIG_LOCK_STATS
+		z_mutex_lock_stats_acquired(mutex, wait_start, site);
+#endif
 		SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_mutex, lock, mutex, timeout, 0);
 		return 0;
 	}
@@ -239,6 +298,10 @@ int z_impl_k_mutex_unlock(struct k_mutex *mutex)
 		goto k_mutex_unlock_return;
 	}
 
+#ifdef CONFIG_LOCK_STATS
+	z_mutex_lock_stats_released(mutex);
+#endif
+
 	k_spinlock_key_t key = k_spin_lock(&lock);
 
 	adjust_owner_prio(mutex, mutex->owner_orig_prio);
@@ -34,10 +34,11 @@
  */
 static struct k_spinlock lock;
 
-enum POLL_MODE { MODE_NONE, MODE_POLL, MODE_TRIGGERED };
+enum POLL_MODE { MODE_NONE, MODE_POLL, MODE_TRIGGERED, MODE_SET };
 
 static int signal_poller(struct k_poll_event *event, uint32_t state);
 static int signal_triggered_work(struct k_poll_event *event, uint32_t status);
+static int signal_set(struct k_poll_event *event, uint32_t state);
 
 void k_poll_event_init(struct k_poll_event *event, uint32_t type,
 		       int mode, void *obj)
@@ -54,6 +55,9 @@ void k_poll_event_init(struct k_poll_event *event, uint32_t type,
 	event->mode = mode;
 	event->unused = 0U;
 	event->obj = obj;
+#ifdef CONFIG_POLL_SET
+	sys_dnode_init(&event->_ready_node);
+#endif
 
 	SYS_PORT_TRACING_FUNC(k_poll_api, event_init, event);
 }
@@ -69,6 +73,14 @@ static inline bool is_condition_met(struct k_poll_event *event, uint32_t *state)
 		}
 		break;
 	case K_POLL_TYPE_DATA_AVAILABLE:
+#ifdef CONFIG_QUEUE_LOCKFREE_APPEND
+		/* Lockless appends check the flag after publishing their
+		 * item: either the item is seen below, or the appender
+		 * takes the locked path and signals the event once it is
+		 * registered.
+		 */
+		(void)atomic_or(&event->queue->waiting, Z_QUEUE_WAITING_POLL);
+#endif
 		if (!k_queue_is_empty(event->queue)) {
 			*state = K_POLL_STATE_FIFO_DATA_AVAILABLE;
 			return true;
@@ -108,21 +120,31 @@ static struct k_thread *poller_thread(struct z_poller *p)
 	return p ? CONTAINER_OF(p, struct k_thread, poller) : NULL;
 }
 
+static inline bool poller_is_set(struct z_poller *p)
+{
+	return IS_ENABLED(CONFIG_POLL_SET) && (p->mode == MODE_SET);
+}
+
+/* Poll sets have no thread to rank them by and stay registered for
+ * good, so they queue behind every thread poller.
+ */
 static inline void add_event(sys_dlist_t *events, struct k_poll_event *event,
 			     struct z_poller *poller)
 {
 	struct k_poll_event *pending;
 
 	pending = (struct k_poll_event *)sys_dlist_peek_tail(events);
-	if ((pending == NULL) ||
-		(z_sched_prio_cmp(poller_thread(pending->poller),
+	if ((pending == NULL) || poller_is_set(poller) ||
+		(!poller_is_set(pending->poller) &&
+		 z_sched_prio_cmp(poller_thread(pending->poller),
 							   poller_thread(poller)) > 0)) {
 		sys_dlist_append(events, &event->_node);
 		return;
 	}
 
 	SYS_DLIST_FOR_EACH_CONTAINER(events, pending, _node) {
-		if (z_sched_prio_cmp(poller_thread(poller),
+		if (poller_is_set(pending->poller) ||
+		    z_sched_prio_cmp(poller_thread(poller),
 					poller_thread(pending->poller)) > 0) {
 			sys_dlist_insert(&pending->_node, &event->_node);
 			return;
@@ -446,6 +468,11 @@ static int signal_poll_event(struct k_poll_event *event, uint32_t state)
 	struct z_poller *poller = event->poller;
 	int retcode = 0;
 
+	if ((poller != NULL) && poller_is_set(poller)) {
+		/* Stays registered, the set tracks its own readiness */
+		return signal_set(event, state);
+	}
+
 	if (poller != NULL) {
 		if (poller->mode == MODE_POLL) {
 			retcode = signal_poller(event, state);
@@ -467,6 +494,15 @@ static int signal_poll_event(struct k_poll_event *event, uint32_t state)
 	return retcode;
 }
 
+/* Put a poll set member back on its object's list once signaled */
+static inline void rearm_set_event(sys_dlist_t *events,
+				   struct k_poll_event *event)
+{
+	if ((event->poller != NULL) && poller_is_set(event->poller)) {
+		sys_dlist_append(events, &event->_node);
+	}
+}
+
 void z_handle_obj_poll_events(sys_dlist_t *events, uint32_t state)
 {
 	struct k_poll_event *poll_event;
@@ -474,6 +510,7 @@ void z_handle_obj_poll_events(sys_dlist_t *events, uint32_t state)
 	poll_event = (struct k_poll_event *)sys_dlist_get(events);
 	if (poll_event != NULL) {
 		(void) signal_poll_event(poll_event, state);
+		rearm_set_event(events, poll_event);
 	}
 }
 
@@ -543,6 +580,8 @@ int z_impl_k_poll_signal_raise(struct k_poll_signal *sig, int result)
 
 	int rc = signal_poll_event(poll_event, K_POLL_STATE_SIGNALED);
 
+	rearm_set_event(&sig->poll_events, poll_event);
+
 	SYS_PORT_TRACING_FUNC(k_poll_api, signal_raise, sig, rc);
 
 	z_reschedule(&lock, key);
@@ -813,3 +852,167 @@ int k_work_poll_cancel(struct k_work_poll *work)
 
 	return retval;
 }
+
+#ifdef CONFIG_POLL_SET
+
+/* must be called with interrupts locked */
+static int signal_set(struct k_poll_event *event, uint32_t state)
+{
+	struct k_poll_set *set =
+		CONTAINER_OF(event->poller, struct k_poll_set, poller);
+	k_spinlock_key_t key = k_spin_lock(&set->lock);
+
+	if (!sys_dnode_is_linked(&event->_ready_node)) {
+		sys_dlist_append(&set->ready, &event->_ready_node);
+	}
+	event->state |= state;
+
+	(void)z_sched_wake(&set->wait_q, 0, NULL);
+	k_spin_unlock(&set->lock, key);
+
+	return 0;
+}
+
+void k_poll_set_init(struct k_poll_set *set)
+{
+	*set = (struct k_poll_set) {};
+	set->poller.mode = MODE_SET;
+	z_waitq_init(&set->wait_q);
+	sys_dlist_init(&set->ready);
+	sys_dlist_init(&set->returned);
+}
+
+int k_poll_set_add(struct k_poll_set *set, struct k_poll_event *event)
+{
+	k_spinlock_key_t key = k_spin_lock(&lock);
+	uint32_t state;
+
+	__ASSERT(event->mode == K_POLL_MODE_NOTIFY_ONLY,
+		 "only NOTIFY_ONLY mode is supported\n");
+
+	if (event->poller != NULL) {
+		k_spin_unlock(&lock, key);
+		return -EBUSY;
+	}
+
+	sys_dnode_init(&event->_ready_node);
+	event->state = K_POLL_STATE_NOT_READY;
+	register_event(event, &set->poller);
+
+	if (is_condition_met(event, &state)) {
+		(void)signal_set(event, state);
+	}
+	k_spin_unlock(&lock, key);
+
+	return 0;
+}
+
+int k_poll_set_remove(struct k_poll_set *set, struct k_poll_event *event)
+{
+	k_spinlock_key_t key = k_spin_lock(&lock);
+	k_spinlock_key_t set_key;
+
+	if (event->poller != &set->poller) {
+		k_spin_unlock(&lock, key);
+		return -EINVAL;
+	}
+
+	clear_event_registration(event);
+
+	set_key = k_spin_lock(&set->lock);
+	if (sys_dnode_is_linked(&event->_ready_node)) {
+		sys_dlist_remove(&event->_ready_node);
+	}
+	k_spin_unlock(&set->lock, set_key);
+	k_spin_unlock(&lock, key);
+
+	return 0;
+}
+
+int k_poll_set_wait(struct k_poll_set *set, struct k_poll_event **ready,
+		    int max, k_timeout_t timeout)
+{
+	int64_t now, end = sys_clock_timeout_end_calc(timeout);
+	k_spinlock_key_t key;
+	sys_dnode_t *node;
+	int n = 0;
+
+	__ASSERT(!arch_is_in_isr() || K_TIMEOUT_EQ(timeout, K_NO_WAIT), "");
+	__ASSERT(ready != NULL, "NULL ready\n");
+	__ASSERT(max > 0, "no room for ready events\n");
+
+	end = K_TIMEOUT_EQ(timeout, K_FOREVER) ? INT64_MAX : end;
+
+	key = k_spin_lock(&set->lock);
+
+	/* Objects only signal state changes: whatever was returned last
+	 * time, e.g. a FIFO that still holds data, has to be looked at
+	 * again.
+	 */
+	while ((node = sys_dlist_get(&set->returned)) != NULL) {
+		struct k_poll_event *event =
+			CONTAINER_OF(node, struct k_poll_event, _ready_node);
+
+		event->state = K_POLL_STATE_NOT_READY;
+		sys_dlist_append(&set->ready, node);
+	}
+
+	while (true) {
+		while ((n < max) &&
+		       ((node = sys_dlist_get(&set->ready)) != NULL)) {
+			struct k_poll_event *event =
+				CONTAINER_OF(node, struct k_poll_event,
+					     _ready_node);
+			uint32_t state = event->state & K_POLL_STATE_CANCELLED;
+			uint32_t cond = K_POLL_STATE_NOT_READY;
+
+			event->state = K_POLL_STATE_NOT_READY;
+
+			/* Checking the object may take its lock, which is
+			 * held when it signals the set: drop ours.
+			 */
+			k_spin_unlock(&set->lock, key);
+			(void)is_condition_met(event, &cond);
+			key = k_spin_lock(&set->lock);
+
+			state |= cond;
+			if (state == K_POLL_STATE_NOT_READY) {
+				/* Consumed before we got to it */
+				continue;
+			}
+
+			/* Signaled again meanwhile: still return it once */
+			if (sys_dnode_is_linked(node)) {
+				sys_dlist_remove(node);
+			}
+			sys_dlist_append(&set->returned, node);
+			event->state |= state;
+			ready[n++] = event;
+		}
+
+		now = sys_clock_tick_get();
+		if ((n > 0) || ((end - now) <= 0)) {
+			break;
+		}
+
+		(void)z_pend_curr(&set->lock, key, &set->wait_q,
+				  K_TICKS(end - now));
+		key = k_spin_lock(&set->lock);
+	}
+
+	k_spin_unlock(&set->lock, key);
+
+	return (n > 0) ? n : -EAGAIN;
+}
+
+#else
+
+static int signal_set(struct k_poll_event *event, uint32_t state)
+{
+	ARG_UNUSED(event);
+	ARG_UNUSED(state);
+
+	return 0;
+}
+
+#endif /* CONFIG_POLL_SET */
@@ -60,6 +60,10 @@ void z_impl_k_queue_init(struct k_queue *queue)
 	sys_sflist_init(&queue->data_q);
 	queue->lock = (struct k_spinlock) {};
 	z_waitq_init(&queue->wait_q);
+#ifdef CONFIG_QUEUE_LOCKFREE_APPEND
+	atomic_ptr_clear(&queue->pending);
+	atomic_clear(&queue->waiting);
+#endif
 #if defined(CONFIG_POLL)
 	sys_dlist_init(&queue->poll_events);
 #endif
@@ -78,6 +82,72 @@ static inline void z_vrfy_k_queue_init(struct k_queue *queue)
 #include <syscalls/k_queue_init_mrsh.c>
 #endif
 
+#ifdef CONFIG_QUEUE_LOCKFREE_APPEND
+/* Move the items appended locklessly over to data_q, oldest first.
+ * Must be called with the queue lock held, before anything else
+ * looks at data_q, so that ordering with the locked operations is
+ * kept.
+ */
+static void queue_drain_pending(struct k_queue *queue)
+{
+	void *node = atomic_ptr_clear(&queue->pending);
+	void *head = NULL, *tail = node;
+
+	if (node == NULL) {
+		return;
+	}
+
+	/* The pending list is in LIFO order, reverse it */
+	while (node != NULL) {
+		void *next = *(void **)node;
+
+		*(void **)node = head;
+		head = node;
+		node = next;
+	}
+
+	sys_sflist_append_list(&queue->data_q, head, tail);
+}
+
+/* The waiting threads flag is set by consumers with the lock held, right
+ * before they pend, and only cleared here once nobody is left waiting.
+ * Threads stop waiting (time out, get aborted...) without updating it,
+ * so it may stay set until the next locked operation.  Must be called
+ * with the queue lock held.
+ */
+static inline void queue_update_waiting(struct k_queue *queue)
+{
+	if (z_waitq_head(&queue->wait_q) == NULL) {
+		(void)atomic_and(&queue->waiting, ~Z_QUEUE_WAITING_THREADS);
+	}
+}
+#else
+static inline void queue_drain_pending(struct k_queue *queue)
+{
+	ARG_UNUSED(queue);
+}
+
+static inline void queue_update_waiting(struct k_queue *queue)
+{
+	ARG_UNUSED(queue);
+}
+#endif
+
+/* For the operations reading data_q without holding the lock */
+static inline void queue_sync(struct k_queue *queue)
+{
+#ifdef CONFIG_QUEUE_LOCKFREE_APPEND
+	if (atomic_ptr_get(&queue->pending) != NULL) {
+		k_spinlock_key_t key = k_spin_lock(&queue->lock);
+
+		queue_drain_pending(queue);
+		k_spin_unlock(&queue->lock, key);
+	}
+#else
+	ARG_UNUSED(queue);
+#endif
+}
+
 static void prepare_thread_to_run(struct k_thread *thread, void *data)
 {
 	z_thread_return_value_set_with_data(thread, 0, data);
@@ -125,10 +195,13 @@ static int32_t queue_insert(struct k_queue *queue, void *prev, void *data,
 
 	SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_queue, queue_insert, queue, alloc);
 
+	queue_drain_pending(queue);
+
 	if (is_append) {
 		prev = sys_sflist_peek_tail(&queue->data_q);
 	}
 	first_pending_thread = z_unpend_first_thread(&queue->wait_q);
+	queue_update_waiting(queue);
 
 	if (first_pending_thread != NULL) {
 		SYS_PORT_TRACING_OBJ_FUNC_BLOCKING(k_queue, queue_insert, queue, alloc, K_FOREVER);
@@ -181,10 +254,61 @@ void k_queue_insert(struct k_queue *queue, void *prev, void *data)
 	SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_queue, insert, queue);
 }
 
+#ifdef CONFIG_QUEUE_LOCKFREE_APPEND
+/* Lock-free append, for when nobody needs to be woken up.  Returns
+ * false without appending otherwise.
+ */
+static bool queue_append_lockfree(struct k_queue *queue, void *data)
+{
+	void *head;
+
+	if (atomic_get(&queue->waiting) != 0) {
+		return false;
+	}
+
+	do {
+		head = atomic_ptr_get(&queue->pending);
+		*(void **)data = head;
+	} while (!atomic_ptr_cas(&queue->pending, head, data));
+
+	/* A consumer or a poller may have started waiting after the check
+	 * above, in which case it either saw the item or flagged itself in
+	 * time for us to see it here: hand the item over through the locked
+	 * path.
+	 */
+	if (atomic_get(&queue->waiting) != 0) {
+		k_spinlock_key_t key = k_spin_lock(&queue->lock);
+		struct k_thread *thread;
+
+		queue_drain_pending(queue);
+		while (!sys_sflist_is_empty(&queue->data_q) &&
+		       (thread = z_unpend_first_thread(&queue->wait_q)) != NULL) {
+			sys_sfnode_t *node = sys_sflist_get_not_empty(&queue->data_q);
+
+			prepare_thread_to_run(thread, z_queue_node_peek(node, true));
+		}
+		queue_update_waiting(queue);
+		if (!sys_sflist_is_empty(&queue->data_q)) {
+			handle_poll_events(queue, K_POLL_STATE_DATA_AVAILABLE);
+		}
+		z_reschedule(&queue->lock, key);
+	}
+
+	return true;
+}
+#endif
+
 void k_queue_append(struct k_queue *queue, void *data)
 {
 	SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_queue, append, queue);
 
+#ifdef CONFIG_QUEUE_LOCKFREE_APPEND
+	if (queue_append_lockfree(queue, data)) {
+		SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_queue, append, queue);
+		return;
+	}
+#endif
+
 	(void)queue_insert(queue, NULL, data, false, true);
 
 	SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_queue, append, queue);
@@ -255,6 +379,8 @@ int k_queue_append_list(struct k_queue *queue, void *head, void *tail)
 	k_spinlock_key_t key = k_spin_lock(&queue->lock);
 	struct k_thread *thread = NULL;
 
+	queue_drain_pending(queue);
+
 	if (head != NULL) {
 		thread = z_unpend_first_thread(&queue->wait_q);
 	}
@@ -265,6 +391,8 @@ int k_queue_append_list(struct k_queue *queue, void *head, void *tail)
 		thread = z_unpend_first_thread(&queue->wait_q);
 	}
 
+	queue_update_waiting(queue);
+
 	if (head != NULL) {
 		sys_sflist_append_list(&queue->data_q, head, tail);
 	}
@@ -318,6 +446,8 @@ void *z_impl_k_queue_get(struct k_queue *queue, k_timeout_t timeout)
 
 	SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_queue, get, queue, timeout);
 
+	queue_drain_pending(queue);
+
 	if (likely(!sys_sflist_is_empty(&queue->data_q))) {
 		sys_sfnode_t *node;
 
@@ -340,6 +470,24 @@ void *z_impl_k_queue_get(struct k_queue *queue, k_timeout_t timeout)
 		return NULL;
 	}
 
+#ifdef CONFIG_QUEUE_LOCKFREE_APPEND
+	/* Make lockless appenders take the locked path from now on, then
+	 * check for anything appended before they could notice.
+	 */
+	(void)atomic_or(&queue->waiting, Z_QUEUE_WAITING_THREADS);
+	queue_drain_pending(queue);
+	if (!sys_sflist_is_empty(&queue->data_q)) {
+		queue_update_waiting(queue);
+		data = z_queue_node_peek(sys_sflist_get_not_empty(&queue->data_q),
+					 true);
+		k_spin_unlock(&queue->lock, key);
+
+		SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_queue, get, queue, timeout, data);
+
+		return data;
+	}
+#endif
+
 	int ret = z_pend_curr(&queue->lock, key, &queue->wait_q, timeout);
 
 	SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_queue, get, queue, timeout,
@@ -352,6 +500,8 @@ bool k_queue_remove(struct k_queue *queue, void *data)
 {
 	SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_queue, remove, queue);
 
+	queue_sync(queue);
+
 	bool ret = sys_sflist_find_and_remove(&queue->data_q, (sys_sfnode_t *)data);
 
 	SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_queue, remove, queue, ret);
@@ -365,6 +515,8 @@ bool k_queue_unique_append(struct k_queue *queue, void *data)
 
 	sys_sfnode_t *test;
 
+	queue_sync(queue);
+
 	SYS_SFLIST_FOR_EACH_NODE(&queue->data_q, test) {
 		if (test == (sys_sfnode_t *) data) {
 			SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_queue, unique_append, queue, false);
@@ -382,6 +534,8 @@ bool k_queue_unique_append(struct k_queue *queue, void *data)
 
 void *z_impl_k_queue_peek_head(struct k_queue *queue)
 {
+	queue_sync(queue);
+
 	void *ret = z_queue_node_peek(sys_sflist_peek_head(&queue->data_q), false);
 
 	SYS_PORT_TRACING_OBJ_FUNC(k_queue, peek_head, queue, ret);
@@ -391,6 +545,8 @@ void *z_impl_k_queue_peek_head(struct k_queue *queue)
 
 void *z_impl_k_queue_peek_tail(struct k_queue *queue)
 {
+	queue_sync(queue);
+
 	void *ret = z_queue_node_peek(sys_sflist_peek_tail(&queue->data_q), false);
 
 	SYS_PORT_TRACING_OBJ_FUNC(k_queue, peek_tail, queue, ret);
@@ -41,6 +41,10 @@ static ALWAYS_INLINE void z_priq_mq_add(struct _priq_mq *pq,
 					struct k_thread *thread);
 static ALWAYS_INLINE void z_priq_mq_remove(struct _priq_mq *pq,
 					   struct k_thread *thread);
+#elif defined(CONFIG_SCHED_BITMAP)
+#define _priq_run_add		z_priq_bitmap_add
+#define _priq_run_remove	z_priq_bitmap_remove
+#define _priq_run_best		z_priq_bitmap_best
 #endif
 
 #if defined(CONFIG_WAITQ_SCALABLE)
@@ -210,6 +214,11 @@ static ALWAYS_INLINE void *thread_runq(struct k_thread *thread)
 	cpu = m == 0 ? 0 : u32_count_trailing_zeros(m);
 
 	return &_kernel.cpus[cpu].ready_q.runq;
+#elif defined(CONFIG_SCHED_CPU_RUNQ)
+	/* Queued threads stay on the queue of base.cpu, which only
+	 * changes when they are picked to run (see runq_add())
+	 */
+	return &_kernel.cpus[thread->base.cpu].ready_q.runq;
 #else
 	return &_kernel.ready_q.runq;
 #endif
@@ -217,13 +226,75 @@ static ALWAYS_INLINE void *thread_runq(struct k_thread *thread)
 
 static ALWAYS_INLINE void *curr_cpu_runq(void)
 {
-#ifdef CONFIG_SCHED_CPU_MASK_PIN_ONLY
+#if defined(CONFIG_SCHED_CPU_MASK_PIN_ONLY) || defined(CONFIG_SCHED_CPU_RUNQ)
 	return &arch_curr_cpu()->ready_q.runq;
 #else
 	return &_kernel.ready_q.runq;
 #endif
 }
 
+#ifdef CONFIG_SCHED_CPU_RUNQ
+static ALWAYS_INLINE void runq_add(struct k_thread *thread)
+{
+#ifdef CONFIG_SCHED_CPU_MASK
+	uint32_t m = thread->base.cpu_mask;
+
+	/* Threads go back to the CPU they last ran on, unless their
+	 * mask was changed to exclude it while they were not running.
+	 * As above, an empty mask is legal and just means "never".
+	 */
+	if ((m != 0U) && ((m & BIT(thread->base.cpu)) == 0U)) {
+		thread->base.cpu = u32_count_trailing_zeros(m);
+	}
+#endif
+
+	_priq_run_add(thread_runq(thread), thread);
+	_kernel.cpus[thread->base.cpu].ready_q.count++;
+}
+
+static ALWAYS_INLINE void runq_remove(struct k_thread *thread)
+{
+	_priq_run_remove(thread_runq(thread), thread);
+	_kernel.cpus[thread->base.cpu].ready_q.count--;
+}
+
+/* Best thread for this CPU across all queues.  The local queue wins
+ * unless another one holds a strictly higher priority thread; with
+ * nothing runnable locally, ties go to the queue with the most
+ * threads, so idle CPUs drain the busiest one first.
+ */
+static ALWAYS_INLINE struct k_thread *runq_best(void)
+{
+	struct _cpu *cpu = arch_curr_cpu();
+	struct k_thread *thread = _priq_run_best(&cpu->ready_q.runq);
+	unsigned int busiest = 0U;
+	unsigned int num_cpus = arch_num_cpus();
+
+	for (int i = 0; i < num_cpus; i++) {
+		struct _ready_q *rq = &_kernel.cpus[i].ready_q;
+		struct k_thread *t;
+		int32_t cmp;
+
+		if ((rq == &cpu->ready_q) || (rq->count == 0U)) {
+			continue;
+		}
+
+		t = _priq_run_best(&rq->runq);
+		if (t == NULL) {
+			continue;
+		}
+
+		cmp = (thread == NULL) ? 1 : z_sched_prio_cmp(t, thread);
+		if ((cmp > 0) || ((cmp == 0) && (busiest != 0U) &&
+				  (rq->count > busiest))) {
+			thread = t;
+			busiest = rq->count;
+		}
+	}
+
+	return thread;
+}
+#else
 static ALWAYS_INLINE void runq_add(struct k_thread *thread)
 {
 	_priq_run_add(thread_runq(thread), thread);
@@ -238,6 +309,7 @@ static ALWAYS_INLINE struct k_thread *runq_best(void)
 {
 	return _priq_run_best(curr_cpu_runq());
 }
+#endif
 
 /* _current is never in the run queue until context switch on
  * SMP configurations, see z_requeue_current()
@@ -269,6 +341,17 @@ static ALWAYS_INLINE void dequeue_thread(struct k_thread *thread)
 	}
 }
 
+#if defined(CONFIG_SMP) && defined(CONFIG_SCHED_IPI_SUPPORTED)
+static inline void count_ipis(uint32_t ipi_mask)
+{
+#ifdef CONFIG_SCHED_THREAD_USAGE_ALL
+	/* Statistics only: a racy increment is fine */
+	ipi_mask &= ~BIT(arch_curr_cpu()->id);
+	arch_curr_cpu()->ipi_count += __builtin_popcount(ipi_mask);
+#endif
+}
+#endif
+
 static void signal_pending_ipi(void)
 {
 	/* Synchronization note: you might think we need to lock these
@@ -276,13 +359,21 @@ static void signal_pending_ipi(void)
 	 * twice.  All we require is that if a CPU sees the flag true,
 	 * it is guaranteed to send the IPI, and if a core sets
 	 * pending_ipi, the IPI will be sent the next time through
-	 * this code.
+	 * this code.  The atomic swap makes sure that CPUs flagged
+	 * concurrently are never dropped from the mask.
 	 */
 #if defined(CONFIG_SMP) && defined(CONFIG_SCHED_IPI_SUPPORTED)
 	if (arch_num_cpus() > 1) {
-		if (_kernel.pending_ipi) {
-			_kernel.pending_ipi = false;
+		uint32_t ipi_mask = (uint32_t)atomic_clear(&_kernel.pending_ipi);
+
+		if (ipi_mask != 0U) {
+#ifdef CONFIG_SCHED_IPI_TARGETED
+			arch_sched_directed_ipi(ipi_mask);
+#else
 			arch_sched_ipi();
+			ipi_mask = BIT_MASK(arch_num_cpus());
+#endif
+			count_ipis(ipi_mask);
 		}
 	}
 #endif
@@ -605,16 +696,71 @@ static bool thread_active_elsewhere(struct k_thread *thread)
 	return false;
 }
 
-static void flag_ipi(void)
+/* CPUs to interrupt on behalf of a thread whose scheduling state just
+ * changed.  Must be called with sched_spinlock held.  Without
+ * SCHED_IPI_TARGETED any non-zero mask means "all other CPUs".
+ */
+static uint32_t ipi_mask_create(struct k_thread *thread)
+{
+#if defined(CONFIG_SMP) && defined(CONFIG_SCHED_IPI_TARGETED)
+	uint32_t ipi_mask = 0U;
+	uint32_t id = _current_cpu->id;
+	unsigned int num_cpus = arch_num_cpus();
+
+	for (int i = 0; i < num_cpus; i++) {
+		struct k_thread *curr = _kernel.cpus[i].current;
+
+		/* Not started yet: z_smp_init() runs after threads are
+		 * readied at boot, and the CPU picks its thread then.
+		 */
+		if ((i == id) || (curr == NULL)) {
+			continue;
+		}
+
+		/* The thread itself is running there, e.g. it was just
+		 * deprioritized: let that CPU reconsider.
+		 */
+		if (curr == thread) {
+			ipi_mask |= BIT(i);
+			continue;
+		}
+
+#ifdef CONFIG_SCHED_CPU_MASK
+		if ((thread->base.cpu_mask & BIT(i)) == 0U) {
+			continue;
+		}
+#endif
+
+		if (z_is_idle_thread_object(curr) ||
+		    ((z_sched_prio_cmp(thread, curr) > 0) &&
+		     (is_preempt(curr) || is_metairq(thread)))) {
+			ipi_mask |= BIT(i);
+		}
+	}
+
+	return ipi_mask;
+#else
+	ARG_UNUSED(thread);
+
+	return 1U;
+#endif
+}
+
+static void flag_ipi(uint32_t ipi_mask)
 {
 #if defined(CONFIG_SMP) && defined(CONFIG_SCHED_IPI_SUPPORTED)
 	if (arch_num_cpus() > 1) {
-		_kernel.pending_ipi = true;
+		atomic_or(&_kernel.pending_ipi, ipi_mask);
 	}
 #endif
 }
 
-static void ready_thread(struct k_thread *thread)
+/* Queues a thread without refreshing the cache or raising IPIs,
+ * accumulating the CPUs to interrupt into @a ipi_mask instead, so that
+ * callers readying several threads make one decision at the end.
+ * Returns true if the thread was added to the run queue.
+ */
+static bool ready_thread_deferred(struct k_thread *thread, uint32_t *ipi_mask)
 {
 #ifdef CONFIG_KERNEL_COHERENCE
 	__ASSERT_NO_MSG(arch_mem_coherent(thread));
@@ -626,9 +772,25 @@ static void ready_thread(struct k_thread *thread)
 	if (!z_is_thread_queued(thread) && z_is_thread_ready(thread)) {
 		SYS_PORT_TRACING_OBJ_FUNC(k_thread, sched_ready, thread);
 
+#ifdef CONFIG_SCHED_THREAD_LATENCY
+		/* Zero means not ready, see z_sched_latency_switch() */
+		thread->base.ready_cycles = MAX(k_cycle_get_32(), 1U);
+#endif
 		queue_thread(thread);
+		*ipi_mask |= ipi_mask_create(thread);
+		return true;
+	}
+
+	return false;
+}
+
+static void ready_thread(struct k_thread *thread)
+{
+	uint32_t ipi_mask = 0U;
+
+	if (ready_thread_deferred(thread, &ipi_mask)) {
 		update_cache(0);
-		flag_ipi();
+		flag_ipi(ipi_mask);
 	}
 }
 
@@ -916,6 +1078,7 @@ bool z_set_prio(struct k_thread *thread, int prio)
 				thread->base.prio = prio;
 			}
 			update_cache(1);
+			flag_ipi(ipi_mask_create(thread));
 		} else {
 			thread->base.prio = prio;
 		}
@@ -930,8 +1093,6 @@ void z_thread_priority_set(struct k_thread *thread, int prio)
 {
 	bool need_sched = z_set_prio(thread, prio);
 
-	flag_ipi();
-
 	if (need_sched && _current->base.sched_locked == 0U) {
 		z_reschedule_unlocked();
 	}
@@ -1091,6 +1252,7 @@ void *z_get_next_switch_handle(void *interrupted)
 			arch_cohere_stacks(old_thread, interrupted, new_thread);
 
 			_current_cpu->swap_ok = 0;
+			new_thread->base.cpu = arch_curr_cpu()->id;
 			set_current(new_thread);
 
 #ifdef CONFIG_TIMESLICING
@@ -1259,6 +1421,66 @@ struct k_thread *z_priq_mq_best(struct _priq_mq *pq)
 	return thread;
 }
 
+#ifdef CONFIG_SCHED_BITMAP
+void z_priq_bitmap_add(struct _priq_bitmap *pq, struct k_thread *thread)
+{
+	int level = thread->base.prio - K_HIGHEST_THREAD_PRIO;
+	sys_dlist_t *l = &pq->queues[level];
+	sys_dnode_t *n;
+	struct k_thread *t;
+
+	__ASSERT_NO_MSG(!z_is_idle_thread_object(thread));
+
+	/* Everything in a list shares a priority, so only deadlines
+	 * can order them.  Check the tail first: without deadlines
+	 * (or when they are assigned in increasing order) that is
+	 * where every thread lands.
+	 */
+	n = sys_dlist_peek_tail(l);
+	if (n == NULL ||
+	    z_sched_prio_cmp(thread, CONTAINER_OF(n, struct k_thread,
+						  base.qnode_dlist)) <= 0) {
+		sys_dlist_append(l, &thread->base.qnode_dlist);
+	} else {
+		SYS_DLIST_FOR_EACH_CONTAINER(l, t, base.qnode_dlist) {
+			if (z_sched_prio_cmp(thread, t) > 0) {
+				sys_dlist_insert(&t->base.qnode_dlist,
+						 &thread->base.qnode_dlist);
+				break;
+			}
+		}
+	}
+
+	pq->bitmask[level / 32] |= BIT(level % 32);
+}
+
+void z_priq_bitmap_remove(struct _priq_bitmap *pq, struct k_thread *thread)
+{
+	int level = thread->base.prio - K_HIGHEST_THREAD_PRIO;
+
+	__ASSERT_NO_MSG(!z_is_idle_thread_object(thread));
+
+	sys_dlist_remove(&thread->base.qnode_dlist);
+	if (sys_dlist_is_empty(&pq->queues[level])) {
+		pq->bitmask[level / 32] &= ~BIT(level % 32);
+	}
+}
+
+struct k_thread *z_priq_bitmap_best(struct _priq_bitmap *pq)
+{
+	for (int i = 0; i < ARRAY_SIZE(pq->bitmask); i++) {
+		if (pq->bitmask[i] != 0U) {
+			int level = i * 32 + u32_count_trailing_zeros(pq->bitmask[i]);
+			sys_dnode_t *n = sys_dlist_peek_head(&pq->queues[level]);
+
+			return CONTAINER_OF(n, struct k_thread, base.qnode_dlist);
+		}
+	}
+
+	return NULL;
+}
+#endif
+
 int z_unpend_all(_wait_q_t *wait_q)
 {
 	int need_sched = 0;
@@ -1285,6 +1507,13 @@ void init_ready_q(struct _ready_q *rq)
 	for (int i = 0; i < ARRAY_SIZE(_kernel.ready_q.runq.queues); i++) {
 		sys_dlist_init(&rq->runq.queues[i]);
 	}
+#elif defined(CONFIG_SCHED_BITMAP)
+	for (int i = 0; i < ARRAY_SIZE(rq->runq.queues); i++) {
+		sys_dlist_init(&rq->runq.queues[i]);
+	}
+	for (int i = 0; i < ARRAY_SIZE(rq->runq.bitmask); i++) {
+		rq->runq.bitmask[i] = 0U;
+	}
 #else
 	sys_dlist_init(&rq->runq);
 #endif
@@ -1292,7 +1521,7 @@ void init_ready_q(struct _ready_q *rq)
 
 void z_sched_init(void)
 {
-#ifdef CONFIG_SCHED_CPU_MASK_PIN_ONLY
+#if defined(CONFIG_SCHED_CPU_MASK_PIN_ONLY) || defined(CONFIG_SCHED_CPU_RUNQ)
 	unsigned int num_cpus = arch_num_cpus();
 
 	for (int i = 0; i < num_cpus; i++) {
@@ -1532,8 +1761,6 @@ void z_impl_k_wakeup(k_tid_t thread)
 	z_mark_thread_as_not_suspended(thread);
 	z_ready_thread(thread);
 
-	flag_ipi();
-
 	if (!arch_is_in_isr()) {
 		z_reschedule_unlocked();
 	}
@@ -1753,8 +1980,12 @@ void z_thread_abort(struct k_thread *thread)
 		/* We're going to spin, so need a true synchronous IPI
 		 * here, not deferred!
 		 */
-#ifdef CONFIG_SCHED_IPI_SUPPORTED
+#ifdef CONFIG_SCHED_IPI_TARGETED
+		arch_sched_directed_ipi(BIT(thread->base.cpu));
+		count_ipis(BIT(thread->base.cpu));
+#elif defined(CONFIG_SCHED_IPI_SUPPORTED)
 		arch_sched_ipi();
+		count_ipis(BIT_MASK(arch_num_cpus()));
 #endif
 	}
 
@@ -1901,6 +2132,54 @@ bool z_sched_wake(_wait_q_t *wait_q, int swap_retval, void *swap_data)
 	return ret;
 }
 
+int z_sched_wake_filtered(_wait_q_t *wait_q, int max,
+			  bool (*filter)(struct k_thread *thread, void *arg),
+			  void *arg, int swap_retval, void *swap_data)
+{
+	struct k_thread *thread, *head = NULL, **tail = &head;
+	uint32_t ipi_mask = 0U;
+	bool queued = false;
+	int woken = 0;
+
+	LOCKED(&sched_spinlock) {
+		/* Threads cannot be unpended from within the iteration, so
+		 * chain the selected ones first.  Their swap_data is about
+		 * to be overwritten anyway and serves as the link.
+		 */
+		_WAIT_Q_FOR_EACH(wait_q, thread) {
+			if (woken == max) {
+				break;
+			}
+			if ((filter != NULL) && !filter(thread, arg)) {
+				continue;
+			}
+			thread->base.swap_data = NULL;
+			*tail = thread;
+			tail = (struct k_thread **)&thread->base.swap_data;
+			woken++;
+		}
+
+		while (head != NULL) {
+			thread = head;
+			head = thread->base.swap_data;
+
+			z_thread_return_value_set_with_data(thread,
+							    swap_retval,
+							    swap_data);
+			unpend_thread_no_timeout(thread);
+			(void)z_abort_thread_timeout(thread);
+			queued |= ready_thread_deferred(thread, &ipi_mask);
+		}
+
+		if (queued) {
+			update_cache(0);
+			flag_ipi(ipi_mask);
+		}
+	}
+
+	return woken;
+}
+
 int z_sched_wait(struct k_spinlock *lock, k_spinlock_key_t key,
 		 _wait_q_t *wait_q, k_timeout_t timeout, void **data)
 {
@@ -1911,3 +2190,32 @@ int z_sched_wait(struct k_spinlock *lock, k_spinlock_key_t key,
 	}
 	return ret;
 }
+
+#ifdef CONFIG_SCHED_THREAD_LATENCY
+int k_thread_latency_stats_get(k_tid_t thread,
+			       k_thread_latency_stats_t *stats)
+{
+	if ((thread == NULL) || (stats == NULL)) {
+		return -EINVAL;
+	}
+
+	LOCKED(&sched_spinlock) {
+		*stats = thread->base.latency;
+	}
+
+	return 0;
+}
+
+int k_thread_latency_stats_reset(k_tid_t thread)
+{
+	if (thread == NULL) {
+		return -EINVAL;
+	}
+
+	LOCKED(&sched_spinlock) {
+		thread->base.latency = (k_thread_latency_stats_t) {};
+	}
+
+	return 0;
+}
+#endif /* CONFIG_SCHED_THREAD_LATENCY */
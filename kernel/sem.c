@@ -114,6 +114,35 @@ static inline void z_vrfy_k_sem_give(struct k_sem *sem)
 #include <syscalls/k_sem_give_mrsh.c>
 #endif
 
+void z_impl_k_sem_give_n(struct k_sem *sem, unsigned int n)
+{
+	k_spinlock_key_t key = k_spin_lock(&lock);
+	unsigned int woken;
+
+	SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_sem, give, sem);
+
+	woken = z_sched_wake_n(&sem->wait_q, MIN(n, (unsigned int)INT_MAX),
+			       0, NULL);
+
+	if (woken < n) {
+		sem->count += MIN(n - woken, sem->limit - sem->count);
+		handle_poll_events(sem);
+	}
+
+	z_reschedule(&lock, key);
+
+	SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_sem, give, sem);
+}
+
+#ifdef CONFIG_USERSPACE
+static inline void z_vrfy_k_sem_give_n(struct k_sem *sem, unsigned int n)
+{
+	Z_OOPS(Z_SYSCALL_OBJ(sem, K_OBJ_SEM));
+	z_impl_k_sem_give_n(sem, n);
+}
+#include <syscalls/k_sem_give_n_mrsh.c>
+#endif
+
 int z_impl_k_sem_take(struct k_sem *sem, k_timeout_t timeout)
 {
 	int ret = 0;
@@ -150,17 +179,9 @@ out:
 
 void z_impl_k_sem_reset(struct k_sem *sem)
 {
-	struct k_thread *thread;
 	k_spinlock_key_t key = k_spin_lock(&lock);
 
-	while (true) {
-		thread = z_unpend_first_thread(&sem->wait_q);
-		if (thread == NULL) {
-			break;
-		}
-		arch_thread_return_value_set(thread, -EAGAIN);
-		z_ready_thread(thread);
-	}
+	(void)z_sched_wake_all(&sem->wait_q, -EAGAIN, NULL);
 	sem->count = 0;
 
 	SYS_PORT_TRACING_OBJ_FUNC(k_sem, reset, sem);
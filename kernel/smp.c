@@ -56,6 +56,11 @@ static inline void local_delay(void)
 	}
 }
 
+__weak void arch_spin_relax(void)
+{
+	arch_nop();
+}
+
 static void wait_for_start_signal(atomic_t *cpu_start_flag)
 {
 	/* Wait for the signal to begin scheduling */
@@ -14,8 +14,18 @@
 #include <zephyr/kernel.h>
 #include <zephyr/init.h>
 
-static K_KERNEL_STACK_DEFINE(sys_work_q_stack,
-			     CONFIG_SYSTEM_WORKQUEUE_STACK_SIZE);
+#if defined(CONFIG_WORK_QUEUE_POOL) && (CONFIG_SYSTEM_WORKQUEUE_THREADS > 1)
+#define SYS_WORK_Q_THREADS CONFIG_SYSTEM_WORKQUEUE_THREADS
+#else
+#define SYS_WORK_Q_THREADS 1
+#endif
+
+static K_KERNEL_STACK_ARRAY_DEFINE(sys_work_q_stacks, SYS_WORK_Q_THREADS,
+				   CONFIG_SYSTEM_WORKQUEUE_STACK_SIZE);
+
+#if SYS_WORK_Q_THREADS > 1
+static struct k_thread sys_work_q_threads[SYS_WORK_Q_THREADS - 1];
+#endif
 
 struct k_work_q k_sys_work_q;
 
@@ -25,12 +35,26 @@ static int k_sys_work_q_init(const struct device *dev)
 	struct k_work_queue_config cfg = {
 		.name = "sysworkq",
 		.no_yield = IS_ENABLED(CONFIG_SYSTEM_WORKQUEUE_NO_YIELD),
+		.pin_cpus = IS_ENABLED(CONFIG_SYSTEM_WORKQUEUE_PIN_CPUS),
 	};
 
+#if SYS_WORK_Q_THREADS > 1
+	k_thread_stack_t *stacks[SYS_WORK_Q_THREADS];
+
+	for (int i = 0; i < SYS_WORK_Q_THREADS; i++) {
+		stacks[i] = sys_work_q_stacks[i];
+	}
+
+	k_work_queue_start_pool(&k_sys_work_q, sys_work_q_threads, stacks,
+				K_KERNEL_STACK_SIZEOF(sys_work_q_stacks[0]),
+				SYS_WORK_Q_THREADS,
+				CONFIG_SYSTEM_WORKQUEUE_PRIORITY, &cfg);
+#else
 	k_work_queue_start(&k_sys_work_q,
-			    sys_work_q_stack,
-			    K_KERNEL_STACK_SIZEOF(sys_work_q_stack),
+			    sys_work_q_stacks[0],
+			    K_KERNEL_STACK_SIZEOF(sys_work_q_stacks[0]),
 			    CONFIG_SYSTEM_WORKQUEUE_PRIORITY, &cfg);
+#endif
 	return 0;
 }
 
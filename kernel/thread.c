@@ -809,6 +809,11 @@ void z_init_thread_base(struct _thread_base *thread_base, int priority,
 	thread_base->slice_expired = NULL;
 #endif
 
+#ifdef CONFIG_SCHED_THREAD_LATENCY
+	thread_base->ready_cycles = 0U;
+	thread_base->latency = (k_thread_latency_stats_t) {};
+#endif
+
 	/* swap_data does not need to be initialized */
 
 	z_init_thread_timeout(thread_base);
@@ -1046,6 +1051,10 @@ void z_thread_mark_switched_in(void)
 	z_sched_usage_start(_current);
 #endif
 
+#if defined(CONFIG_SCHED_THREAD_LATENCY) && !defined(CONFIG_USE_SWITCH)
+	z_sched_latency_switch(_current);
+#endif
+
 #ifdef CONFIG_TRACING
 	SYS_PORT_TRACING_FUNC(k_thread, switched_in);
 #endif
@@ -1057,6 +1066,12 @@ void z_thread_mark_switched_out(void)
 	z_sched_usage_stop();
 #endif
 
+#if defined(CONFIG_IDLE_STATS) && !defined(CONFIG_USE_SWITCH)
+	if (z_is_idle_thread_object(_current)) {
+		z_idle_stats_exit();
+	}
+#endif
+
 #ifdef CONFIG_TRACING
 #ifdef CONFIG_THREAD_LOCAL_STORAGE
 	/* Dummy thread won't have TLS set up to run arbitrary code */
@@ -1113,6 +1128,7 @@ int k_thread_runtime_stats_all_get(k_thread_runtime_stats_t *stats)
 		stats->average_cycles   += tmp_stats.average_cycles;
 #endif
 		stats->idle_cycles      += tmp_stats.idle_cycles;
+		stats->ipi_count        += tmp_stats.ipi_count;
 	}
 #endif
 
@@ -14,8 +14,6 @@
 
 static uint64_t curr_tick;
 
-static sys_dlist_t timeout_list = SYS_DLIST_STATIC_INIT(&timeout_list);
-
 static struct k_spinlock timeout_lock;
 
 #define MAX_WAIT (IS_ENABLED(CONFIG_SYSTEM_CLOCK_SLOPPY_IDLE) \
@@ -36,6 +34,311 @@ static inline int z_vrfy_sys_clock_hw_cycles_per_sec_runtime_get(void)
 #endif /* CONFIG_USERSPACE */
 #endif /* CONFIG_TIMER_READS_ITS_FREQUENCY_AT_RUNTIME */
 
+static int32_t elapsed(void)
+{
+	return announce_remaining == 0 ? sys_clock_elapsed() : 0U;
+}
+
+#ifdef CONFIG_TIMEOUT_QUEUE_WHEEL
+
+/* Hierarchical timing wheel.  Each queued timeout stores its absolute
+ * expiry tick in dticks and sits in exactly one slot: level 0 slots
+ * are one tick wide, each higher level slot spans a full rotation of
+ * the level below.  A timeout lives in the lowest level whose current
+ * rotation contains its expiry, so insertion and removal are O(1).
+ * Whenever curr_tick crosses the start of a higher level slot, that
+ * slot is cascaded down one or more levels.  Timeouts beyond the
+ * range of the top level wait in an unsorted overflow list that is
+ * redistributed each time the top level wraps.
+ */
+#define WHEEL_BITS   5
+#define WHEEL_SLOTS  BIT(WHEEL_BITS)
+#define WHEEL_MASK   (WHEEL_SLOTS - 1)
+#define WHEEL_LEVELS CONFIG_TIMEOUT_WHEEL_LEVELS
+#define WHEEL_RANGE_BITS (WHEEL_BITS * WHEEL_LEVELS)
+
+#ifdef CONFIG_TIMEOUT_64BIT
+typedef uint64_t wheel_ticks_t;
+#else
+typedef uint32_t wheel_ticks_t;
+#endif
+
+static sys_dlist_t wheel[WHEEL_LEVELS][WHEEL_SLOTS];
+
+/* Slots that may be non-empty.  Bits are set on insertion and only
+ * cleared lazily when a scan finds the slot empty, so that
+ * z_abort_timeout() needs no knowledge of where the timeout was.
+ */
+static uint32_t wheel_used[WHEEL_LEVELS];
+
+static sys_dlist_t wheel_overflow = SYS_DLIST_STATIC_INIT(&wheel_overflow);
+
+static bool wheel_initialized;
+
+/* Cached expiry of the earliest timeout, used to decide whether an
+ * insertion needs to reprogram the timer driver.  Aborts leave it
+ * alone, which at worst causes one early (and empty) announcement.
+ */
+static wheel_ticks_t wheel_first;
+static bool wheel_first_valid;
+
+static void wheel_init(void)
+{
+	for (int l = 0; l < WHEEL_LEVELS; l++) {
+		for (int i = 0; i < WHEEL_SLOTS; i++) {
+			sys_dlist_init(&wheel[l][i]);
+		}
+	}
+	wheel_initialized = true;
+}
+
+static inline wheel_ticks_t wheel_delta(const struct _timeout *t)
+{
+	return (wheel_ticks_t)t->dticks - (wheel_ticks_t)curr_tick;
+}
+
+static inline unsigned int wheel_index(wheel_ticks_t ticks, int level)
+{
+	return (ticks >> (WHEEL_BITS * level)) & WHEEL_MASK;
+}
+
+/* Tick offset of curr_tick within the current slot of a level */
+static inline wheel_ticks_t wheel_offset(int level)
+{
+	return (wheel_ticks_t)curr_tick & (BIT64(WHEEL_BITS * level) - 1);
+}
+
+static void wheel_place(struct _timeout *to)
+{
+	wheel_ticks_t exp = (wheel_ticks_t)to->dticks;
+	wheel_ticks_t diff = exp ^ (wheel_ticks_t)curr_tick;
+
+	for (int l = 0; l < WHEEL_LEVELS; l++) {
+		if ((diff >> (WHEEL_BITS * (l + 1))) == 0) {
+			unsigned int i = wheel_index(exp, l);
+
+			sys_dlist_append(&wheel[l][i], &to->node);
+			wheel_used[l] |= BIT(i);
+			return;
+		}
+	}
+
+	sys_dlist_append(&wheel_overflow, &to->node);
+}
+
+/* Returns the first possibly-occupied slot of a level after the
+ * current one, or -1.  Stale bits found along the way are cleared.
+ */
+static int wheel_next_slot(int level)
+{
+	unsigned int cur = wheel_index(curr_tick, level);
+	uint32_t later = (cur == WHEEL_MASK) ? 0 :
+		wheel_used[level] & ~(BIT(cur + 1) - 1);
+
+	while (later != 0) {
+		int i = find_lsb_set(later) - 1;
+
+		if (!sys_dlist_is_empty(&wheel[level][i])) {
+			return i;
+		}
+		wheel_used[level] &= ~BIT(i);
+		later &= ~BIT(i);
+	}
+
+	return -1;
+}
+
+/* Ticks until the wheel next needs servicing: a level 0 slot to
+ * expire, or a higher level slot or the overflow list to cascade.
+ * Returns false when no timeouts are queued.
+ */
+static bool wheel_next_event(wheel_ticks_t *delta)
+{
+	unsigned int cur;
+	int i;
+
+	for (int l = 0; l < WHEEL_LEVELS; l++) {
+		i = wheel_next_slot(l);
+		if (i >= 0) {
+			cur = wheel_index(curr_tick, l);
+			*delta = ((wheel_ticks_t)(i - cur) << (WHEEL_BITS * l))
+				 - wheel_offset(l);
+			return true;
+		}
+	}
+
+	if (!sys_dlist_is_empty(&wheel_overflow)) {
+		*delta = BIT64(WHEEL_RANGE_BITS) - wheel_offset(WHEEL_LEVELS);
+		return true;
+	}
+
+	return false;
+}
+
+/* Exact ticks until the earliest queued expiry.  Levels never
+ * overlap in time, so only the first occupied slot (or the overflow
+ * list) needs to be searched.
+ */
+static bool wheel_first_delta(wheel_ticks_t *delta)
+{
+	sys_dlist_t *list = &wheel_overflow;
+	struct _timeout *t;
+	bool found = false;
+	int i;
+
+	for (int l = 0; l < WHEEL_LEVELS; l++) {
+		i = wheel_next_slot(l);
+		if (i >= 0) {
+			list = &wheel[l][i];
+			break;
+		}
+	}
+
+	SYS_DLIST_FOR_EACH_CONTAINER(list, t, node) {
+		if (!found || wheel_delta(t) < *delta) {
+			*delta = wheel_delta(t);
+			found = true;
+		}
+	}
+
+	wheel_first_valid = found;
+	if (found) {
+		wheel_first = (wheel_ticks_t)curr_tick + *delta;
+	}
+
+	return found;
+}
+
+static void wheel_move(sys_dlist_t *list)
+{
+	sys_dnode_t *node;
+
+	while ((node = sys_dlist_get(list)) != NULL) {
+		wheel_place(CONTAINER_OF(node, struct _timeout, node));
+	}
+}
+
+/* Called with curr_tick just advanced onto a slot boundary: pull down
+ * every higher level slot that begins at this tick, top level first
+ * so entries can fall through several levels in one pass.
+ */
+static void wheel_cascade(void)
+{
+	if (wheel_offset(WHEEL_LEVELS) == 0 &&
+	    !sys_dlist_is_empty(&wheel_overflow)) {
+		sys_dlist_t far;
+		sys_dnode_t *node;
+
+		/* Entries still out of range go straight back to the
+		 * overflow list, so drain a private copy of it.
+		 */
+		sys_dlist_init(&far);
+		while ((node = sys_dlist_get(&wheel_overflow)) != NULL) {
+			sys_dlist_append(&far, node);
+		}
+		wheel_move(&far);
+	}
+
+	for (int l = WHEEL_LEVELS - 1; l > 0; l--) {
+		unsigned int i = wheel_index(curr_tick, l);
+
+		if (wheel_offset(l) == 0 && (wheel_used[l] & BIT(i)) != 0U) {
+			wheel_used[l] &= ~BIT(i);
+			wheel_move(&wheel[l][i]);
+		}
+	}
+}
+
+/* Queues a timeout whose dticks holds its delay from curr_tick,
+ * returning true if it became the earliest one.
+ */
+static bool timeout_insert(struct _timeout *to)
+{
+	wheel_ticks_t delta = MAX(1, to->dticks);
+	bool is_first;
+
+	if (!wheel_initialized) {
+		wheel_init();
+	}
+
+	to->dticks = (wheel_ticks_t)curr_tick + delta;
+	wheel_place(to);
+
+	is_first = !wheel_first_valid ||
+		   delta < (wheel_ticks_t)(wheel_first - (wheel_ticks_t)curr_tick);
+	if (is_first) {
+		wheel_first = (wheel_ticks_t)to->dticks;
+		wheel_first_valid = true;
+	}
+
+	return is_first;
+}
+
+static void remove_timeout(struct _timeout *t)
+{
+	sys_dlist_remove(&t->node);
+}
+
+static bool first_dticks(k_ticks_t *dticks)
+{
+	wheel_ticks_t delta;
+
+	if (!wheel_first_delta(&delta)) {
+		return false;
+	}
+
+	*dticks = (k_ticks_t)delta;
+	return true;
+}
+
+/* must be locked */
+static k_ticks_t timeout_rem(const struct _timeout *timeout)
+{
+	if (z_is_inactive_timeout(timeout)) {
+		return 0;
+	}
+
+	return (k_ticks_t)wheel_delta(timeout) - elapsed();
+}
+
+/* Expires everything due within announce_remaining ticks, jumping
+ * straight from one occupied slot to the next.
+ */
+static void announce_timeouts(k_spinlock_key_t *key)
+{
+	wheel_ticks_t dt;
+
+	while (wheel_next_event(&dt) &&
+	       dt <= (wheel_ticks_t)announce_remaining) {
+		sys_dlist_t *slot;
+		sys_dnode_t *node;
+
+		curr_tick += dt;
+		wheel_cascade();
+
+		slot = &wheel[0][wheel_index(curr_tick, 0)];
+		while ((node = sys_dlist_get(slot)) != NULL) {
+			struct _timeout *t = CONTAINER_OF(node, struct _timeout, node);
+
+			t->dticks = 0;
+#ifdef CONFIG_IDLE_STATS
+			z_idle_stats_wakeup(t);
+#endif
+			k_spin_unlock(&timeout_lock, *key);
+			t->fn(t);
+			*key = k_spin_lock(&timeout_lock);
+		}
+
+		announce_remaining -= dt;
+	}
+
+	curr_tick += announce_remaining;
+}
+
+#else
+
+static sys_dlist_t timeout_list = SYS_DLIST_STATIC_INIT(&timeout_list);
+
 static struct _timeout *first(void)
 {
 	sys_dnode_t *t = sys_dlist_peek_head(&timeout_list);
@@ -50,6 +353,29 @@ static struct _timeout *next(struct _timeout *t)
 	return n == NULL ? NULL : CONTAINER_OF(n, struct _timeout, node);
 }
 
+/* Queues a timeout whose dticks holds its delay from curr_tick,
+ * returning true if it became the earliest one.
+ */
+static bool timeout_insert(struct _timeout *to)
+{
+	struct _timeout *t;
+
+	for (t = first(); t != NULL; t = next(t)) {
+		if (t->dticks > to->dticks) {
+			t->dticks -= to->dticks;
+			sys_dlist_insert(&t->node, &to->node);
+			break;
+		}
+		to->dticks -= t->dticks;
+	}
+
+	if (t == NULL) {
+		sys_dlist_append(&timeout_list, &to->node);
+	}
+
+	return to == first();
+}
+
 static void remove_timeout(struct _timeout *t)
 {
 	if (next(t) != NULL) {
@@ -59,22 +385,76 @@ static void remove_timeout(struct _timeout *t)
 	sys_dlist_remove(&t->node);
 }
 
-static int32_t elapsed(void)
+static bool first_dticks(k_ticks_t *dticks)
 {
-	return announce_remaining == 0 ? sys_clock_elapsed() : 0U;
+	struct _timeout *to = first();
+
+	if (to == NULL) {
+		return false;
+	}
+
+	*dticks = to->dticks;
+	return true;
+}
+
+/* must be locked */
+static k_ticks_t timeout_rem(const struct _timeout *timeout)
+{
+	k_ticks_t ticks = 0;
+
+	if (z_is_inactive_timeout(timeout)) {
+		return 0;
+	}
+
+	for (struct _timeout *t = first(); t != NULL; t = next(t)) {
+		ticks += t->dticks;
+		if (timeout == t) {
+			break;
+		}
+	}
+
+	return ticks - elapsed();
+}
+
+static void announce_timeouts(k_spinlock_key_t *key)
+{
+	while (first() != NULL && first()->dticks <= announce_remaining) {
+		struct _timeout *t = first();
+		int dt = t->dticks;
+
+		curr_tick += dt;
+		t->dticks = 0;
+		remove_timeout(t);
+#ifdef CONFIG_IDLE_STATS
+		z_idle_stats_wakeup(t);
+#endif
+
+		k_spin_unlock(&timeout_lock, *key);
+		t->fn(t);
+		*key = k_spin_lock(&timeout_lock);
+		announce_remaining -= dt;
+	}
+
+	if (first() != NULL) {
+		first()->dticks -= announce_remaining;
+	}
+
+	curr_tick += announce_remaining;
 }
 
+#endif /* CONFIG_TIMEOUT_QUEUE_WHEEL */
+
 static int32_t next_timeout(void)
 {
-	struct _timeout *to = first();
+	k_ticks_t dticks;
 	int32_t ticks_elapsed = elapsed();
 	int32_t ret;
 
-	if ((to == NULL) ||
-	    ((int64_t)(to->dticks - ticks_elapsed) > (int64_t)INT_MAX)) {
+	if (!first_dticks(&dticks) ||
+	    ((int64_t)(dticks - ticks_elapsed) > (int64_t)INT_MAX)) {
 		ret = MAX_WAIT;
 	} else {
-		ret = MAX(0, to->dticks - ticks_elapsed);
+		ret = MAX(0, dticks - ticks_elapsed);
 	}
 
 #ifdef CONFIG_TIMESLICING
@@ -100,8 +480,6 @@ void z_add_timeout(struct _timeout *to, _timeout_func_t fn,
 	to->fn = fn;
 
 	LOCKED(&timeout_lock) {
-		struct _timeout *t;
-
 		if (IS_ENABLED(CONFIG_TIMEOUT_64BIT) &&
 		    Z_TICK_ABS(timeout.ticks) >= 0) {
 			k_ticks_t ticks = Z_TICK_ABS(timeout.ticks) - curr_tick;
@@ -111,20 +489,7 @@ void z_add_timeout(struct _timeout *to, _timeout_func_t fn,
 			to->dticks = timeout.ticks + 1 + elapsed();
 		}
 
-		for (t = first(); t != NULL; t = next(t)) {
-			if (t->dticks > to->dticks) {
-				t->dticks -= to->dticks;
-				sys_dlist_insert(&t->node, &to->node);
-				break;
-			}
-			to->dticks -= t->dticks;
-		}
-
-		if (t == NULL) {
-			sys_dlist_append(&timeout_list, &to->node);
-		}
-
-		if (to == first()) {
+		if (timeout_insert(to)) {
 #if CONFIG_TIMESLICING
 			/*
 			 * This is not ideal, since it does not
@@ -161,25 +526,6 @@ int z_abort_timeout(struct _timeout *to)
 	return ret;
 }
 
-/* must be locked */
-static k_ticks_t timeout_rem(const struct _timeout *timeout)
-{
-	k_ticks_t ticks = 0;
-
-	if (z_is_inactive_timeout(timeout)) {
-		return 0;
-	}
-
-	for (struct _timeout *t = first(); t != NULL; t = next(t)) {
-		ticks += t->dticks;
-		if (timeout == t) {
-			break;
-		}
-	}
-
-	return ticks - elapsed();
-}
-
 k_ticks_t z_timeout_remaining(const struct _timeout *timeout)
 {
 	k_ticks_t ticks = 0;
@@ -258,27 +604,15 @@ void sys_clock_announce(int32_t ticks)
 
 	announce_remaining = ticks;
 
-	while (first() != NULL && first()->dticks <= announce_remaining) {
-		struct _timeout *t = first();
-		int dt = t->dticks;
-
-		curr_tick += dt;
-		t->dticks = 0;
-		remove_timeout(t);
-
-		k_spin_unlock(&timeout_lock, key);
-		t->fn(t);
-		key = k_spin_lock(&timeout_lock);
-		announce_remaining -= dt;
-	}
+	announce_timeouts(&key);
 
-	if (first() != NULL) {
-		first()->dticks -= announce_remaining;
-	}
-
-	curr_tick += announce_remaining;
 	announce_remaining = 0;
 
+#ifdef CONFIG_IDLE_STATS
+	/* Woken up by a timer interrupt which expired nothing */
+	z_idle_stats_wakeup(NULL);
+#endif
+
 	sys_clock_set_timeout(next_timeout(), false);
 
 	k_spin_unlock(&timeout_lock, key);
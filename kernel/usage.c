@@ -166,6 +166,12 @@ void z_sched_cpu_usage(uint8_t cpu_id, struct k_thread_runtime_stats *stats)
 
 	stats->execution_cycles = stats->total_cycles + stats->idle_cycles;
 
+#ifdef CONFIG_SMP
+	stats->ipi_count = _kernel.cpus[cpu_id].ipi_count;
+#else
+	stats->ipi_count = 0;
+#endif
+
 	k_spin_unlock(&usage_lock, key);
 }
 #endif
@@ -219,6 +225,7 @@ void z_sched_thread_usage(struct k_thread *thread,
 
 #ifdef CONFIG_SCHED_THREAD_USAGE_ALL
 	stats->idle_cycles = 0;
+	stats->ipi_count = 0;
 #endif
 	stats->execution_cycles = thread->base.usage.total;
 
@@ -47,7 +47,7 @@ LOG_MODULE_DECLARE(os, CONFIG_KERNEL_LOG_LEVEL);
  * not.
  */
 #ifdef CONFIG_DYNAMIC_OBJECTS
-static struct k_spinlock lists_lock;       /* kobj rbtree/dlist */
+static struct k_spinlock lists_lock;       /* kobj index */
 static struct k_spinlock objfree_lock;     /* k_object_free */
 #endif
 static struct k_spinlock obj_lock;         /* kobj struct data */
@@ -135,8 +135,12 @@ uint8_t *z_priv_stack_find(k_thread_stack_t *stack)
 
 struct dyn_obj {
 	struct z_object kobj;
+#ifdef CONFIG_DYNAMIC_OBJECTS_HASH
+	sys_snode_t hash_node;
+#else
 	sys_dnode_t dobj_list;
 	struct rbnode node; /* must be immediately before data member */
+#endif
 
 	/* The object itself */
 	uint8_t data[] __aligned(DYN_OBJ_DATA_ALIGN_K_THREAD);
@@ -146,6 +150,14 @@ extern struct z_object *z_object_gperf_find(const void *obj);
 extern void z_object_gperf_wordlist_foreach(_wordlist_cb_func_t func,
 					     void *context);
 
+#ifdef CONFIG_DYNAMIC_OBJECTS_HASH
+/*
+ * Hash table of allocated kernel objects, chained through hash_node, for
+ * constant time lookups based on object pointer values. Iterating over
+ * all the buckets visits all allocated objects.
+ */
+static sys_slist_t obj_hash[CONFIG_DYNAMIC_OBJECTS_HASH_BUCKETS];
+#else
 static bool node_lessthan(struct rbnode *a, struct rbnode *b);
 
 /*
@@ -161,11 +173,7 @@ static struct rbtree obj_rb_tree = {
  * objects (and potentially deleting them during iteration).
  */
 static sys_dlist_t obj_list = SYS_DLIST_STATIC_INIT(&obj_list);
-
-/*
- * TODO: Write some hash table code that will replace both obj_rb_tree
- * and obj_list.
- */
+#endif /* CONFIG_DYNAMIC_OBJECTS_HASH */
 
 static size_t obj_size_get(enum k_objects otype)
 {
@@ -201,44 +209,86 @@ static size_t obj_align_get(enum k_objects otype)
 	return ret;
 }
 
+#ifdef CONFIG_DYNAMIC_OBJECTS_HASH
+static sys_slist_t *dyn_obj_bucket(struct dyn_obj *dobj)
+{
+	/* Heap pointers share their low bits, scramble the others with
+	 * a multiplicative (Fibonacci) hash and keep the upper half.
+	 */
+	uint32_t hash = (uint32_t)((uintptr_t)dobj / __alignof(struct dyn_obj));
+
+	hash = (hash * 2654435761U) >> 16;
+
+	return &obj_hash[hash % CONFIG_DYNAMIC_OBJECTS_HASH_BUCKETS];
+}
+
+/* Called with lists_lock held */
+static void dyn_obj_insert(struct dyn_obj *dobj)
+{
+	sys_slist_prepend(dyn_obj_bucket(dobj), &dobj->hash_node);
+}
+
+static void dyn_obj_remove(struct dyn_obj *dobj)
+{
+	(void)sys_slist_find_and_remove(dyn_obj_bucket(dobj),
+					&dobj->hash_node);
+}
+
+static bool dyn_obj_contains(struct dyn_obj *dobj)
+{
+	sys_snode_t *node;
+
+	SYS_SLIST_FOR_EACH_NODE(dyn_obj_bucket(dobj), node) {
+		if (node == &dobj->hash_node) {
+			return true;
+		}
+	}
+
+	return false;
+}
+#else
 static bool node_lessthan(struct rbnode *a, struct rbnode *b)
 {
 	return a < b;
 }
 
-static inline struct dyn_obj *node_to_dyn_obj(struct rbnode *node)
+/* Called with lists_lock held */
+static void dyn_obj_insert(struct dyn_obj *dobj)
 {
-	return CONTAINER_OF(node, struct dyn_obj, node);
+	rb_insert(&obj_rb_tree, &dobj->node);
+	sys_dlist_append(&obj_list, &dobj->dobj_list);
 }
 
-static inline struct rbnode *dyn_obj_to_node(void *obj)
+static void dyn_obj_remove(struct dyn_obj *dobj)
 {
-	struct dyn_obj *dobj = CONTAINER_OF(obj, struct dyn_obj, data);
+	rb_remove(&obj_rb_tree, &dobj->node);
+	sys_dlist_remove(&dobj->dobj_list);
+}
 
-	return &dobj->node;
+static bool dyn_obj_contains(struct dyn_obj *dobj)
+{
+	return rb_contains(&obj_rb_tree, &dobj->node);
 }
+#endif /* CONFIG_DYNAMIC_OBJECTS_HASH */
 
 static struct dyn_obj *dyn_object_find(void *obj)
 {
-	struct rbnode *node;
-	struct dyn_obj *ret;
+	struct dyn_obj *dobj;
 
 	/* For any dynamically allocated kernel object, the object
 	 * pointer is just a member of the containing struct dyn_obj,
-	 * so just a little arithmetic is necessary to locate the
-	 * corresponding struct rbnode
+	 * so just a little arithmetic is necessary to locate it. It
+	 * is only dereferenced once found in the index.
 	 */
-	node = dyn_obj_to_node(obj);
+	dobj = CONTAINER_OF(obj, struct dyn_obj, data);
 
 	k_spinlock_key_t key = k_spin_lock(&lists_lock);
-	if (rb_contains(&obj_rb_tree, node)) {
-		ret = node_to_dyn_obj(node);
-	} else {
-		ret = NULL;
+	if (!dyn_obj_contains(dobj)) {
+		dobj = NULL;
 	}
 	k_spin_unlock(&lists_lock, key);
 
-	return ret;
+	return dobj;
 }
 
 /**
@@ -321,8 +371,7 @@ struct z_object *z_dynamic_object_aligned_create(size_t align, size_t size)
 
 	k_spinlock_key_t key = k_spin_lock(&lists_lock);
 
-	rb_insert(&obj_rb_tree, &dyn->node);
-	sys_dlist_append(&obj_list, &dyn->dobj_list);
+	dyn_obj_insert(dyn);
 	k_spin_unlock(&lists_lock, key);
 
 	return &dyn->kobj;
@@ -398,8 +447,7 @@ void k_object_free(void *obj)
 
 	dyn = dyn_object_find(obj);
 	if (dyn != NULL) {
-		rb_remove(&obj_rb_tree, &dyn->node);
-		sys_dlist_remove(&dyn->dobj_list);
+		dyn_obj_remove(dyn);
 
 		if (dyn->kobj.type == K_OBJ_THREAD) {
 			thread_idx_free(dyn->kobj.data.thread_id);
@@ -442,9 +490,18 @@ void z_object_wordlist_foreach(_wordlist_cb_func_t func, void *context)
 
 	k_spinlock_key_t key = k_spin_lock(&lists_lock);
 
+#ifdef CONFIG_DYNAMIC_OBJECTS_HASH
+	for (int i = 0; i < CONFIG_DYNAMIC_OBJECTS_HASH_BUCKETS; i++) {
+		SYS_SLIST_FOR_EACH_CONTAINER_SAFE(&obj_hash[i], obj, next,
+						  hash_node) {
+			func(&obj->kobj, context);
+		}
+	}
+#else
 	SYS_DLIST_FOR_EACH_CONTAINER_SAFE(&obj_list, obj, next, dobj_list) {
 		func(&obj->kobj, context);
 	}
+#endif
 	k_spin_unlock(&lists_lock, key);
 }
 #endif /* CONFIG_DYNAMIC_OBJECTS */
@@ -508,8 +565,7 @@ static void unref_check(struct z_object *ko, uintptr_t index)
 		break;
 	}
 
-	rb_remove(&obj_rb_tree, &dyn->node);
-	sys_dlist_remove(&dyn->dobj_list);
+	dyn_obj_remove(dyn);
 	k_free(dyn);
 out:
 #endif
@@ -184,6 +184,9 @@ static void queue_flusher_locked(struct k_work_q *queue,
 	}
 
 	init_flusher(flusher);
+#ifdef CONFIG_WORK_QUEUE_POOL
+	flusher->target = work;
+#endif
 	if (in_list) {
 		sys_slist_insert(&queue->pending, &work->node,
 				 &flusher->work.node);
@@ -207,6 +210,26 @@ static inline void queue_remove_locked(struct k_work_q *queue,
 	}
 }
 
+/* Test whether the current thread is one of the queue threads.
+ *
+ * @param queue the queue to check
+ */
+static inline bool is_queue_thread(struct k_work_q *queue)
+{
+	if (_current == &queue->thread) {
+		return true;
+	}
+
+#ifdef CONFIG_WORK_QUEUE_POOL
+	if ((queue->pool != NULL) && (_current >= queue->pool) &&
+	    (_current < &queue->pool[queue->pool_size])) {
+		return true;
+	}
+#endif
+
+	return false;
+}
+
 /* Potentially notify a queue that it needs to look for pending work.
  *
  * This may make the work queue thread ready, but as the lock is held it
@@ -256,7 +279,7 @@ static inline int queue_submit_locked(struct k_work_q *queue,
 	}
 
 	int ret = -EBUSY;
-	bool chained = (_current == &queue->thread) && !k_is_in_isr();
+	bool chained = is_queue_thread(queue) && !k_is_in_isr();
 	bool draining = flag_test(&queue->flags, K_WORK_QUEUE_DRAIN_BIT);
 	bool plugged = flag_test(&queue->flags, K_WORK_QUEUE_PLUGGED_BIT);
 
@@ -592,6 +615,62 @@ bool k_work_cancel_sync(struct k_work *work,
 	return pending;
 }
 
+#ifdef CONFIG_WORK_QUEUE_POOL
+/* Test whether a pending work item can be run by a pool thread.
+ *
+ * An item resubmitted while it runs must wait for it to complete to
+ * prevent handler re-entrancy, and so must a flusher for an item that is
+ * still running, or it would complete the flush early.
+ *
+ * Invoked with work lock held.
+ *
+ * @param work the pending work item
+ */
+static inline bool work_is_runnable_locked(struct k_work *work)
+{
+	if (work->handler == handle_flush) {
+		struct z_work_flusher *flusher
+			= CONTAINER_OF(work, struct z_work_flusher, work);
+
+		work = flusher->target;
+	}
+
+	return !flag_test(&work->flags, K_WORK_RUNNING_BIT);
+}
+#endif /* CONFIG_WORK_QUEUE_POOL */
+
+/* Take the next work item to be run off the queue.
+ *
+ * Invoked with work lock held.
+ *
+ * @param queue the queue from which work should be taken
+ *
+ * @return the list node of the work item, or null if there is none that
+ * can be run yet.
+ */
+static inline sys_snode_t *queue_get_locked(struct k_work_q *queue)
+{
+#ifdef CONFIG_WORK_QUEUE_POOL
+	if (queue->pool_size != 0U) {
+		sys_snode_t *prev = NULL;
+		struct k_work *work;
+
+		SYS_SLIST_FOR_EACH_CONTAINER(&queue->pending, work, node) {
+			if (work_is_runnable_locked(work)) {
+				sys_slist_remove(&queue->pending, prev,
+						 &work->node);
+				return &work->node;
+			}
+			prev = &work->node;
+		}
+
+		return NULL;
+	}
+#endif
+
+	return sys_slist_get(&queue->pending);
+}
+
 /* Loop executed by a work queue thread.
  *
  * @param workq_ptr pointer to the work queue structure
@@ -608,12 +687,15 @@ static void work_queue_main(void *workq_ptr, void *p2, void *p3)
 		bool yield;
 
 		/* Check for and prepare any new work. */
-		node = sys_slist_get(&queue->pending);
+		node = queue_get_locked(queue);
 		if (node != NULL) {
 			/* Mark that there's some work active that's
 			 * not on the pending list.
 			 */
 			flag_set(&queue->flags, K_WORK_QUEUE_BUSY_BIT);
+#ifdef CONFIG_WORK_QUEUE_POOL
+			queue->running++;
+#endif
 			work = CONTAINER_OF(node, struct k_work, node);
 			flag_set(&work->flags, K_WORK_RUNNING_BIT);
 			flag_clear(&work->flags, K_WORK_QUEUED_BIT);
@@ -631,7 +713,8 @@ static void work_queue_main(void *workq_ptr, void *p2, void *p3)
 			 * This means that if node is not NULL, then work will not be NULL.
 			 */
 			handler = work->handler;
-		} else if (flag_test_and_clear(&queue->flags,
+		} else if (!flag_test(&queue->flags, K_WORK_QUEUE_BUSY_BIT) &&
+			   flag_test_and_clear(&queue->flags,
 					       K_WORK_QUEUE_DRAIN_BIT)) {
 			/* Not busy and draining: move threads waiting for
 			 * drain to ready state.  The held spinlock inhibits
@@ -679,7 +762,13 @@ static void work_queue_main(void *workq_ptr, void *p2, void *p3)
 			finalize_cancel_locked(work);
 		}
 
+#ifdef CONFIG_WORK_QUEUE_POOL
+		if (--queue->running == 0U) {
+			flag_clear(&queue->flags, K_WORK_QUEUE_BUSY_BIT);
+		}
+#else
 		flag_clear(&queue->flags, K_WORK_QUEUE_BUSY_BIT);
+#endif
 		yield = !flag_test(&queue->flags, K_WORK_QUEUE_NO_YIELD_BIT);
 		k_spin_unlock(&lock, key);
 
@@ -703,19 +792,28 @@ void k_work_queue_init(struct k_work_q *queue)
 	SYS_PORT_TRACING_OBJ_INIT(k_work_queue, queue);
 }
 
-void k_work_queue_start(struct k_work_q *queue,
-			k_thread_stack_t *stack,
+/* Start the threads of a work queue.
+ *
+ * @param queue the queue to be started
+ * @param threads the threads besides the queue's own one
+ * @param stacks the stacks of the queue's own thread then of @p threads
+ * @param nthreads the number of threads including the queue's own one
+ */
+static void queue_start(struct k_work_q *queue,
+			struct k_thread *threads,
+			k_thread_stack_t *const *stacks,
 			size_t stack_size,
+			int nthreads,
 			int prio,
 			const struct k_work_queue_config *cfg)
 {
 	__ASSERT_NO_MSG(queue);
-	__ASSERT_NO_MSG(stack);
+	__ASSERT_NO_MSG(stacks);
+	__ASSERT_NO_MSG(nthreads >= 1);
+	__ASSERT_NO_MSG((nthreads == 1) || (threads != NULL));
 	__ASSERT_NO_MSG(!flag_test(&queue->flags, K_WORK_QUEUE_STARTED_BIT));
 	uint32_t flags = K_WORK_QUEUE_STARTED;
 
-	SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_work_queue, start, queue);
-
 	sys_slist_init(&queue->pending);
 	z_waitq_init(&queue->notifyq);
 	z_waitq_init(&queue->drainq);
@@ -730,18 +828,67 @@ void k_work_queue_start(struct k_work_q *queue,
 	 */
 	flags_set(&queue->flags, flags);
 
-	(void)k_thread_create(&queue->thread, stack, stack_size,
-			      work_queue_main, queue, NULL, NULL,
-			      prio, 0, K_FOREVER);
+#ifdef CONFIG_WORK_QUEUE_POOL
+	queue->pool = threads;
+	queue->pool_size = nthreads - 1;
+	queue->running = 0U;
+#endif
+
+	for (int i = 0; i < nthreads; i++) {
+		struct k_thread *thread = (i == 0) ? &queue->thread
+						   : &threads[i - 1];
+
+		(void)k_thread_create(thread, stacks[i], stack_size,
+				      work_queue_main, queue, NULL, NULL,
+				      prio, 0, K_FOREVER);
+
+		if ((cfg != NULL) && (cfg->name != NULL)) {
+			k_thread_name_set(thread, cfg->name);
+		}
+
+#ifdef CONFIG_SCHED_CPU_MASK
+		if ((nthreads > 1) && (cfg != NULL) && cfg->pin_cpus) {
+			(void)k_thread_cpu_pin(thread, i % arch_num_cpus());
+		}
+#endif
+	}
 
-	if ((cfg != NULL) && (cfg->name != NULL)) {
-		k_thread_name_set(&queue->thread, cfg->name);
+	for (int i = 0; i < nthreads; i++) {
+		k_thread_start((i == 0) ? &queue->thread : &threads[i - 1]);
 	}
+}
+
+void k_work_queue_start(struct k_work_q *queue,
+			k_thread_stack_t *stack,
+			size_t stack_size,
+			int prio,
+			const struct k_work_queue_config *cfg)
+{
+	__ASSERT_NO_MSG(stack);
+
+	SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_work_queue, start, queue);
+
+	queue_start(queue, NULL, &stack, stack_size, 1, prio, cfg);
+
+	SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_work_queue, start, queue);
+}
+
+#ifdef CONFIG_WORK_QUEUE_POOL
+void k_work_queue_start_pool(struct k_work_q *queue,
+			     struct k_thread *threads,
+			     k_thread_stack_t *const *stacks,
+			     size_t stack_size,
+			     int nthreads,
+			     int prio,
+			     const struct k_work_queue_config *cfg)
+{
+	SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_work_queue, start, queue);
 
-	k_thread_start(&queue->thread);
+	queue_start(queue, threads, stacks, stack_size, nthreads, prio, cfg);
 
 	SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_work_queue, start, queue);
 }
+#endif /* CONFIG_WORK_QUEUE_POOL */
 
 int k_work_queue_drain(struct k_work_q *queue,
 		       bool plug)
@@ -797,6 +944,143 @@ int k_work_queue_unplug(struct k_work_q *queue)
 
 #ifdef CONFIG_SYS_CLOCK_EXISTS
 
+#ifdef CONFIG_WORK_DELAYABLE_SLACK
+/* Delayable work items with slack whose timeout is armed, and also
+ * expires the items that joined them (their followers).
+ */
+static sys_slist_t coalesce_leaders;
+
+static void work_timeout(struct _timeout *to);
+
+/* Submit the followers of a leader whose timeout expired.
+ *
+ * Invoked with work lock held.
+ *
+ * @param dwork the leader
+ */
+static void coalesce_expire_locked(struct k_work_delayable *dwork)
+{
+	struct k_work_delayable *fw;
+	sys_snode_t *node;
+
+	if (dwork->leader != dwork) {
+		return;
+	}
+
+	(void)sys_slist_find_and_remove(&coalesce_leaders,
+					&dwork->coalesce_node);
+	dwork->leader = NULL;
+
+	while ((node = sys_slist_get(&dwork->followers)) != NULL) {
+		fw = CONTAINER_OF(node, struct k_work_delayable, coalesce_node);
+		fw->leader = NULL;
+
+		if (flag_test_and_clear(&fw->work.flags, K_WORK_DELAYED_BIT)) {
+			struct k_work_q *queue = fw->queue;
+
+			(void)submit_to_queue_locked(&fw->work, &queue);
+		}
+	}
+}
+
+/* Arm the timeout of a delayable work item with slack, or have it join
+ * the timeout of a leader expiring within its slack.
+ *
+ * Invoked with work lock held.
+ *
+ * @param dwork the delayable work structure
+ * @param delay the delay requested before submission
+ */
+static void coalesce_schedule_locked(struct k_work_delayable *dwork,
+				     k_timeout_t delay)
+{
+	/* One more tick, as relative timeouts are rounded up */
+	k_ticks_t end = (k_ticks_t)sys_clock_timeout_end_calc(delay) + 1;
+	struct k_work_delayable *lw;
+
+	SYS_SLIST_FOR_EACH_CONTAINER(&coalesce_leaders, lw, coalesce_node) {
+		k_ticks_t expires = z_timeout_expires(&lw->timeout);
+
+		if ((expires >= end) && (expires - end <= dwork->slack)) {
+			dwork->leader = lw;
+			sys_slist_append(&lw->followers, &dwork->coalesce_node);
+			return;
+		}
+	}
+
+	/* Expire as late as allowed, so that items scheduled next with
+	 * the same delay can join.
+	 */
+#ifdef CONFIG_TIMEOUT_64BIT
+	if (Z_TICK_ABS(delay.ticks) >= 0) {
+		delay = K_TIMEOUT_ABS_TICKS(Z_TICK_ABS(delay.ticks) +
+					    dwork->slack);
+	} else
+#endif
+	{
+		delay = K_TICKS(delay.ticks + dwork->slack);
+	}
+
+	dwork->leader = dwork;
+	sys_slist_init(&dwork->followers);
+	sys_slist_append(&coalesce_leaders, &dwork->coalesce_node);
+	z_add_timeout(&dwork->timeout, work_timeout, delay);
+}
+
+/* Take a delayable work item out of coalescing, handing its timeout over
+ * to one of its followers if it is a leader.
+ *
+ * Invoked with work lock held, before the timeout is aborted.
+ *
+ * @param dwork the delayable work structure
+ */
+static void coalesce_unschedule_locked(struct k_work_delayable *dwork)
+{
+	struct k_work_delayable *lw = dwork->leader;
+	struct k_work_delayable *fw;
+	sys_snode_t *node;
+	k_ticks_t remaining;
+
+	if (lw == NULL) {
+		return;
+	}
+
+	dwork->leader = NULL;
+	if (lw != dwork) {
+		(void)sys_slist_find_and_remove(&lw->followers,
+						&dwork->coalesce_node);
+		return;
+	}
+
+	(void)sys_slist_find_and_remove(&coalesce_leaders,
+					&dwork->coalesce_node);
+
+	node = sys_slist_get(&dwork->followers);
+	if (node == NULL) {
+		return;
+	}
+
+	/* The first follower takes over, expiring at the same time */
+	fw = CONTAINER_OF(node, struct k_work_delayable, coalesce_node);
+	fw->followers = dwork->followers;
+	sys_slist_init(&dwork->followers);
+
+	SYS_SLIST_FOR_EACH_CONTAINER(&fw->followers, lw, coalesce_node) {
+		lw->leader = fw;
+	}
+
+	fw->leader = fw;
+	sys_slist_append(&coalesce_leaders, &fw->coalesce_node);
+
+	/* k_ticks_t is unsigned without CONFIG_TIMEOUT_64BIT, and
+	 * K_TICKS(-1) would be K_FOREVER.
+	 */
+	remaining = z_timeout_remaining(&dwork->timeout);
+	z_add_timeout(&fw->timeout, work_timeout,
+		      K_TICKS((remaining > 0) ? (remaining - 1) : 0));
+}
+#endif /* CONFIG_WORK_DELAYABLE_SLACK */
+
 /* Timeout handler for delayable work.
  *
  * Invoked by timeout infrastructure.
@@ -811,6 +1095,10 @@ static void work_timeout(struct _timeout *to)
 	k_spinlock_key_t key = k_spin_lock(&lock);
 	struct k_work_q *queue = NULL;
 
+#ifdef CONFIG_WORK_DELAYABLE_SLACK
+	coalesce_expire_locked(dw);
+#endif
+
 	/* If the work is still marked delayed (should be) then clear that
 	 * state and submit it to the queue.  If successful the queue will be
 	 * notified of new work at the next reschedule point.
@@ -843,6 +1131,24 @@ void k_work_init_delayable(struct k_work_delayable *dwork,
 	SYS_PORT_TRACING_OBJ_INIT(k_work_delayable, dwork);
 }
 
+#ifdef CONFIG_WORK_DELAYABLE_SLACK
+void k_work_delayable_slack_set(struct k_work_delayable *dwork,
+				k_timeout_t slack)
+{
+	__ASSERT_NO_MSG(dwork != NULL);
+	__ASSERT_NO_MSG(!K_TIMEOUT_EQ(slack, K_FOREVER));
+#ifdef CONFIG_TIMEOUT_64BIT
+	/* Absolute timeouts only exist with 64-bit ticks */
+	__ASSERT_NO_MSG(Z_TICK_ABS(slack.ticks) < 0);
+#endif
+
+	k_spinlock_key_t key = k_spin_lock(&lock);
+
+	dwork->slack = slack.ticks;
+	k_spin_unlock(&lock, key);
+}
+#endif /* CONFIG_WORK_DELAYABLE_SLACK */
+
 static inline int work_delayable_busy_get_locked(const struct k_work_delayable *dwork)
 {
 	return flags_get(&dwork->work.flags) & K_WORK_MASK;
@@ -894,6 +1200,14 @@ static int schedule_for_queue_locked(struct k_work_q **queuep,
 	flag_set(&work->flags, K_WORK_DELAYED_BIT);
 	dwork->queue = *queuep;
 
+#ifdef CONFIG_WORK_DELAYABLE_SLACK
+	/* K_FOREVER is ignored by z_add_timeout(), it can't be late */
+	if ((dwork->slack > 0) && !K_TIMEOUT_EQ(delay, K_FOREVER)) {
+		coalesce_schedule_locked(dwork, delay);
+		return ret;
+	}
+#endif
+
 	/* Add timeout */
 	z_add_timeout(&dwork->timeout, work_timeout, delay);
 
@@ -919,6 +1233,9 @@ static inline bool unschedule_locked(struct k_work_delayable *dwork)
 
 	/* If scheduled, try to cancel. */
 	if (flag_test_and_clear(&work->flags, K_WORK_DELAYED_BIT)) {
+#ifdef CONFIG_WORK_DELAYABLE_SLACK
+		coalesce_unschedule_locked(dwork);
+#endif
 		z_abort_timeout(&dwork->timeout);
 		ret = true;
 	}
@@ -45,6 +45,119 @@ static void setup_bundle_data(sys_bitarray_t *bitarray,
 	}
 }
 
+#ifdef CONFIG_SYS_BITARRAY_SUMMARY
+/* Update the summary bit of a bundle after changing it */
+static void update_summary(sys_bitarray_t *bitarray, size_t idx)
+{
+	if (bitarray->bundles[idx] == ~0U) {
+		bitarray->summary[idx / 32] |= BIT(idx % 32);
+	} else {
+		bitarray->summary[idx / 32] &= ~BIT(idx % 32);
+	}
+}
+
+/* Index of the first bundle at or after idx not known to be all set,
+ * num_bundles or more if there is none.
+ */
+static size_t next_bundle_not_full(sys_bitarray_t *bitarray, size_t idx)
+{
+	size_t num_words = (bitarray->num_bundles + 32 - 1) / 32;
+	size_t word = idx / 32;
+	uint32_t not_full;
+
+	if (word >= num_words) {
+		return bitarray->num_bundles;
+	}
+
+	not_full = ~bitarray->summary[word] & ~(BIT(idx % 32) - 1);
+	while (not_full == 0U) {
+		if (++word == num_words) {
+			return bitarray->num_bundles;
+		}
+
+		not_full = ~bitarray->summary[word];
+	}
+
+	return word * 32 + find_lsb_set(not_full) - 1;
+}
+#else
+static inline void update_summary(sys_bitarray_t *bitarray, size_t idx)
+{
+	ARG_UNUSED(bitarray);
+	ARG_UNUSED(idx);
+}
+
+static inline size_t next_bundle_not_full(sys_bitarray_t *bitarray,
+					  size_t idx)
+{
+	ARG_UNUSED(bitarray);
+
+	return idx;
+}
+#endif /* CONFIG_SYS_BITARRAY_SUMMARY */
+
+/*
+ * Find the first cleared bit at or after a bit, looking at whole
+ * bundles.
+ *
+ * @param bitarray Bitarray struct
+ * @param bit      Starting bit location
+ *
+ * @return Offset of the cleared bit, num_bits or more if there is none.
+ */
+static size_t find_next_clear(sys_bitarray_t *bitarray, size_t bit)
+{
+	size_t idx = bit / bundle_bitness(bitarray);
+	uint32_t bundle;
+
+	if (bit >= bitarray->num_bits) {
+		return bitarray->num_bits;
+	}
+
+	bundle = ~bitarray->bundles[idx] &
+		 ~(BIT(bit % bundle_bitness(bitarray)) - 1);
+	while (bundle == 0U) {
+		idx = next_bundle_not_full(bitarray, idx + 1);
+		if (idx >= bitarray->num_bundles) {
+			return bitarray->num_bits;
+		}
+
+		bundle = ~bitarray->bundles[idx];
+	}
+
+	return idx * bundle_bitness(bitarray) + find_lsb_set(bundle) - 1;
+}
+
+/*
+ * Find the first set bit at or after a bit, looking at whole bundles.
+ *
+ * @param bitarray Bitarray struct
+ * @param bit      Starting bit location
+ * @param limit    Bit location to stop at, at most num_bits
+ *
+ * @return Offset of the set bit, or @p limit if there is none before.
+ */
+static size_t find_next_set(sys_bitarray_t *bitarray, size_t bit,
+			    size_t limit)
+{
+	size_t idx = bit / bundle_bitness(bitarray);
+	uint32_t bundle;
+
+	bundle = bitarray->bundles[idx] &
+		 ~(BIT(bit % bundle_bitness(bitarray)) - 1);
+	while (bundle == 0U) {
+		idx++;
+		if (idx * bundle_bitness(bitarray) >= limit) {
+			return limit;
+		}
+
+		bundle = bitarray->bundles[idx];
+	}
+
+	return MIN(idx * bundle_bitness(bitarray) + find_lsb_set(bundle) - 1,
+		   limit);
+}
+
 /*
  * Find out if the bits in a region is all set or all clear.
  *
@@ -56,22 +169,16 @@ static void setup_bundle_data(sys_bitarray_t *bitarray,
  * @param[out] bd        Data related to matching which can be
  *                       used later to find out where the region
  *                       lies in the bitarray bundles.
- * @param[out] mismatch  Offset to the mismatched bit.
- *                       Can be NULL.
  *
  * @retval     true      If all bits are set or cleared
  * @retval     false     Not all bits are set or cleared
  */
 static bool match_region(sys_bitarray_t *bitarray, size_t offset,
 			 size_t num_bits, bool match_set,
-			 struct bundle_data *bd,
-			 size_t *mismatch)
+			 struct bundle_data *bd)
 {
 	int idx;
 	uint32_t bundle;
-	uint32_t mismatch_bundle;
-	size_t mismatch_bundle_idx;
-	size_t mismatch_bit_off;
 
 	setup_bundle_data(bitarray, bd, offset, num_bits);
 
@@ -81,15 +188,7 @@ static bool match_region(sys_bitarray_t *bitarray, size_t offset,
 			bundle = ~bundle;
 		}
 
-		if ((bundle & bd->smask) != bd->smask) {
-			/* Not matching to mask. */
-			mismatch_bundle = ~bundle & bd->smask;
-			mismatch_bundle_idx = bd->sidx;
-			goto mismatch;
-		} else {
-			/* Matching to mask. */
-			goto out;
-		}
+		return (bundle & bd->smask) == bd->smask;
 	}
 
 	/* Region lies in a number of bundles. Need to loop through them. */
@@ -102,9 +201,7 @@ static bool match_region(sys_bitarray_t *bitarray, size_t offset,
 
 	if ((bundle & bd->smask) != bd->smask) {
 		/* Start bundle not matching to mask. */
-		mismatch_bundle = ~bundle & bd->smask;
-		mismatch_bundle_idx = bd->sidx;
-		goto mismatch;
+		return false;
 	}
 
 	/* End of bundles */
@@ -115,9 +212,7 @@ static bool match_region(sys_bitarray_t *bitarray, size_t offset,
 
 	if ((bundle & bd->emask) != bd->emask) {
 		/* End bundle not matching to mask. */
-		mismatch_bundle = ~bundle & bd->emask;
-		mismatch_bundle_idx = bd->eidx;
-		goto mismatch;
+		return false;
 	}
 
 	/* In-between bundles */
@@ -132,29 +227,12 @@ static bool match_region(sys_bitarray_t *bitarray, size_t offset,
 
 		if (bundle != 0U) {
 			/* Bits in "between bundles" do not match */
-			mismatch_bundle = ~bundle;
-			mismatch_bundle_idx = idx;
-			goto mismatch;
+			return false;
 		}
 	}
 
-out:
 	/* All bits in region matched. */
 	return true;
-
-mismatch:
-	if (mismatch != NULL) {
-		/* Must have at least 1 bit set to indicate
-		 * where the mismatch is.
-		 */
-		__ASSERT_NO_MSG(mismatch_bundle != 0);
-
-		mismatch_bit_off = find_lsb_set(mismatch_bundle) - 1;
-		mismatch_bit_off += mismatch_bundle_idx *
-				    bundle_bitness(bitarray);
-		*mismatch = (uint32_t)mismatch_bit_off;
-	}
-	return false;
 }
 
 /*
@@ -188,6 +266,7 @@ static void set_region(sys_bitarray_t *bitarray, size_t offset,
 		} else {
 			bitarray->bundles[bd->sidx] &= ~bd->smask;
 		}
+		update_summary(bitarray, bd->sidx);
 	} else {
 		/* Start/end at different bundle.
 		 * So set/clear the bits in start and end bundles
@@ -199,14 +278,18 @@ static void set_region(sys_bitarray_t *bitarray, size_t offset,
 			bitarray->bundles[bd->eidx] |= bd->emask;
 			for (idx = bd->sidx + 1; idx < bd->eidx; idx++) {
 				bitarray->bundles[idx] = ~0U;
+				update_summary(bitarray, idx);
 			}
 		} else {
 			bitarray->bundles[bd->sidx] &= ~bd->smask;
 			bitarray->bundles[bd->eidx] &= ~bd->emask;
 			for (idx = bd->sidx + 1; idx < bd->eidx; idx++) {
 				bitarray->bundles[idx] = 0U;
+				update_summary(bitarray, idx);
 			}
 		}
+		update_summary(bitarray, bd->sidx);
+		update_summary(bitarray, bd->eidx);
 	}
 }
 
@@ -230,6 +313,7 @@ int sys_bitarray_set_bit(sys_bitarray_t *bitarray, size_t bit)
 	off = bit % bundle_bitness(bitarray);
 
 	bitarray->bundles[idx] |= BIT(off);
+	update_summary(bitarray, idx);
 
 	ret = 0;
 
@@ -258,6 +342,7 @@ int sys_bitarray_clear_bit(sys_bitarray_t *bitarray, size_t bit)
 	off = bit % bundle_bitness(bitarray);
 
 	bitarray->bundles[idx] &= ~BIT(off);
+	update_summary(bitarray, idx);
 
 	ret = 0;
 
@@ -334,6 +419,7 @@ int sys_bitarray_test_and_set_bit(sys_bitarray_t *bitarray, size_t bit, int *pre
 	}
 
 	bitarray->bundles[idx] |= BIT(off);
+	update_summary(bitarray, idx);
 
 	ret = 0;
 
@@ -373,6 +459,7 @@ int sys_bitarray_test_and_clear_bit(sys_bitarray_t *bitarray, size_t bit, int *p
 	}
 
 	bitarray->bundles[idx] &= ~BIT(off);
+	update_summary(bitarray, idx);
 
 	ret = 0;
 
@@ -385,11 +472,10 @@ int sys_bitarray_alloc(sys_bitarray_t *bitarray, size_t num_bits,
 		       size_t *offset)
 {
 	k_spinlock_key_t key;
-	uint32_t bit_idx;
+	size_t bit_idx;
 	int ret;
-	struct bundle_data bd;
 	size_t off_start, off_end;
-	size_t mismatch;
+	size_t last_start;
 
 	__ASSERT_NO_MSG(bitarray != NULL);
 	__ASSERT_NO_MSG(bitarray->num_bits > 0);
@@ -406,46 +492,26 @@ int sys_bitarray_alloc(sys_bitarray_t *bitarray, size_t num_bits,
 		goto out;
 	}
 
-	bit_idx = 0;
-
-	/* Find the first non-allocated bit by looking at bundles
-	 * instead of individual bits.
-	 *
-	 * On RISC-V 64-bit, it complains about undefined reference to `ffs`.
-	 * So don't use this on RISCV64.
+	/* First fit: jump from the start of each run of cleared bits
+	 * to its end, until one is long enough.
 	 */
-	for (ret = 0; ret < bitarray->num_bundles; ret++) {
-		if (~bitarray->bundles[ret] == 0U) {
-			/* bundle is all 1s => all allocated, skip */
-			bit_idx += bundle_bitness(bitarray);
-			continue;
-		}
-
-		if (bitarray->bundles[ret] != 0U) {
-			/* Find the first free bit in bundle if not all free */
-			off_start = find_lsb_set(~bitarray->bundles[ret]) - 1;
-			bit_idx += off_start;
+	last_start = bitarray->num_bits - num_bits;
+	ret = -ENOSPC;
+	for (bit_idx = 0; ; bit_idx = off_end + 1) {
+		off_start = find_next_clear(bitarray, bit_idx);
+		if (off_start > last_start) {
+			break;
 		}
 
-		break;
-	}
+		off_end = find_next_set(bitarray, off_start,
+					off_start + num_bits);
+		if (off_end == off_start + num_bits) {
+			set_region(bitarray, off_start, num_bits, true, NULL);
 
-	off_end = bitarray->num_bits - num_bits;
-	ret = -ENOSPC;
-	while (bit_idx <= off_end) {
-		if (match_region(bitarray, bit_idx, num_bits, false,
-				 &bd, &mismatch)) {
-			set_region(bitarray, bit_idx, num_bits, true, &bd);
-
-			*offset = bit_idx;
+			*offset = off_start;
 			ret = 0;
 			break;
 		}
-
-		/* Fast-forward to the bit just after
-		 * the mismatched bit.
-		 */
-		bit_idx = mismatch + 1;
 	}
 
 out:
@@ -478,7 +544,7 @@ int sys_bitarray_free(sys_bitarray_t *bitarray, size_t num_bits,
 	 * (offset to offset + num_bits) are all allocated before we clear
 	 * them.
 	 */
-	if (match_region(bitarray, offset, num_bits, true, &bd, NULL)) {
+	if (match_region(bitarray, offset, num_bits, true, &bd)) {
 		set_region(bitarray, offset, num_bits, false, &bd);
 		ret = 0;
 	} else {
@@ -509,7 +575,7 @@ static bool is_region_set_clear(sys_bitarray_t *bitarray, size_t num_bits,
 		goto out;
 	}
 
-	ret = match_region(bitarray, offset, num_bits, to_set, &bd, NULL);
+	ret = match_region(bitarray, offset, num_bits, to_set, &bd);
 
 out:
 	k_spin_unlock(&bitarray->lock, key);
@@ -576,7 +642,7 @@ int sys_bitarray_test_and_set_region(sys_bitarray_t *bitarray, size_t num_bits,
 		goto out;
 	}
 
-	region_clear = match_region(bitarray, offset, num_bits, !to_set, &bd, NULL);
+	region_clear = match_region(bitarray, offset, num_bits, !to_set, &bd);
 	if (region_clear) {
 		set_region(bitarray, offset, num_bits, to_set, &bd);
 		ret = 0;
@@ -0,0 +1,80 @@
+/*
+ * Copyright (c) 2022 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef ZEPHYR_LIB_OS_CRC32_INTERNAL_H_
+#define ZEPHYR_LIB_OS_CRC32_INTERNAL_H_
+
+#include <stddef.h>
+#include <stdint.h>
+#include <zephyr/sys/byteorder.h>
+
+/* Shared by the reflected CRC32 implementations, which all work on the
+ * raw shift register: pre and post conditioning is up to the callers.
+ */
+
+#if defined(CONFIG_CRC32_SLICING_BY_8)
+#define CRC32_SLICES 8
+#elif defined(CONFIG_CRC32_SLICING_BY_4)
+#define CRC32_SLICES 4
+#else
+#define CRC32_SLICES 1
+#endif
+
+#if CRC32_SLICES > 1
+/**
+ * Slicing-by-4/8 update of a reflected CRC32.
+ *
+ * table[0] is the usual byte-wise table, table[n] the CRC of a byte
+ * followed by n zero bytes, so that CRC32_SLICES bytes are folded in
+ * with as many independent lookups.
+ */
+static inline uint32_t crc32_slicing_update(const uint32_t table[][256],
+					    uint32_t crc, const uint8_t *data,
+					    size_t len)
+{
+	for (; len >= CRC32_SLICES; data += CRC32_SLICES, len -= CRC32_SLICES) {
+		uint32_t lo = crc ^ sys_get_le32(data);
+#if CRC32_SLICES > 4
+		uint32_t hi = sys_get_le32(data + 4);
+
+		crc = table[7][lo & 0xff] ^ table[6][(lo >> 8) & 0xff] ^
+		      table[5][(lo >> 16) & 0xff] ^ table[4][lo >> 24] ^
+		      table[3][hi & 0xff] ^ table[2][(hi >> 8) & 0xff] ^
+		      table[1][(hi >> 16) & 0xff] ^ table[0][hi >> 24];
+#else
+		crc = table[3][lo & 0xff] ^ table[2][(lo >> 8) & 0xff] ^
+		      table[1][(lo >> 16) & 0xff] ^ table[0][lo >> 24];
+#endif
+	}
+
+	for (; len > 0; data++, len--) {
+		crc = table[0][(crc ^ *data) & 0xff] ^ (crc >> 8);
+	}
+
+	return crc;
+}
+#endif /* CRC32_SLICES > 1 */
+
+#ifdef CONFIG_CRC32_X86
+/**
+ * Update a CRC32 (IEEE) shift register with PCLMULQDQ folding.
+ *
+ * Consumes what it can from the start of the buffer, advancing @p data
+ * and decreasing @p len accordingly: nothing if the CPU lacks the
+ * instructions or the buffer is too short to be worth it, otherwise a
+ * multiple of 16 bytes. The rest is left to the software implementation.
+ */
+uint32_t z_crc32_ieee_x86(uint32_t crc, const uint8_t **data, size_t *len);
+
+/**
+ * Update a CRC32C shift register with the SSE4.2 crc32 instruction.
+ *
+ * Same contract as z_crc32_ieee_x86().
+ */
+uint32_t z_crc32c_x86(uint32_t crc, const uint8_t **data, size_t *len);
+#endif /* CONFIG_CRC32_X86 */
+
+#endif /* ZEPHYR_LIB_OS_CRC32_INTERNAL_H_ */
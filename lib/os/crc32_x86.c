@@ -0,0 +1,225 @@
+/*
+ * Copyright (c) 2022 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/sys/crc.h>
+#include <zephyr/sys/util.h>
+#include "crc32_internal.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+
+#include <cpuid.h> /* Header provided by the toolchain. */
+#include <immintrin.h>
+
+/* The PCLMULQDQ folding keeps its state in SSE registers, which the
+ * kernel only preserves across interrupts and context switches on
+ * x86_64. Host processes (native_posix, unit tests) always have them
+ * preserved. The crc32 instruction only uses general purpose registers.
+ */
+#if defined(CONFIG_X86_64) || !defined(CONFIG_X86) || defined(ZTEST_UNITTEST)
+#define CRC32_X86_PCLMUL 1
+#endif
+
+#define HAS_SSE42  BIT(0)
+#define HAS_PCLMUL BIT(1)
+#define PROBED     BIT(2)
+
+static uint32_t features;
+
+static uint32_t features_get(void)
+{
+	uint32_t f = features;
+
+	if (f == 0U) {
+		uint32_t eax, ebx, ecx = 0U, edx;
+
+		f = PROBED;
+		if (__get_cpuid(1, &eax, &ebx, &ecx, &edx) != 0) {
+			if ((ecx & bit_SSE4_2) != 0U) {
+				f |= HAS_SSE42;
+			}
+			if (((ecx & bit_PCLMUL) != 0U) && ((ecx & bit_SSE4_1) != 0U)) {
+				f |= HAS_PCLMUL;
+			}
+		}
+
+		/* Racing CPUs store the same value */
+		features = f;
+	}
+
+	return f;
+}
+
+__attribute__((target("sse4.2")))
+static uint32_t crc32c_sse42(uint32_t crc, const uint8_t *data, size_t len)
+{
+#ifdef __x86_64__
+	uint64_t crc64 = crc;
+
+	for (; len >= 8; data += 8, len -= 8) {
+		crc64 = _mm_crc32_u64(crc64, UNALIGNED_GET((const uint64_t *)data));
+	}
+	crc = (uint32_t)crc64;
+#endif
+
+	for (; len >= 4; data += 4, len -= 4) {
+		crc = _mm_crc32_u32(crc, UNALIGNED_GET((const uint32_t *)data));
+	}
+
+	for (; len > 0; data++, len--) {
+		crc = _mm_crc32_u8(crc, *data);
+	}
+
+	return crc;
+}
+
+uint32_t z_crc32c_x86(uint32_t crc, const uint8_t **data, size_t *len)
+{
+	if ((features_get() & HAS_SSE42) == 0U) {
+		return crc;
+	}
+
+	crc = crc32c_sse42(crc, *data, *len);
+	*data += *len;
+	*len = 0;
+
+	return crc;
+}
+
+#ifdef CRC32_X86_PCLMUL
+/* Folding constants for the reflected polynomial 0x104c11db7, see
+ * "Fast CRC Computation for Generic Polynomials Using PCLMULQDQ
+ * Instruction", Intel, 2009: x^(4*128+32) mod P and x^(4*128-32) mod P
+ * to fold by 4 blocks, x^(128+32) mod P and x^(128-32) mod P to fold by
+ * one, x^64 mod P to fold 96 bits to 64, then the Barrett reduction
+ * constants P' and mu.
+ */
+static const uint64_t fold4[2] __aligned(16) = { 0x0154442bd4, 0x01c6e41596 };
+static const uint64_t fold1[2] __aligned(16) = { 0x01751997d0, 0x00ccaa009e };
+static const uint64_t fold64[2] __aligned(16) = { 0x0163cd6124, 0x0000000000 };
+static const uint64_t barrett[2] __aligned(16) = { 0x01db710641, 0x01f7011641 };
+
+/* Smallest buffer worth the setup, which also needs the 4 blocks the
+ * main loop folds in parallel.
+ */
+#define PCLMUL_MIN_LEN 64
+
+__attribute__((target("pclmul,sse4.1")))
+static uint32_t crc32_pclmul(uint32_t crc, const uint8_t *data, size_t len)
+{
+	const __m128i mask32 = _mm_setr_epi32(~0, 0, ~0, 0);
+	__m128i k, x0, x1, x2, x3, t0, t1, t2, t3;
+
+	x0 = _mm_loadu_si128((const __m128i *)(data + 0x00));
+	x1 = _mm_loadu_si128((const __m128i *)(data + 0x10));
+	x2 = _mm_loadu_si128((const __m128i *)(data + 0x20));
+	x3 = _mm_loadu_si128((const __m128i *)(data + 0x30));
+	x0 = _mm_xor_si128(x0, _mm_cvtsi32_si128((int)crc));
+	data += 64;
+	len -= 64;
+
+	/* Fold 4 blocks of 128 bits at a time */
+	k = _mm_load_si128((const __m128i *)fold4);
+	for (; len >= 64; data += 64, len -= 64) {
+		t0 = _mm_clmulepi64_si128(x0, k, 0x00);
+		t1 = _mm_clmulepi64_si128(x1, k, 0x00);
+		t2 = _mm_clmulepi64_si128(x2, k, 0x00);
+		t3 = _mm_clmulepi64_si128(x3, k, 0x00);
+		x0 = _mm_clmulepi64_si128(x0, k, 0x11);
+		x1 = _mm_clmulepi64_si128(x1, k, 0x11);
+		x2 = _mm_clmulepi64_si128(x2, k, 0x11);
+		x3 = _mm_clmulepi64_si128(x3, k, 0x11);
+		x0 = _mm_xor_si128(_mm_xor_si128(x0, t0),
+				   _mm_loadu_si128((const __m128i *)(data + 0x00)));
+		x1 = _mm_xor_si128(_mm_xor_si128(x1, t1),
+				   _mm_loadu_si128((const __m128i *)(data + 0x10)));
+		x2 = _mm_xor_si128(_mm_xor_si128(x2, t2),
+				   _mm_loadu_si128((const __m128i *)(data + 0x20)));
+		x3 = _mm_xor_si128(_mm_xor_si128(x3, t3),
+				   _mm_loadu_si128((const __m128i *)(data + 0x30)));
+	}
+
+	/* Fold the 4 blocks into one */
+	k = _mm_load_si128((const __m128i *)fold1);
+	t0 = _mm_clmulepi64_si128(x0, k, 0x00);
+	x0 = _mm_clmulepi64_si128(x0, k, 0x11);
+	x0 = _mm_xor_si128(_mm_xor_si128(x0, t0), x1);
+	t0 = _mm_clmulepi64_si128(x0, k, 0x00);
+	x0 = _mm_clmulepi64_si128(x0, k, 0x11);
+	x0 = _mm_xor_si128(_mm_xor_si128(x0, t0), x2);
+	t0 = _mm_clmulepi64_si128(x0, k, 0x00);
+	x0 = _mm_clmulepi64_si128(x0, k, 0x11);
+	x0 = _mm_xor_si128(_mm_xor_si128(x0, t0), x3);
+
+	/* Then fold in the remaining whole blocks one at a time */
+	for (; len >= 16; data += 16, len -= 16) {
+		t0 = _mm_clmulepi64_si128(x0, k, 0x00);
+		x0 = _mm_clmulepi64_si128(x0, k, 0x11);
+		x0 = _mm_xor_si128(_mm_xor_si128(x0, t0),
+				   _mm_loadu_si128((const __m128i *)data));
+	}
+
+	/* Fold 128 bits to 64 */
+	t0 = _mm_clmulepi64_si128(x0, k, 0x10);
+	x0 = _mm_xor_si128(_mm_srli_si128(x0, 8), t0);
+	k = _mm_loadl_epi64((const __m128i *)fold64);
+	t0 = _mm_srli_si128(x0, 4);
+	x0 = _mm_clmulepi64_si128(_mm_and_si128(x0, mask32), k, 0x00);
+	x0 = _mm_xor_si128(x0, t0);
+
+	/* Barrett reduction to 32 bits */
+	k = _mm_load_si128((const __m128i *)barrett);
+	t0 = _mm_clmulepi64_si128(_mm_and_si128(x0, mask32), k, 0x10);
+	t0 = _mm_clmulepi64_si128(_mm_and_si128(t0, mask32), k, 0x00);
+	x0 = _mm_xor_si128(x0, t0);
+
+	return (uint32_t)_mm_extract_epi32(x0, 1);
+}
+
+uint32_t z_crc32_ieee_x86(uint32_t crc, const uint8_t **data, size_t *len)
+{
+	size_t n = *len & ~(size_t)15;
+
+	if ((n < PCLMUL_MIN_LEN) || ((features_get() & HAS_PCLMUL) == 0U)) {
+		return crc;
+	}
+
+	crc = crc32_pclmul(crc, *data, n);
+	*data += n;
+	*len -= n;
+
+	return crc;
+}
+#else
+uint32_t z_crc32_ieee_x86(uint32_t crc, const uint8_t **data, size_t *len)
+{
+	ARG_UNUSED(data);
+	ARG_UNUSED(len);
+
+	return crc;
+}
+#endif /* CRC32_X86_PCLMUL */
+
+#else /* !(__x86_64__ || __i386__) */
+
+/* POSIX architecture on a non-x86 host: software only */
+
+uint32_t z_crc32c_x86(uint32_t crc, const uint8_t **data, size_t *len)
+{
+	ARG_UNUSED(data);
+	ARG_UNUSED(len);
+
+	return crc;
+}
+
+uint32_t z_crc32_ieee_x86(uint32_t crc, const uint8_t **data, size_t *len)
+{
+	ARG_UNUSED(data);
+	ARG_UNUSED(len);
+
+	return crc;
+}
+
+#endif /* __x86_64__ || __i386__ */
@@ -0,0 +1,285 @@
+/*
+ * Copyright (c) 2022 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <errno.h>
+#include <string.h>
+#include <zephyr/sys/__assert.h>
+#include <zephyr/sys/hash_map.h>
+#include <zephyr/sys/util.h>
+
+/* Dynamic maps grow past 3/4 full, from this capacity */
+#define MIN_CAPACITY 8
+
+#define SLOT_USED BIT(31)
+
+/* Finalizer of MurmurHash3, so that the low bits indexing the slots
+ * depend on all the bits of the key.
+ */
+static uint32_t mix(uint32_t h)
+{
+	h ^= h >> 16;
+	h *= 0x85ebca6bU;
+	h ^= h >> 13;
+	h *= 0xc2b2ae35U;
+	h ^= h >> 16;
+
+	return h;
+}
+
+static uint32_t hash(const struct sys_hash_map *map, uintptr_t key)
+{
+	uint32_t h;
+
+	if (map->key_type == SYS_HASH_MAP_KEY_STR) {
+		/* FNV-1a */
+		h = 2166136261U;
+		for (const char *s = (const char *)key; *s != '\0'; s++) {
+			h = (h ^ (uint8_t)*s) * 16777619U;
+		}
+	} else {
+		h = (uint32_t)((uint64_t)key ^ ((uint64_t)key >> 32));
+	}
+
+	return mix(h) | SLOT_USED;
+}
+
+static bool key_equal(const struct sys_hash_map *map, uintptr_t a, uintptr_t b)
+{
+	if (map->key_type == SYS_HASH_MAP_KEY_STR) {
+		return strcmp((const char *)a, (const char *)b) == 0;
+	}
+
+	return a == b;
+}
+
+/* Distance of slot i from the home slot of its entry */
+static uint32_t distance(const struct sys_hash_map *map, uint32_t i)
+{
+	return (i - map->slots[i].hash) & (map->capacity - 1U);
+}
+
+static struct sys_hash_map_slot *find(const struct sys_hash_map *map,
+				      uintptr_t key, uint32_t h)
+{
+	uint32_t mask = map->capacity - 1U;
+
+	for (uint32_t d = 0, i = h & mask; d < map->capacity;
+	     d++, i = (i + 1U) & mask) {
+		struct sys_hash_map_slot *slot = &map->slots[i];
+
+		/* Stop at an empty slot, or at an entry closer to its
+		 * home than the key would be: it would have been swapped
+		 * with it on insertion.
+		 */
+		if ((slot->hash == 0U) || (distance(map, i) < d)) {
+			break;
+		}
+
+		if ((slot->hash == h) && key_equal(map, slot->key, key)) {
+			return slot;
+		}
+	}
+
+	return NULL;
+}
+
+/* Insert a key known to be absent, with room for it */
+static void place(struct sys_hash_map *map, uintptr_t key, void *value,
+		  uint32_t h)
+{
+	struct sys_hash_map_slot entry = {
+		.key = key,
+		.value = value,
+		.hash = h,
+	};
+	uint32_t mask = map->capacity - 1U;
+
+	for (uint32_t d = 0, i = h & mask; ; d++, i = (i + 1U) & mask) {
+		struct sys_hash_map_slot *slot = &map->slots[i];
+		uint32_t slot_d;
+
+		if (slot->hash == 0U) {
+			*slot = entry;
+			break;
+		}
+
+		/* Take the place of richer entries, and carry on with
+		 * them instead.
+		 */
+		slot_d = distance(map, i);
+		if (slot_d < d) {
+			struct sys_hash_map_slot tmp = *slot;
+
+			*slot = entry;
+			entry = tmp;
+			d = slot_d;
+		}
+	}
+
+	map->size++;
+}
+
+static int grow(struct sys_hash_map *map)
+{
+	struct sys_hash_map_slot *old = map->slots;
+	uint32_t old_capacity = map->capacity;
+	uint32_t capacity = MAX(old_capacity * 2U, MIN_CAPACITY);
+	struct sys_hash_map_slot *slots;
+
+	slots = map->alloc(NULL, capacity * sizeof(*slots));
+	if (slots == NULL) {
+		return -ENOMEM;
+	}
+	(void)memset(slots, 0, capacity * sizeof(*slots));
+
+	map->slots = slots;
+	map->capacity = capacity;
+	map->size = 0U;
+
+	for (uint32_t i = 0; i < old_capacity; i++) {
+		if (old[i].hash != 0U) {
+			place(map, old[i].key, old[i].value, old[i].hash);
+		}
+	}
+
+	if (old != NULL) {
+		(void)map->alloc(old, 0);
+	}
+
+	return 0;
+}
+
+void sys_hash_map_init_fixed(struct sys_hash_map *map,
+			     enum sys_hash_map_key_type type,
+			     struct sys_hash_map_slot *slots, size_t capacity)
+{
+	__ASSERT((capacity > 0) && ((capacity & (capacity - 1)) == 0),
+		 "capacity must be a power of two");
+
+	(void)memset(slots, 0, capacity * sizeof(*slots));
+	*map = (struct sys_hash_map) {
+		.slots = slots,
+		.capacity = capacity,
+		.key_type = type,
+	};
+}
+
+void sys_hash_map_init_dynamic(struct sys_hash_map *map,
+			       enum sys_hash_map_key_type type,
+			       sys_hash_map_alloc_t alloc)
+{
+	*map = (struct sys_hash_map) {
+		.alloc = alloc,
+		.key_type = type,
+	};
+}
+
+int sys_hash_map_insert(struct sys_hash_map *map, uintptr_t key, void *value,
+			void **old_value)
+{
+	uint32_t h = hash(map, key);
+	struct sys_hash_map_slot *slot;
+
+	__ASSERT(value != NULL, "NULL values are not supported");
+
+	slot = (map->capacity != 0U) ? find(map, key, h) : NULL;
+	if (slot != NULL) {
+		if (old_value != NULL) {
+			*old_value = slot->value;
+		}
+		slot->value = value;
+		return 1;
+	}
+
+	if (map->alloc == NULL) {
+		if (map->size == map->capacity) {
+			return -ENOSPC;
+		}
+	} else if ((map->size + 1U) * 4U > map->capacity * 3U) {
+		int ret = grow(map);
+
+		if (ret != 0) {
+			return ret;
+		}
+	}
+
+	place(map, key, value, h);
+	if (old_value != NULL) {
+		*old_value = NULL;
+	}
+
+	return 0;
+}
+
+void *sys_hash_map_get(const struct sys_hash_map *map, uintptr_t key)
+{
+	struct sys_hash_map_slot *slot;
+
+	if (map->size == 0U) {
+		return NULL;
+	}
+
+	slot = find(map, key, hash(map, key));
+
+	return (slot != NULL) ? slot->value : NULL;
+}
+
+void *sys_hash_map_remove(struct sys_hash_map *map, uintptr_t key)
+{
+	uint32_t mask = map->capacity - 1U;
+	struct sys_hash_map_slot *slot;
+	uint32_t i, next;
+	void *value;
+
+	if (map->size == 0U) {
+		return NULL;
+	}
+
+	slot = find(map, key, hash(map, key));
+	if (slot == NULL) {
+		return NULL;
+	}
+	value = slot->value;
+
+	/* Shift back the following entries not in their home slot,
+	 * which keeps probe sequences as if the entry never existed.
+	 */
+	for (i = slot - map->slots, next = (i + 1U) & mask;
+	     (map->slots[next].hash != 0U) && (distance(map, next) != 0U) &&
+	     (next != slot - map->slots);
+	     i = next, next = (next + 1U) & mask) {
+		map->slots[i] = map->slots[next];
+	}
+	map->slots[i].hash = 0U;
+	map->size--;
+
+	return value;
+}
+
+void sys_hash_map_clear(struct sys_hash_map *map)
+{
+	if (map->alloc != NULL) {
+		if (map->slots != NULL) {
+			(void)map->alloc(map->slots, 0);
+		}
+		map->slots = NULL;
+		map->capacity = 0U;
+	} else {
+		(void)memset(map->slots, 0, map->capacity * sizeof(*map->slots));
+	}
+
+	map->size = 0U;
+}
+
+void sys_hash_map_foreach(const struct sys_hash_map *map, sys_hash_map_cb_t cb,
+			  void *user_data)
+{
+	for (uint32_t i = 0; i < map->capacity; i++) {
+		if (map->slots[i].hash != 0U) {
+			cb(map->slots[i].key, map->slots[i].value, user_data);
+		}
+	}
+}
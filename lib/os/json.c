@@ -730,6 +730,580 @@ int json_arr_separate_parse_object(struct json_obj *json, const struct json_obj_
 	return obj_parse(json, descr, descr_len, val);
 }
 
+/* Streaming parser: the lexer works a character at a time, so that it
+ * can stop at the end of any chunk, and the grammar a token at a time.
+ */
+
+enum stream_lex {
+	LEX_NONE,
+	LEX_STRING,
+	LEX_STRING_ESCAPE,
+	LEX_STRING_UNICODE,
+	LEX_NUMBER,
+	LEX_TRUE,
+	LEX_FALSE,
+	LEX_NULL,
+};
+
+enum stream_expect {
+	EXPECT_ROOT,
+	EXPECT_VALUE,
+	EXPECT_VALUE_OR_END,
+	EXPECT_KEY,
+	EXPECT_KEY_OR_END,
+	EXPECT_COLON,
+	EXPECT_COMMA_OR_END,
+	EXPECT_NOTHING,
+};
+
+/* Outcome of a character */
+enum stream_char {
+	CHAR_CONSUMED,
+	CHAR_TOKEN,
+	/* Token ended by a character belonging to the next one */
+	CHAR_TOKEN_NOT_CONSUMED,
+};
+
+static const char *const stream_literals[] = {
+	[LEX_TRUE] = "true",
+	[LEX_FALSE] = "false",
+	[LEX_NULL] = "null",
+};
+
+void json_stream_init(struct json_stream *stream, char *buf, size_t buf_size)
+{
+	__ASSERT_NO_MSG(buf_size > 0);
+
+	*stream = (struct json_stream) {
+		.buf = buf,
+		.buf_size = buf_size,
+		.lex = LEX_NONE,
+		.expect = EXPECT_ROOT,
+	};
+}
+
+static int stream_append(struct json_stream *stream, char chr)
+{
+	/* Room for the NUL terminator */
+	if (stream->len + 1 >= stream->buf_size) {
+		return -ENOMEM;
+	}
+
+	stream->buf[stream->len++] = chr;
+
+	return 0;
+}
+
+static void stream_emit(struct json_stream *stream, enum json_tokens type,
+			struct json_stream_token *tok)
+{
+	stream->buf[stream->len] = '\0';
+
+	tok->type = type;
+	tok->key = false;
+	tok->start = &stream->buf[stream->kept];
+	tok->length = stream->len - stream->kept;
+
+	stream->lex = LEX_NONE;
+}
+
+/* Keep the contents of the last token in the buffer, instead of letting
+ * the next token overwrite it.
+ */
+static int stream_keep(struct json_stream *stream)
+{
+	/* Room for the NUL terminator of the next token */
+	if (stream->len + 1 >= stream->buf_size) {
+		return -ENOMEM;
+	}
+
+	stream->kept = stream->len + 1;
+	stream->len = stream->kept;
+
+	return 0;
+}
+
+static int stream_lex(struct json_stream *stream, char chr,
+		      struct json_stream_token *tok)
+{
+	switch (stream->lex) {
+	case LEX_NONE:
+		stream->len = stream->kept;
+
+		switch (chr) {
+		case '{':
+		case '}':
+		case '[':
+		case ']':
+		case ',':
+		case ':':
+			stream_emit(stream, (enum json_tokens)chr, tok);
+			return CHAR_TOKEN;
+		case '"':
+			stream->lex = LEX_STRING;
+			return CHAR_CONSUMED;
+		case 't':
+			stream->lex = LEX_TRUE;
+			stream->lit = 1;
+			return CHAR_CONSUMED;
+		case 'f':
+			stream->lex = LEX_FALSE;
+			stream->lit = 1;
+			return CHAR_CONSUMED;
+		case 'n':
+			stream->lex = LEX_NULL;
+			stream->lit = 1;
+			return CHAR_CONSUMED;
+		default:
+			if (isspace((unsigned char)chr)) {
+				return CHAR_CONSUMED;
+			}
+
+			if (isdigit((unsigned char)chr) || chr == '-') {
+				stream->lex = LEX_NUMBER;
+				return stream_append(stream, chr);
+			}
+
+			return -EINVAL;
+		}
+	case LEX_STRING:
+		if (chr == '"') {
+			stream_emit(stream, JSON_TOK_STRING, tok);
+			return CHAR_TOKEN;
+		}
+
+		if (chr == '\\') {
+			stream->lex = LEX_STRING_ESCAPE;
+		}
+
+		return stream_append(stream, chr);
+	case LEX_STRING_ESCAPE:
+		switch (chr) {
+		case '"':
+		case '\\':
+		case '/':
+		case 'b':
+		case 'f':
+		case 'n':
+		case 'r':
+		case 't':
+			stream->lex = LEX_STRING;
+			break;
+		case 'u':
+			stream->lex = LEX_STRING_UNICODE;
+			stream->lit = 0;
+			break;
+		default:
+			return -EINVAL;
+		}
+
+		return stream_append(stream, chr);
+	case LEX_STRING_UNICODE:
+		if (!isxdigit((unsigned char)chr)) {
+			return -EINVAL;
+		}
+
+		if (++stream->lit == 4) {
+			stream->lex = LEX_STRING;
+		}
+
+		return stream_append(stream, chr);
+	case LEX_NUMBER:
+		if (isdigit((unsigned char)chr) || chr == '.' || chr == 'e' ||
+		    chr == 'E' || chr == '+' || chr == '-') {
+			return stream_append(stream, chr);
+		}
+
+		if (!isdigit((unsigned char)stream->buf[stream->len - 1])) {
+			return -EINVAL;
+		}
+
+		stream_emit(stream, JSON_TOK_NUMBER, tok);
+		return CHAR_TOKEN_NOT_CONSUMED;
+	default: {
+		const char *literal = stream_literals[stream->lex];
+
+		if (chr != literal[stream->lit]) {
+			return -EINVAL;
+		}
+
+		if (literal[++stream->lit] != '\0') {
+			return CHAR_CONSUMED;
+		}
+
+		stream_emit(stream, (enum json_tokens)literal[0], tok);
+		return CHAR_TOKEN;
+	}
+	}
+}
+
+static int stream_push(struct json_stream *stream, bool object)
+{
+	if (stream->depth == 32) {
+		return -E2BIG;
+	}
+
+	WRITE_BIT(stream->objects, stream->depth, object);
+	stream->depth++;
+	stream->expect = object ? EXPECT_KEY_OR_END : EXPECT_VALUE_OR_END;
+
+	return 1;
+}
+
+static int stream_pop(struct json_stream *stream, bool object)
+{
+	stream->depth--;
+	if (((stream->objects & BIT(stream->depth)) != 0) != object) {
+		return -EINVAL;
+	}
+
+	stream->expect = (stream->depth == 0) ? EXPECT_NOTHING :
+			 EXPECT_COMMA_OR_END;
+
+	return 1;
+}
+
+/* Check a token against the grammar, returns 1 to pass it on */
+static int stream_parse(struct json_stream *stream,
+			struct json_stream_token *tok)
+{
+	switch (stream->expect) {
+	case EXPECT_ROOT:
+		if (tok->type == JSON_TOK_OBJECT_START ||
+		    tok->type == JSON_TOK_ARRAY_START) {
+			return stream_push(stream,
+					   tok->type == JSON_TOK_OBJECT_START);
+		}
+
+		return -EINVAL;
+	case EXPECT_KEY_OR_END:
+		if (tok->type == JSON_TOK_OBJECT_END) {
+			return stream_pop(stream, true);
+		}
+
+		__fallthrough;
+	case EXPECT_KEY:
+		if (tok->type != JSON_TOK_STRING) {
+			return -EINVAL;
+		}
+
+		tok->key = true;
+		stream->expect = EXPECT_COLON;
+		return 1;
+	case EXPECT_COLON:
+		if (tok->type != JSON_TOK_COLON) {
+			return -EINVAL;
+		}
+
+		stream->expect = EXPECT_VALUE;
+		return 0;
+	case EXPECT_COMMA_OR_END:
+		switch (tok->type) {
+		case JSON_TOK_COMMA:
+			stream->expect = (stream->objects & BIT(stream->depth - 1)) ?
+					 EXPECT_KEY : EXPECT_VALUE;
+			return 0;
+		case JSON_TOK_OBJECT_END:
+			return stream_pop(stream, true);
+		case JSON_TOK_ARRAY_END:
+			return stream_pop(stream, false);
+		default:
+			return -EINVAL;
+		}
+	case EXPECT_VALUE_OR_END:
+		if (tok->type == JSON_TOK_ARRAY_END) {
+			return stream_pop(stream, false);
+		}
+
+		__fallthrough;
+	case EXPECT_VALUE:
+		switch (tok->type) {
+		case JSON_TOK_OBJECT_START:
+			return stream_push(stream, true);
+		case JSON_TOK_ARRAY_START:
+			return stream_push(stream, false);
+		case JSON_TOK_STRING:
+		case JSON_TOK_NUMBER:
+		case JSON_TOK_TRUE:
+		case JSON_TOK_FALSE:
+		case JSON_TOK_NULL:
+			stream->expect = EXPECT_COMMA_OR_END;
+			return 1;
+		default:
+			return -EINVAL;
+		}
+	default:
+		return -EINVAL;
+	}
+}
+
+int json_stream_next(struct json_stream *stream, const char **data,
+		     size_t *len, struct json_stream_token *tok)
+{
+	while (*len > 0) {
+		int ret;
+
+		if (stream->expect == EXPECT_NOTHING) {
+			if (!isspace((unsigned char)**data)) {
+				return -EINVAL;
+			}
+
+			(*data)++;
+			(*len)--;
+			continue;
+		}
+
+		ret = stream_lex(stream, **data, tok);
+		if (ret < 0) {
+			return ret;
+		}
+
+		if (ret != CHAR_TOKEN_NOT_CONSUMED) {
+			(*data)++;
+			(*len)--;
+		}
+
+		if (ret != CHAR_CONSUMED) {
+			ret = stream_parse(stream, tok);
+			if (ret != 0) {
+				return ret;
+			}
+		}
+	}
+
+	return (stream->expect == EXPECT_NOTHING) ? 0 : -EAGAIN;
+}
+
+void json_stream_obj_parse_init(struct json_stream_obj *obj,
+				const struct json_obj_descr *descr,
+				size_t descr_len, void *val,
+				char *buf, size_t buf_size)
+{
+	__ASSERT_NO_MSG(descr_len < (sizeof(obj->result) * CHAR_BIT - 1));
+
+	*obj = (struct json_stream_obj) {
+		.result = -EAGAIN,
+	};
+	json_stream_init(&obj->stream, buf, buf_size);
+
+	obj->frames[0].descr = descr;
+	obj->frames[0].descr_len = descr_len;
+	obj->frames[0].val = val;
+}
+
+static int stream_obj_push(struct json_stream_obj *obj,
+			   const struct json_obj_descr *descr,
+			   size_t descr_len, void *val, size_t *count,
+			   bool array)
+{
+	if (obj->depth == ARRAY_SIZE(obj->frames)) {
+		return -E2BIG;
+	}
+
+	obj->frames[obj->depth].descr = descr;
+	obj->frames[obj->depth].descr_len = descr_len;
+	obj->frames[obj->depth].val = val;
+	obj->frames[obj->depth].count = count;
+	obj->frames[obj->depth].decoded = 0;
+	obj->frames[obj->depth].array = array;
+	obj->depth++;
+
+	if (count != NULL) {
+		*count = 0;
+	}
+
+	return 0;
+}
+
+static int stream_obj_decode(struct json_stream_obj *obj,
+			     const struct json_obj_descr *descr,
+			     struct json_stream_token *tok, void *field,
+			     void *val)
+{
+	if (!equivalent_types(tok->type, descr->type)) {
+		return -EINVAL;
+	}
+
+	switch (descr->type) {
+	case JSON_TOK_OBJECT_START:
+		return stream_obj_push(obj, descr->object.sub_descr,
+				       descr->object.sub_descr_len, field,
+				       NULL, false);
+	case JSON_TOK_ARRAY_START: {
+		const struct json_obj_descr *elem = descr->array.element_descr;
+
+		return stream_obj_push(obj, elem, descr->array.n_elements,
+				       field,
+				       (val != NULL) ?
+				       (size_t *)((char *)val + elem->offset) :
+				       NULL, true);
+	}
+	case JSON_TOK_FALSE:
+	case JSON_TOK_TRUE: {
+		bool *v = field;
+
+		*v = tok->type == JSON_TOK_TRUE;
+
+		return 0;
+	}
+	case JSON_TOK_NUMBER: {
+		struct json_token value = {
+			.start = tok->start,
+			.end = tok->start + tok->length,
+		};
+
+		return decode_num(&value, field);
+	}
+	case JSON_TOK_OPAQUE:
+	case JSON_TOK_FLOAT: {
+		struct json_obj_token *obj_token = field;
+
+		obj_token->start = tok->start;
+		obj_token->length = tok->length;
+
+		return stream_keep(&obj->stream);
+	}
+	case JSON_TOK_STRING: {
+		char **str = field;
+
+		*str = tok->start;
+
+		return stream_keep(&obj->stream);
+	}
+	default:
+		/* Including JSON_TOK_OBJ_ARRAY, whose text isn't kept */
+		return -ENOTSUP;
+	}
+}
+
+static const struct json_obj_descr *stream_obj_field(struct json_stream_obj *obj,
+						     struct json_stream_token *tok)
+{
+	struct json_stream_frame *frame = &obj->frames[obj->depth - 1];
+
+	for (size_t i = 0; i < frame->descr_len; i++) {
+		const struct json_obj_descr *descr = &frame->descr[i];
+
+		if ((frame->decoded & BIT(i)) == 0 &&
+		    tok->length == descr->field_name_len &&
+		    memcmp(tok->start, descr->field_name, tok->length) == 0) {
+			frame->decoded |= BIT(i);
+			return descr;
+		}
+	}
+
+	return NULL;
+}
+
+static int stream_obj_token(struct json_stream_obj *obj,
+			    struct json_stream_token *tok)
+{
+	struct json_stream_frame *frame;
+	const struct json_obj_descr *descr;
+	void *field;
+
+	/* Value of an unknown key, or part of it */
+	if (obj->skip > 0) {
+		if (tok->type == JSON_TOK_OBJECT_START ||
+		    tok->type == JSON_TOK_ARRAY_START) {
+			obj->skip++;
+		} else if (tok->type == JSON_TOK_OBJECT_END ||
+			   tok->type == JSON_TOK_ARRAY_END) {
+			obj->skip--;
+		}
+
+		return 0;
+	}
+
+	/* The root object */
+	if (obj->depth == 0) {
+		if (tok->type != JSON_TOK_OBJECT_START) {
+			return -EINVAL;
+		}
+
+		obj->depth = 1;
+		return 0;
+	}
+
+	if (tok->type == JSON_TOK_OBJECT_END ||
+	    tok->type == JSON_TOK_ARRAY_END) {
+		obj->depth--;
+		if (obj->depth == 0) {
+			obj->result = obj->frames[0].decoded;
+		}
+
+		return 0;
+	}
+
+	frame = &obj->frames[obj->depth - 1];
+
+	if (!frame->array) {
+		if (tok->key) {
+			obj->field = stream_obj_field(obj, tok);
+			return 0;
+		}
+
+		descr = obj->field;
+		if (descr == NULL) {
+			if (tok->type == JSON_TOK_OBJECT_START ||
+			    tok->type == JSON_TOK_ARRAY_START) {
+				obj->skip = 1;
+			}
+
+			return 0;
+		}
+
+		return stream_obj_decode(obj, descr, tok,
+					 (char *)frame->val + descr->offset,
+					 frame->val);
+	}
+
+	if (frame->decoded == frame->descr_len) {
+		return -ENOSPC;
+	}
+
+	field = (char *)frame->val +
+		get_elem_size(frame->descr) * frame->decoded;
+	frame->decoded++;
+	if (frame->count != NULL) {
+		(*frame->count)++;
+	}
+
+	return stream_obj_decode(obj, frame->descr, tok, field, NULL);
+}
+
+int json_stream_obj_parse(struct json_stream_obj *obj, const char *data,
+			  size_t len)
+{
+	struct json_stream_token tok;
+	int ret;
+
+	while (obj->result == -EAGAIN) {
+		ret = json_stream_next(&obj->stream, &data, &len, &tok);
+		if (ret == -EAGAIN) {
+			return ret;
+		}
+
+		if (ret > 0) {
+			ret = stream_obj_token(obj, &tok);
+		}
+
+		if (ret < 0) {
+			obj->result = ret;
+		}
+	}
+
+	/* Only whitespace may follow */
+	if (obj->result >= 0) {
+		ret = json_stream_next(&obj->stream, &data, &len, &tok);
+		if (ret < 0) {
+			obj->result = ret;
+		}
+	}
+
+	return obj->result;
+}
+
 static char escape_as(char chr)
 {
 	switch (chr) {
@@ -0,0 +1,243 @@
+/*
+ * Copyright (c) 2022 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <errno.h>
+#include <string.h>
+#include <zephyr/sys/__assert.h>
+#include <zephyr/sys/mpsc_ring_buffer.h>
+
+/* Record header: length of the data in bytes, and flags. A header is 0
+ * from the time the record is reserved to the time its producer writes
+ * the reserved length, and committed records have the VALID flag. PAD
+ * records hold no data, they fill the space skipped at the end of the
+ * buffer or left unused by a record committed short.
+ */
+#define HDR_VALID BIT(31)
+#define HDR_PAD BIT(30)
+#define HDR_LEN_MASK BIT_MASK(30)
+
+#define HDR_SIZE sizeof(uint32_t)
+
+/* Bytes taken by a record of len bytes */
+static inline uint32_t record_span(uint32_t len)
+{
+	return HDR_SIZE + ROUND_UP(len, HDR_SIZE);
+}
+
+static inline volatile uint32_t *header_at(struct mpsc_ring_buf *buf,
+					   uint32_t idx)
+{
+	return &buf->buffer[(idx & (buf->size - 1U)) / HDR_SIZE];
+}
+
+void mpsc_ring_buf_init(struct mpsc_ring_buf *buf, uint32_t size,
+			uint32_t *data)
+{
+	__ASSERT((size >= 8U) && (size <= MPSC_RING_BUFFER_MAX_SIZE) &&
+		 ((size & (size - 1U)) == 0U),
+		 "size must be a power of two");
+
+	(void)memset(data, 0, size);
+	*buf = (struct mpsc_ring_buf) {
+		.buffer = data,
+		.size = size,
+	};
+}
+
+uint32_t mpsc_ring_buf_put_claim(struct mpsc_ring_buf *buf, uint8_t **data,
+				 uint32_t size)
+{
+	uint32_t head, free, end, pad, span;
+	volatile uint32_t *hdr;
+	atomic_val_t old;
+
+	/* Padding is shorter than the record it is skipped for, so a
+	 * record of at most half the buffer always fits once drained.
+	 * A larger one would never fit at some offsets.
+	 */
+	if ((size == 0U) || (size > buf->size / 2U - HDR_SIZE)) {
+		return 0;
+	}
+	span = record_span(size);
+
+	do {
+		old = atomic_get(&buf->put_head);
+		head = (uint32_t)old;
+		free = buf->size - (head - (uint32_t)atomic_get(&buf->get_tail));
+
+		/* Skip the end of the buffer if the record does not fit */
+		end = buf->size - (head & (buf->size - 1U));
+		pad = (end < span) ? end : 0U;
+
+		if (pad + span > free) {
+			return 0;
+		}
+	} while (!atomic_cas(&buf->put_head, old,
+			     (atomic_val_t)(head + pad + span)));
+
+	/* The reserved space was cleared when it was released, the
+	 * consumer stops at the zero header until it is written.
+	 */
+	if (pad != 0U) {
+		*header_at(buf, head) = HDR_VALID | HDR_PAD | (pad - HDR_SIZE);
+		head += pad;
+	}
+
+	hdr = header_at(buf, head);
+	*hdr = size;
+	*data = (uint8_t *)(hdr + 1);
+
+	return size;
+}
+
+int mpsc_ring_buf_put_finish(struct mpsc_ring_buf *buf, uint8_t *data,
+			     uint32_t size)
+{
+	volatile uint32_t *hdr = (uint32_t *)data - 1;
+	uint32_t claimed = *hdr;
+	uint32_t used, span;
+
+	ARG_UNUSED(buf);
+
+	if (unlikely(((claimed & HDR_VALID) != 0U) || (size > claimed))) {
+		return -EINVAL;
+	}
+
+	/* Hand the unused words over to the consumer as padding */
+	used = record_span(size);
+	span = record_span(claimed);
+	if (used < span) {
+		hdr[used / HDR_SIZE] = HDR_VALID | HDR_PAD |
+				       (span - used - HDR_SIZE);
+	}
+
+	/* Data must be visible before the header that publishes it */
+	__sync_synchronize();
+	*hdr = HDR_VALID | size;
+
+	return 0;
+}
+
+uint32_t mpsc_ring_buf_put(struct mpsc_ring_buf *buf, const uint8_t *data,
+			   uint32_t size)
+{
+	uint8_t *dst;
+	int err;
+
+	if (mpsc_ring_buf_put_claim(buf, &dst, size) == 0U) {
+		return 0;
+	}
+
+	memcpy(dst, data, size);
+
+	err = mpsc_ring_buf_put_finish(buf, dst, size);
+	__ASSERT_NO_MSG(err == 0);
+	ARG_UNUSED(err);
+
+	return size;
+}
+
+/* Clear a record and return its memory to the producers */
+static void release(struct mpsc_ring_buf *buf, volatile uint32_t *hdr,
+		    uint32_t span)
+{
+	(void)memset((void *)hdr, 0, span);
+	__sync_synchronize();
+	atomic_add(&buf->get_tail, (atomic_val_t)span);
+}
+
+/* Header of the oldest record with data, if it is committed. Padding
+ * and empty records in front of it are released on the way.
+ */
+static volatile uint32_t *get_record(struct mpsc_ring_buf *buf)
+{
+	while (true) {
+		volatile uint32_t *hdr = header_at(buf, atomic_get(&buf->get_tail));
+		uint32_t h = *hdr;
+
+		if ((h & HDR_VALID) == 0U) {
+			return NULL;
+		}
+
+		if (((h & HDR_PAD) == 0U) && ((h & HDR_LEN_MASK) != 0U)) {
+			/* Header must be read before the data it publishes */
+			__sync_synchronize();
+			return hdr;
+		}
+
+		release(buf, hdr, record_span(h & HDR_LEN_MASK));
+	}
+}
+
+uint32_t mpsc_ring_buf_get_claim(struct mpsc_ring_buf *buf, uint8_t **data,
+				 uint32_t size)
+{
+	volatile uint32_t *hdr = get_record(buf);
+	uint32_t start;
+
+	if (hdr == NULL) {
+		return 0;
+	}
+
+	start = buf->get_offset + buf->get_claimed;
+	size = MIN(size, (*hdr & HDR_LEN_MASK) - start);
+
+	*data = (uint8_t *)(hdr + 1) + start;
+	buf->get_claimed += size;
+
+	return size;
+}
+
+int mpsc_ring_buf_get_finish(struct mpsc_ring_buf *buf, uint32_t size)
+{
+	volatile uint32_t *hdr;
+	uint32_t len;
+
+	if (unlikely(size > buf->get_claimed)) {
+		return -EINVAL;
+	}
+
+	buf->get_offset += size;
+	buf->get_claimed = 0U;
+
+	if (size == 0U) {
+		return 0;
+	}
+
+	hdr = header_at(buf, atomic_get(&buf->get_tail));
+	len = *hdr & HDR_LEN_MASK;
+	if (buf->get_offset == len) {
+		release(buf, hdr, record_span(len));
+		buf->get_offset = 0U;
+	}
+
+	return 0;
+}
+
+uint32_t mpsc_ring_buf_get(struct mpsc_ring_buf *buf, uint8_t *data,
+			   uint32_t size)
+{
+	uint8_t *src;
+	uint32_t partial_size;
+	uint32_t total_size = 0U;
+	int err;
+
+	do {
+		partial_size = mpsc_ring_buf_get_claim(buf, &src, size);
+		if (data) {
+			memcpy(data, src, partial_size);
+			data += partial_size;
+		}
+		total_size += partial_size;
+		size -= partial_size;
+
+		err = mpsc_ring_buf_get_finish(buf, partial_size);
+		__ASSERT_NO_MSG(err == 0);
+		ARG_UNUSED(err);
+	} while (size && partial_size);
+
+	return total_size;
+}
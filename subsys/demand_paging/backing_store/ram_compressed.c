@@ -0,0 +1,323 @@
+/*
+ * Copyright (c) 2022 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Compressed RAM-based backing store implementation
+ */
+#include <mmu.h>
+#include <string.h>
+#include <kernel_arch_interface.h>
+#include <lz4.h>
+
+/*
+ * Evicted data pages are compressed with LZ4 and stored in as many
+ * fixed size chunks of the pool as needed. Chunks of a page need not be
+ * contiguous, they are gathered back into a buffer for decompression.
+ * Data pages made only of zeroes take no chunk, and data pages which do
+ * not compress by at least one chunk are stored as is.
+ *
+ * The kernel can't handle a failing page-out. Outside of page faults, a
+ * location is only handed out if the pool can take a full page, and
+ * that much is reserved until the page is actually stored. A page fault
+ * can't be refused though, and pages out the evicted data page before
+ * the faulting one is paged in and its chunks freed: if the pool is
+ * short of chunks then, the evicted page is kept as is in a spare page
+ * and moved to the pool as soon as chunks are freed. Only running out
+ * of both is fatal, which takes more data not compressing than the pool
+ * and the spare page can hold. As with the plain RAM backing store,
+ * locations and their chunks are freed as soon as pages are paged in,
+ * and Z_PAGE_FRAME_BACKED is never set.
+ */
+#define CHUNK_SIZE	CONFIG_BACKING_STORE_RAM_COMPRESSED_CHUNK_SIZE
+#define NUM_CHUNKS	(CONFIG_BACKING_STORE_RAM_COMPRESSED_POOL_SIZE / \
+			 CHUNK_SIZE)
+#define PAGE_CHUNKS	K_MEM_PAGING_COMPRESSED_PAGE_CHUNKS
+
+BUILD_ASSERT(((CHUNK_SIZE & (CHUNK_SIZE - 1)) == 0) &&
+	     CHUNK_SIZE <= CONFIG_MMU_PAGE_SIZE,
+	     "chunk size must be a power of two no larger than a page");
+BUILD_ASSERT(NUM_CHUNKS >= 2 * PAGE_CHUNKS,
+	     "pool must hold at least two uncompressed pages");
+BUILD_ASSERT(CONFIG_MMU_PAGE_SIZE <= UINT16_MAX,
+	     "page size must fit in page_slot.size");
+BUILD_ASSERT(PAGE_CHUNKS <= UINT8_MAX,
+	     "chunks per page must fit in page_slot.num_chunks");
+
+struct page_slot {
+	/* Compressed size, 0 for a zero page, a full page if raw */
+	uint16_t size;
+	uint8_t num_chunks;
+	bool stored;
+	/* Holds a full page of the pool until stored */
+	bool reserved;
+	void *chunks[PAGE_CHUNKS];
+};
+
+static struct page_slot slots[CONFIG_BACKING_STORE_RAM_PAGES];
+static struct k_mem_slab slot_slab;
+static unsigned int free_slots;
+
+static char __aligned(sizeof(void *)) pool[NUM_CHUNKS * CHUNK_SIZE];
+static struct k_mem_slab chunk_slab;
+/* Chunks neither used nor reserved by a location */
+static unsigned int free_chunks;
+
+/* Stored page the pool had no room for, if any */
+static char __aligned(sizeof(void *)) spare[CONFIG_MMU_PAGE_SIZE];
+static struct page_slot *spare_slot;
+
+/* Calls are serialized by the kernel, so these can be shared */
+static LZ4_stream_t lz4_state;
+static char buf[CONFIG_MMU_PAGE_SIZE];
+
+static struct k_mem_paging_compressed_stats_t stats;
+
+static struct page_slot *location_to_slot(uintptr_t location)
+{
+	__ASSERT(location % CONFIG_MMU_PAGE_SIZE == 0,
+		 "unaligned location 0x%lx", location);
+	__ASSERT(location <
+		 (CONFIG_BACKING_STORE_RAM_PAGES * CONFIG_MMU_PAGE_SIZE),
+		 "bad location 0x%lx, past bounds of backing store", location);
+
+	return &slots[location / CONFIG_MMU_PAGE_SIZE];
+}
+
+static uintptr_t slot_to_location(struct page_slot *slot)
+{
+	/* Locations end up in page tables, keep them page aligned */
+	return (slot - slots) * CONFIG_MMU_PAGE_SIZE;
+}
+
+static bool is_zero_page(const void *page)
+{
+	const uintptr_t *word = page;
+
+	for (size_t i = 0; i < CONFIG_MMU_PAGE_SIZE / sizeof(*word); i++) {
+		if (word[i] != 0U) {
+			return false;
+		}
+	}
+
+	return true;
+}
+
+/* Compress a data page into the pool, false if short of chunks for it */
+static bool slot_store(struct page_slot *slot, const void *page)
+{
+	const char *src = buf;
+	unsigned int num_chunks;
+	int size = 0;
+
+	if (!is_zero_page(page)) {
+		size = LZ4_compress_fast_extState(&lz4_state, page, buf,
+						  CONFIG_MMU_PAGE_SIZE,
+						  CONFIG_MMU_PAGE_SIZE -
+						  CHUNK_SIZE, 1);
+		if (size == 0) {
+			/* Would not save a single chunk */
+			src = page;
+			size = CONFIG_MMU_PAGE_SIZE;
+		}
+	}
+
+	num_chunks = ceiling_fraction(size, CHUNK_SIZE);
+	if (num_chunks > free_chunks) {
+		return false;
+	}
+
+	slot->size = size;
+	slot->num_chunks = num_chunks;
+	for (int i = 0; i < slot->num_chunks; i++) {
+		int ret = k_mem_slab_alloc(&chunk_slab, &slot->chunks[i],
+					   K_NO_WAIT);
+
+		__ASSERT(ret == 0, "chunk count mismatch");
+		(void)ret;
+		(void)memcpy(slot->chunks[i], src + i * CHUNK_SIZE,
+			     MIN(CHUNK_SIZE, size - i * CHUNK_SIZE));
+	}
+	free_chunks -= num_chunks;
+	slot->stored = true;
+
+	stats.pages++;
+	if (size == 0) {
+		stats.zero_pages++;
+	} else if (size == CONFIG_MMU_PAGE_SIZE) {
+		stats.raw_pages++;
+	}
+	stats.compressed_bytes += size;
+	stats.pool_bytes += slot->num_chunks * CHUNK_SIZE;
+	stats.chunks[slot->num_chunks]++;
+
+	return true;
+}
+
+int k_mem_paging_backing_store_location_get(struct z_page_frame *pf,
+					    uintptr_t *location,
+					    bool page_fault)
+{
+	struct page_slot *slot;
+	int ret;
+
+	/* Keep a location for page faults, like ram.c. They need no chunk
+	 * reserved, see k_mem_paging_backing_store_page_out().
+	 */
+	if (free_slots == 0U ||
+	    (!page_fault && (free_slots == 1U || free_chunks < PAGE_CHUNKS ||
+			     spare_slot != NULL))) {
+		return -ENOMEM;
+	}
+
+	ret = k_mem_slab_alloc(&slot_slab, (void **)&slot, K_NO_WAIT);
+	__ASSERT(ret == 0, "slot count mismatch");
+	(void)ret;
+	free_slots--;
+
+	slot->stored = false;
+	slot->reserved = !page_fault;
+	if (slot->reserved) {
+		free_chunks -= PAGE_CHUNKS;
+	}
+	slot->num_chunks = 0U;
+	*location = slot_to_location(slot);
+
+	return 0;
+}
+
+void k_mem_paging_backing_store_location_free(uintptr_t location)
+{
+	struct page_slot *slot = location_to_slot(location);
+
+	if (slot == spare_slot) {
+		spare_slot = NULL;
+		stats.spare_pages--;
+	} else if (slot->stored) {
+		for (int i = 0; i < slot->num_chunks; i++) {
+			k_mem_slab_free(&chunk_slab, &slot->chunks[i]);
+		}
+		free_chunks += slot->num_chunks;
+
+		stats.pages--;
+		if (slot->size == 0U) {
+			stats.zero_pages--;
+		} else if (slot->size == CONFIG_MMU_PAGE_SIZE) {
+			stats.raw_pages--;
+		}
+		stats.compressed_bytes -= slot->size;
+		stats.pool_bytes -= slot->num_chunks * CHUNK_SIZE;
+		stats.chunks[slot->num_chunks]--;
+	} else if (slot->reserved) {
+		/* Never paged out, give back the reservation */
+		free_chunks += PAGE_CHUNKS;
+	}
+
+	k_mem_slab_free(&slot_slab, (void **)&slot);
+	free_slots++;
+
+	if (spare_slot != NULL && slot_store(spare_slot, spare)) {
+		spare_slot = NULL;
+		stats.spare_pages--;
+	}
+}
+
+void k_mem_paging_backing_store_page_out(uintptr_t location)
+{
+	struct page_slot *slot = location_to_slot(location);
+
+	if (slot->reserved) {
+		free_chunks += PAGE_CHUNKS;
+		slot->reserved = false;
+	}
+
+	if (slot_store(slot, Z_SCRATCH_PAGE)) {
+		return;
+	}
+
+	/* Only a page fault gets there, the faulting data page still holding
+	 * its chunks. Keep this one as is until they are freed.
+	 */
+	if (spare_slot != NULL) {
+		/* More data not compressing than the pool and the spare
+		 * page can hold, nowhere left to put it.
+		 */
+		k_panic();
+	}
+	(void)memcpy(spare, Z_SCRATCH_PAGE, CONFIG_MMU_PAGE_SIZE);
+	spare_slot = slot;
+	slot->size = CONFIG_MMU_PAGE_SIZE;
+	slot->num_chunks = 0U;
+	slot->stored = true;
+	stats.spare_pages++;
+}
+
+static void slot_read(struct page_slot *slot, void *dest)
+{
+	char *dst = slot->size == CONFIG_MMU_PAGE_SIZE ? dest : buf;
+	int ret;
+
+	__ASSERT(slot->stored, "reading a page never paged out");
+
+	if (slot == spare_slot) {
+		(void)memcpy(dest, spare, CONFIG_MMU_PAGE_SIZE);
+		return;
+	}
+
+	if (slot->size == 0U) {
+		(void)memset(dest, 0, CONFIG_MMU_PAGE_SIZE);
+		return;
+	}
+
+	for (int i = 0; i < slot->num_chunks; i++) {
+		(void)memcpy(dst + i * CHUNK_SIZE, slot->chunks[i],
+			     MIN(CHUNK_SIZE, slot->size - i * CHUNK_SIZE));
+	}
+
+	if (dst == buf) {
+		ret = LZ4_decompress_safe(buf, dest, slot->size,
+					  CONFIG_MMU_PAGE_SIZE);
+		__ASSERT(ret == CONFIG_MMU_PAGE_SIZE,
+			 "corrupted page at 0x%lx", slot_to_location(slot));
+		(void)ret;
+	}
+}
+
+void k_mem_paging_backing_store_page_in(uintptr_t location)
+{
+	slot_read(location_to_slot(location), Z_SCRATCH_PAGE);
+}
+
+void k_mem_paging_backing_store_page_in_batch(const uintptr_t *locations,
+					      void *const *dests,
+					      size_t count)
+{
+	for (size_t i = 0; i < count; i++) {
+		slot_read(location_to_slot(locations[i]), dests[i]);
+	}
+}
+
+void k_mem_paging_backing_store_page_finalize(struct z_page_frame *pf,
+					      uintptr_t location)
+{
+	k_mem_paging_backing_store_location_free(location);
+}
+
+void k_mem_paging_compressed_stats_get(
+	struct k_mem_paging_compressed_stats_t *stats_ptr)
+{
+	unsigned int key = irq_lock();
+
+	*stats_ptr = stats;
+	irq_unlock(key);
+}
+
+void k_mem_paging_backing_store_init(void)
+{
+	k_mem_slab_init(&slot_slab, slots, sizeof(slots[0]),
+			CONFIG_BACKING_STORE_RAM_PAGES);
+	free_slots = CONFIG_BACKING_STORE_RAM_PAGES;
+
+	k_mem_slab_init(&chunk_slab, pool, CHUNK_SIZE, NUM_CHUNKS);
+	free_chunks = NUM_CHUNKS;
+}
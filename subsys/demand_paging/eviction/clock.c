@@ -0,0 +1,84 @@
+/*
+ * Copyright (c) 2022 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Clock (second chance) eviction algorithm for demand paging
+ */
+#include <zephyr/kernel.h>
+#include <mmu.h>
+#include <kernel_arch_interface.h>
+
+/* The page frames form a circle with a hand pointing at the next
+ * candidate. Each evictable frame the hand passes gets its accessed
+ * bit cleared: if the bit was set the frame gets a second chance,
+ * otherwise it is evicted, unless it is dirty in which case the hand
+ * keeps looking for a clean one for a while. Nothing runs periodically
+ * and each selection examines at most CONFIG_EVICTION_CLOCK_MAX_SCAN
+ * evictable frames, so the time spent with interrupts locked does not
+ * grow with the number of page frames.
+ */
+static size_t hand;
+
+struct z_page_frame *k_mem_paging_eviction_select(bool *dirty_ptr)
+{
+	struct z_page_frame *pf, *dirty_pf = NULL, *accessed_pf = NULL;
+	bool accessed_dirty = false;
+	unsigned int scanned = 0U;
+	uintptr_t flags;
+
+	/* Two revolutions clear every accessed bit along the way */
+	for (size_t i = 0; i < 2 * Z_NUM_PAGE_FRAMES; i++) {
+		pf = &z_page_frames[hand];
+		hand = (hand + 1 == Z_NUM_PAGE_FRAMES) ? 0 : hand + 1;
+
+		if (!z_page_frame_is_evictable(pf)) {
+			continue;
+		}
+
+		flags = arch_page_info_get(pf->addr, NULL, true);
+
+		/* Implies a mismatch with page frame ontology and page
+		 * tables
+		 */
+		__ASSERT((flags & ARCH_DATA_PAGE_LOADED) != 0U,
+			 "non-present page, %s",
+			 ((flags & ARCH_DATA_PAGE_NOT_MAPPED) != 0U) ?
+			 "un-mapped" : "paged out");
+
+		if ((flags & ARCH_DATA_PAGE_ACCESSED) != 0UL) {
+			/* Second chance; it is the victim if the budget
+			 * runs out before anything better comes along.
+			 */
+			if (accessed_pf == NULL) {
+				accessed_pf = pf;
+				accessed_dirty = (flags & ARCH_DATA_PAGE_DIRTY) != 0UL;
+			}
+		} else if ((flags & ARCH_DATA_PAGE_DIRTY) == 0UL) {
+			*dirty_ptr = false;
+			return pf;
+		} else if (dirty_pf == NULL) {
+			dirty_pf = pf;
+		}
+
+		if (++scanned == CONFIG_EVICTION_CLOCK_MAX_SCAN) {
+			break;
+		}
+	}
+
+	if (dirty_pf != NULL) {
+		*dirty_ptr = true;
+		return dirty_pf;
+	}
+
+	/* Shouldn't ever happen unless every page is pinned */
+	__ASSERT(accessed_pf != NULL, "no page to evict");
+
+	*dirty_ptr = accessed_dirty;
+
+	return accessed_pf;
+}
+
+void k_mem_paging_eviction_init(void)
+{
+}
@@ -61,8 +61,145 @@ static int cmd_kernel_cycles(const struct shell *shell,
 	return 0;
 }
 
+#if defined(CONFIG_IDLE_STATS)
+static int cmd_kernel_idle(const struct shell *shell,
+			   size_t argc, char **argv)
+{
+	struct k_idle_wakeup wakeups[CONFIG_IDLE_STATS_WAKEUP_SOURCES];
+	struct k_idle_stats stats;
+	int n;
+
+	if ((argc > 1) && (strcmp(argv[1], "reset") == 0)) {
+		k_idle_stats_reset();
+		return 0;
+	} else if (argc > 1) {
+		shell_error(shell, "Unknown argument: %s", argv[1]);
+		return -EINVAL;
+	}
+
+	for (int cpu = 0; cpu < arch_num_cpus(); cpu++) {
+		(void)k_idle_stats_get(cpu, &stats);
+
+		/* No %llu, see shell_tdata_dump() */
+		shell_print(shell, "CPU %d: idle %u ms, longest %u us", cpu,
+			    (uint32_t)(stats.idle_us / 1000U), stats.longest_us);
+		shell_print(shell, "\twakeups: timeout %u, tick %u, other %u",
+			    stats.timeout_wakeups, stats.tick_wakeups,
+			    stats.other_wakeups);
+
+		for (int i = 0; i < K_IDLE_STATS_BUCKETS; i++) {
+			if (stats.periods[i] == 0) {
+				continue;
+			}
+
+			if (i == K_IDLE_STATS_BUCKETS - 1) {
+				shell_print(shell, "\t>= %u us:\t%u", 1U << i,
+					    stats.periods[i]);
+			} else {
+				shell_print(shell, "\t< %u us:\t%u", 1U << (i + 1),
+					    stats.periods[i]);
+			}
+		}
+	}
+
+	n = k_idle_wakeups_get(wakeups, ARRAY_SIZE(wakeups));
+	shell_print(shell, "Top wakeup timeouts:");
+	for (int i = 0; i < n; i++) {
+		shell_print(shell, "\tfn %p last %p count %u", (void *)wakeups[i].fn,
+			    wakeups[i].last, wakeups[i].count);
+	}
+
+	return 0;
+}
+#endif
+
+#if defined(CONFIG_LOCK_STATS)
+#define LOCK_STATS_MAX_TOP 10
+
+static int cmd_kernel_locks(const struct shell *shell,
+			    size_t argc, char **argv)
+{
+	struct k_lock_stats stats[LOCK_STATS_MAX_TOP];
+	int n = LOCK_STATS_MAX_TOP;
+
+	if ((argc > 1) && (strcmp(argv[1], "reset") == 0)) {
+		k_lock_stats_reset();
+		return 0;
+	} else if (argc > 1) {
+		char *end;
+
+		n = strtol(argv[1], &end, 10);
+		if ((*end != '\0') || (n < 1) || (n > LOCK_STATS_MAX_TOP)) {
+			shell_error(shell, "Count must be 1 to %d",
+				    LOCK_STATS_MAX_TOP);
+			return -EINVAL;
+		}
+	}
+
+	n = k_lock_stats_get(stats, n);
+
+	/* No %llu, see shell_tdata_dump() */
+	shell_print(shell, "%-10s %-8s %10s %10s %10s %10s %s", "lock", "type",
+		    "taken", "contended", "wait", "max hold", "from");
+	for (int i = 0; i < n; i++) {
+		shell_print(shell, "%p %-8s %10u %10u %10u %10u %p",
+			    stats[i].lock,
+			    stats[i].mutex ? "mutex" : "spinlock",
+			    stats[i].acquisitions, stats[i].contended,
+			    (uint32_t)MIN(stats[i].wait_cycles, UINT32_MAX),
+			    stats[i].max_hold_cycles, stats[i].max_hold_site);
+	}
+
+	return 0;
+}
+#endif
+
 #if defined(CONFIG_INIT_STACKS) && defined(CONFIG_THREAD_STACK_INFO) && \
 	defined(CONFIG_THREAD_MONITOR)
+#ifdef CONFIG_SCHED_THREAD_LATENCY
+/* Upper bound of the histogram bucket holding the given percentile */
+static uint32_t latency_percentile(const k_thread_latency_stats_t *stats,
+				   uint32_t count, uint32_t pcnt)
+{
+	uint32_t rank = (count * pcnt + 99U) / 100U;
+	uint32_t seen = 0U;
+
+	for (int i = 0; i < K_THREAD_LATENCY_BUCKETS - 1; i++) {
+		seen += stats->hist[i];
+		if (seen >= rank) {
+			return MIN(1U << i, stats->max_cycles);
+		}
+	}
+
+	return stats->max_cycles;
+}
+
+static void shell_latency_dump(const struct shell *shell,
+			       struct k_thread *thread)
+{
+	k_thread_latency_stats_t stats;
+	uint32_t count = 0U;
+
+	if (k_thread_latency_stats_get(thread, &stats) != 0) {
+		return;
+	}
+
+	for (int i = 0; i < K_THREAD_LATENCY_BUCKETS; i++) {
+		count += stats.hist[i];
+	}
+
+	if (count == 0U) {
+		shell_print(shell, "\tScheduling latency: none recorded");
+		return;
+	}
+
+	shell_print(shell, "\tScheduling latency: %u wakeups, p50 <= %u, "
+		    "p99 <= %u, max %u cycles", count,
+		    latency_percentile(&stats, count, 50U),
+		    latency_percentile(&stats, count, 99U), stats.max_cycles);
+}
+#endif
+
 static void shell_tdata_dump(const struct k_thread *cthread, void *user_data)
 {
 	struct k_thread *thread = (struct k_thread *)cthread;
@@ -137,6 +274,10 @@ static void shell_tdata_dump(const struct k_thread *cthread, void *user_data)
 	}
 #endif
 
+#ifdef CONFIG_SCHED_THREAD_LATENCY
+	shell_latency_dump(shell, thread);
+#endif
+
 	ret = k_thread_stack_space_get(thread, &unused);
 	if (ret) {
 		shell_print(shell,
@@ -322,6 +463,14 @@ SHELL_STATIC_SUBCMD_SET_CREATE(sub_kernel_reboot,
 
 SHELL_STATIC_SUBCMD_SET_CREATE(sub_kernel,
 	SHELL_CMD(cycles, NULL, "Kernel cycles.", cmd_kernel_cycles),
+#if defined(CONFIG_IDLE_STATS)
+	SHELL_CMD_ARG(idle, NULL, "Idle statistics and wakeup sources.\n"
+		      "Usage: idle [reset]", cmd_kernel_idle, 1, 1),
+#endif
+#if defined(CONFIG_LOCK_STATS)
+	SHELL_CMD_ARG(locks, NULL, "Most contended locks, times in cycles.\n"
+		      "Usage: locks [<count>|reset]", cmd_kernel_locks, 1, 1),
+#endif
 #if defined(CONFIG_REBOOT)
 	SHELL_CMD(reboot, &sub_kernel_reboot, "Reboot.", NULL),
 #endif
@@ -0,0 +1,113 @@
+/*
+ * Copyright (c) 2022 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/printk.h>
+#include <zephyr/sys/bitarray.h>
+#include <zephyr/random/rand32.h>
+
+/* sys_bitarray_alloc() latency benchmark, see README.rst */
+
+#define N_ALLOCS 64
+
+SYS_BITARRAY_DEFINE_STATIC(ba_1k, 1024);
+SYS_BITARRAY_DEFINE_STATIC(ba_16k, 16 * 1024);
+SYS_BITARRAY_DEFINE_STATIC(ba_256k, 256 * 1024);
+SYS_BITARRAY_DEFINE_STATIC(ba_1m, 1024 * 1024);
+
+static sys_bitarray_t *const bitarrays[] = { &ba_1k, &ba_16k, &ba_256k, &ba_1m };
+
+static const uint32_t fills[] = { 0, 50, 90, 99 };
+
+static const uint32_t sizes[] = { 1, 8, 64 };
+
+enum pattern { SCATTERED, PREFIX };
+
+static const char *const pattern_names[] = { "scattered", "prefix" };
+
+static size_t offsets[N_ALLOCS];
+
+/* Allocate about fill percent of the bits */
+static void fragment(sys_bitarray_t *ba, enum pattern pattern, uint32_t fill)
+{
+	size_t pos = 0;
+
+	(void)sys_bitarray_clear_region(ba, ba->num_bits, 0);
+
+	if (fill == 0) {
+		return;
+	}
+
+	if (pattern == PREFIX) {
+		(void)sys_bitarray_set_region(ba, ba->num_bits / 100 * fill, 0);
+		return;
+	}
+
+	/* Runs of 1 to 15 allocated bits, separated by free runs of
+	 * random lengths averaging to the fill ratio: 8 * (100 - fill) / fill
+	 * bits, in hundredths of bits rounded randomly.
+	 */
+	while (true) {
+		size_t run = 1 + sys_rand32_get() % 15;
+		size_t gap_100 = sys_rand32_get() % (2 * 800 * (100 - fill) / fill + 1);
+		size_t gap = (gap_100 + sys_rand32_get() % 100) / 100;
+
+		pos += gap;
+		if (pos + run > ba->num_bits) {
+			break;
+		}
+
+		(void)sys_bitarray_set_region(ba, run, pos);
+		pos += run;
+	}
+}
+
+static void run(sys_bitarray_t *ba, enum pattern pattern, uint32_t fill,
+		uint32_t size)
+{
+	uint32_t start, cycles;
+	int allocated = 0;
+
+	fragment(ba, pattern, fill);
+
+	start = k_cycle_get_32();
+	for (int i = 0; i < N_ALLOCS; i++) {
+		if (sys_bitarray_alloc(ba, size, &offsets[allocated]) == 0) {
+			allocated++;
+		}
+	}
+	cycles = k_cycle_get_32() - start;
+
+	for (int i = 0; i < allocated; i++) {
+		(void)sys_bitarray_free(ba, size, offsets[i]);
+	}
+
+	printk("bitarray n %7u %-9s fill %2u%% alloc %2u: %9u cycles",
+	       ba->num_bits, pattern_names[pattern], fill, size,
+	       cycles / N_ALLOCS);
+	if (allocated < N_ALLOCS) {
+		printk(" (%d failed)", N_ALLOCS - allocated);
+	}
+	printk("\n");
+}
+
+void main(void)
+{
+	printk("summary %s\n",
+	       IS_ENABLED(CONFIG_SYS_BITARRAY_SUMMARY) ? "on" : "off");
+
+	for (int i = 0; i < ARRAY_SIZE(bitarrays); i++) {
+		for (int p = SCATTERED; p <= PREFIX; p++) {
+			for (int f = 0; f < ARRAY_SIZE(fills); f++) {
+				for (int s = 0; s < ARRAY_SIZE(sizes); s++) {
+					run(bitarrays[i], p, fills[f], sizes[s]);
+				}
+			}
+		}
+	}
+
+	printk("fin\n");
+}
@@ -0,0 +1,81 @@
+/*
+ * Copyright (c) 2022 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/printk.h>
+#include <zephyr/sys/crc.h>
+#include <zephyr/random/rand32.h>
+
+/* CRC throughput benchmark, see README.rst */
+
+#define BUF_SIZE 4096
+#define BYTES_PER_RUN (512 * 1024)
+
+static const size_t sizes[] = { 16, 64, 256, 1024, BUF_SIZE };
+
+static uint8_t buf[BUF_SIZE];
+
+static uint32_t run_crc32_ieee(const uint8_t *data, size_t len)
+{
+	return crc32_ieee(data, len);
+}
+
+static uint32_t run_crc32_c(const uint8_t *data, size_t len)
+{
+	return crc32_c(0, data, len, true, true);
+}
+
+static uint32_t run_crc16_ccitt(const uint8_t *data, size_t len)
+{
+	return crc16_ccitt(0xffff, data, len);
+}
+
+static const struct {
+	const char *name;
+	uint32_t (*fn)(const uint8_t *data, size_t len);
+} algos[] = {
+	{ "crc32_ieee", run_crc32_ieee },
+	{ "crc32_c", run_crc32_c },
+	{ "crc16_ccitt", run_crc16_ccitt },
+};
+
+/* Keeps the results alive */
+static volatile uint32_t sink;
+
+static void run(int algo, size_t size)
+{
+	size_t n = BYTES_PER_RUN / size;
+	uint32_t start, cycles, crc = 0;
+
+	start = k_cycle_get_32();
+	for (size_t i = 0; i < n; i++) {
+		crc ^= algos[algo].fn(buf, size);
+	}
+	cycles = k_cycle_get_32() - start;
+	sink = crc;
+
+	printk("%-11s size %5zu MB/s %6u\n", algos[algo].name, size,
+	       (uint32_t)((uint64_t)n * size * sys_clock_hw_cycles_per_sec() /
+			  MAX(cycles, 1U) / 1000000U));
+}
+
+void main(void)
+{
+	sys_rand_get(buf, sizeof(buf));
+
+	printk("CRC32: %s%s\n",
+	       IS_ENABLED(CONFIG_CRC32_SLICING_BY_8) ? "slicing-by-8" :
+	       IS_ENABLED(CONFIG_CRC32_SLICING_BY_4) ? "slicing-by-4" : "nibble",
+	       IS_ENABLED(CONFIG_CRC32_X86) ? " + x86" : "");
+
+	for (int a = 0; a < ARRAY_SIZE(algos); a++) {
+		for (int s = 0; s < ARRAY_SIZE(sizes); s++) {
+			run(a, sizes[s]);
+		}
+	}
+
+	printk("fin\n");
+}
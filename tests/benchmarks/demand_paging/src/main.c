@@ -0,0 +1,115 @@
+/*
+ * Copyright (c) 2022 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/printk.h>
+#include <zephyr/sys/mem_manage.h>
+#include <zephyr/random/rand32.h>
+
+/* Demand paging eviction benchmark, see README.rst */
+
+#define N_ACCESSES 4096
+#define TIMER_PERIOD_MS 1
+
+/* Map the free RAM plus half of the backing store */
+#define EXTRA_PAGES ((CONFIG_BACKING_STORE_RAM_PAGES - 1) / 2)
+
+enum pattern { HOT, SWEEP, RANDOM };
+
+static const char *const pattern_names[] = { "hot", "sweep", "random" };
+
+static uint8_t *arena;
+static size_t arena_pages;
+
+static uint32_t last_expiry;
+static uint32_t max_delay;
+
+static void timer_fn(struct k_timer *timer)
+{
+	uint32_t now = k_cycle_get_32();
+
+	ARG_UNUSED(timer);
+
+	if ((last_expiry != 0U) && (now - last_expiry > max_delay)) {
+		max_delay = now - last_expiry;
+	}
+	last_expiry = now;
+}
+
+static K_TIMER_DEFINE(timer, timer_fn, NULL);
+
+static size_t next_page(enum pattern pattern, int i)
+{
+	switch (pattern) {
+	case HOT:
+		/* Three accesses out of four go to the first quarter */
+		if ((sys_rand32_get() % 4) != 0) {
+			return sys_rand32_get() % (arena_pages / 4);
+		}
+		return sys_rand32_get() % arena_pages;
+	case SWEEP:
+		return i % arena_pages;
+	default:
+		return sys_rand32_get() % arena_pages;
+	}
+}
+
+static void run(enum pattern pattern)
+{
+	struct k_mem_paging_stats_t stats;
+	unsigned long faults;
+
+	k_mem_paging_stats_get(&stats);
+	faults = stats.pagefaults.cnt;
+
+	last_expiry = 0U;
+	max_delay = 0U;
+	k_timer_start(&timer, K_MSEC(TIMER_PERIOD_MS), K_MSEC(TIMER_PERIOD_MS));
+
+	for (int i = 0; i < N_ACCESSES; i++) {
+		volatile uint8_t *p = &arena[next_page(pattern, i) *
+					     CONFIG_MMU_PAGE_SIZE];
+
+		/* Dirty every other page touched */
+		if ((i % 2) == 0) {
+			*p = (uint8_t)i;
+		} else {
+			(void)*p;
+		}
+	}
+
+	k_timer_stop(&timer);
+
+	k_mem_paging_stats_get(&stats);
+	faults = stats.pagefaults.cnt - faults;
+
+	printk("pattern %-6s faults/1k %4u max timer delay %5u us\n",
+	       pattern_names[pattern], (uint32_t)(faults * 1000U / N_ACCESSES),
+	       (max_delay == 0U) ? 0U :
+	       k_cyc_to_us_ceil32(max_delay) - TIMER_PERIOD_MS * USEC_PER_MSEC);
+}
+
+void main(void)
+{
+	size_t size = k_mem_free_get() + EXTRA_PAGES * CONFIG_MMU_PAGE_SIZE;
+
+	printk("Eviction algorithm: %s\n",
+	       IS_ENABLED(CONFIG_EVICTION_CLOCK) ? "clock" :
+	       IS_ENABLED(CONFIG_EVICTION_NRU) ? "nru" : "custom");
+
+	arena = k_mem_map(size, K_MEM_PERM_RW);
+	if (arena == NULL) {
+		printk("failed to map %zu bytes\n", size);
+		return;
+	}
+	arena_pages = size / CONFIG_MMU_PAGE_SIZE;
+
+	for (int p = HOT; p <= RANDOM; p++) {
+		run(p);
+	}
+
+	printk("fin\n");
+}
@@ -0,0 +1,119 @@
+/*
+ * Copyright (c) 2022 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/irq_offload.h>
+#include <zephyr/sys/printk.h>
+
+/* k_fifo ISR-to-thread and thread-to-thread throughput, see README.rst */
+
+#define MAX_BURST 64
+#define N_ITEMS 8192
+#define STACK_SIZE 1024
+#define PRODUCER_PRIO K_PRIO_PREEMPT(1)
+#define CONSUMER_PRIO K_PRIO_PREEMPT(2)
+
+struct item {
+	void *fifo_reserved;
+	uint32_t seq;
+};
+
+static struct item items[MAX_BURST];
+
+static K_FIFO_DEFINE(fifo);
+static K_SEM_DEFINE(drained_sem, 0, 1);
+
+static K_THREAD_STACK_DEFINE(consumer_stack, STACK_SIZE);
+static struct k_thread consumer_thread;
+
+static int burst;
+
+static void isr_put(const void *arg)
+{
+	int n = POINTER_TO_INT(arg);
+
+	for (int i = 0; i < n; i++) {
+		k_fifo_put(&fifo, &items[i]);
+	}
+}
+
+static uint32_t run_isr(int n)
+{
+	uint32_t start = k_cycle_get_32();
+
+	for (int done = 0; done < N_ITEMS; done += n) {
+		irq_offload(isr_put, INT_TO_POINTER(n));
+		for (int i = 0; i < n; i++) {
+			(void)k_fifo_get(&fifo, K_NO_WAIT);
+		}
+	}
+
+	return k_cycle_get_32() - start;
+}
+
+static void consumer_fn(void *p1, void *p2, void *p3)
+{
+	ARG_UNUSED(p1);
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	while (true) {
+		for (int i = 0; i < burst; i++) {
+			(void)k_fifo_get(&fifo, K_FOREVER);
+		}
+		k_sem_give(&drained_sem);
+	}
+}
+
+static uint32_t run_thread(int n)
+{
+	uint32_t start, cycles;
+
+	/* The consumer only exists here, so that it doesn't steal the
+	 * items put by the ISR.
+	 */
+	burst = n;
+	k_thread_create(&consumer_thread, consumer_stack, STACK_SIZE,
+			consumer_fn, NULL, NULL, NULL, CONSUMER_PRIO, 0,
+			K_NO_WAIT);
+
+	start = k_cycle_get_32();
+	for (int done = 0; done < N_ITEMS; done += n) {
+		for (int i = 0; i < n; i++) {
+			k_fifo_put(&fifo, &items[i]);
+		}
+		k_sem_take(&drained_sem, K_FOREVER);
+	}
+	cycles = k_cycle_get_32() - start;
+
+	k_thread_abort(&consumer_thread);
+
+	return cycles;
+}
+
+static uint32_t items_per_sec(uint32_t cycles)
+{
+	return (uint32_t)((uint64_t)N_ITEMS * sys_clock_hw_cycles_per_sec() /
+			  cycles);
+}
+
+void main(void)
+{
+	printk("Lock-free k_queue append: %s\n",
+	       IS_ENABLED(CONFIG_QUEUE_LOCKFREE_APPEND) ? "on" : "off");
+
+	k_thread_priority_set(k_current_get(), PRODUCER_PRIO);
+
+	for (int n = 1; n <= MAX_BURST; n *= 4) {
+		uint32_t isr_cycles = run_isr(n);
+		uint32_t thread_cycles = run_thread(n);
+
+		printk("burst %3d isr %8u items/s thread %8u items/s\n", n,
+		       items_per_sec(isr_cycles), items_per_sec(thread_cycles));
+	}
+
+	printk("fin\n");
+}
@@ -0,0 +1,177 @@
+/*
+ * Copyright (c) 2022 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/printk.h>
+#include <zephyr/sys/hash_map.h>
+#include <zephyr/sys/rb.h>
+#include <zephyr/sys/slist.h>
+#include <zephyr/random/rand32.h>
+
+/* Hash map vs rbtree vs slist benchmark, see README.rst */
+
+#define MAX_N 10000
+#define MAX_CAPACITY 16384
+
+struct obj {
+	struct rbnode rb;
+	sys_snode_t sn;
+	uint32_t key;
+};
+
+static const uint32_t counts[] = { 10, 100, 1000, MAX_N };
+
+static struct obj objs[MAX_N];
+static uint32_t order[MAX_N];
+
+static struct sys_hash_map_slot slots[MAX_CAPACITY];
+static struct sys_hash_map map;
+static struct rbtree tree;
+static sys_slist_t list;
+
+/* Keeps the lookup results alive */
+static volatile uintptr_t sink;
+
+static void shuffle(uint32_t n)
+{
+	for (uint32_t i = 0; i < n; i++) {
+		order[i] = i;
+	}
+
+	for (uint32_t i = n - 1; i > 0; i--) {
+		uint32_t j = sys_rand32_get() % (i + 1);
+		uint32_t tmp = order[i];
+
+		order[i] = order[j];
+		order[j] = tmp;
+	}
+}
+
+static bool obj_lessthan(struct rbnode *a, struct rbnode *b)
+{
+	return CONTAINER_OF(a, struct obj, rb)->key <
+	       CONTAINER_OF(b, struct obj, rb)->key;
+}
+
+static struct obj *rb_find(uint32_t key)
+{
+	struct rbnode *n = tree.root;
+
+	while (n != NULL) {
+		struct obj *o = CONTAINER_OF(n, struct obj, rb);
+
+		if (o->key == key) {
+			return o;
+		}
+		n = z_rb_child(n, o->key < key);
+	}
+
+	return NULL;
+}
+
+static struct obj *slist_find(uint32_t key)
+{
+	struct obj *o;
+
+	SYS_SLIST_FOR_EACH_CONTAINER(&list, o, sn) {
+		if (o->key == key) {
+			return o;
+		}
+	}
+
+	return NULL;
+}
+
+enum container { HASH_MAP, RBTREE, SLIST };
+
+static const char *const names[] = { "hash_map", "rbtree", "slist" };
+
+enum op { INSERT, LOOKUP, REMOVE };
+
+static void do_op(enum container c, enum op op, struct obj *o)
+{
+	switch (c) {
+	case HASH_MAP:
+		if (op == INSERT) {
+			(void)sys_hash_map_insert(&map, o->key, o, NULL);
+		} else if (op == LOOKUP) {
+			sink = (uintptr_t)sys_hash_map_get(&map, o->key);
+		} else {
+			(void)sys_hash_map_remove(&map, o->key);
+		}
+		break;
+	case RBTREE:
+		if (op == INSERT) {
+			rb_insert(&tree, &o->rb);
+		} else if (op == LOOKUP) {
+			sink = (uintptr_t)rb_find(o->key);
+		} else {
+			rb_remove(&tree, &o->rb);
+		}
+		break;
+	default:
+		if (op == INSERT) {
+			sys_slist_append(&list, &o->sn);
+		} else if (op == LOOKUP) {
+			sink = (uintptr_t)slist_find(o->key);
+		} else {
+			(void)sys_slist_find_and_remove(&list, &o->sn);
+		}
+		break;
+	}
+}
+
+static uint32_t time_ops(enum container c, enum op op, uint32_t n)
+{
+	uint32_t start, cycles;
+
+	shuffle(n);
+
+	start = k_cycle_get_32();
+	for (uint32_t i = 0; i < n; i++) {
+		do_op(c, op, &objs[order[i]]);
+	}
+	cycles = k_cycle_get_32() - start;
+
+	return cycles / n;
+}
+
+static void run(enum container c, uint32_t n)
+{
+	uint32_t capacity = 1;
+	uint32_t insert, lookup, remove;
+
+	while (capacity * 3 < n * 4) {
+		capacity *= 2;
+	}
+	sys_hash_map_init_fixed(&map, SYS_HASH_MAP_KEY_INT, slots, capacity);
+	sys_slist_init(&list);
+
+	insert = time_ops(c, INSERT, n);
+	lookup = time_ops(c, LOOKUP, n);
+	remove = time_ops(c, REMOVE, n);
+
+	printk("%-8s n %5u insert %6u lookup %6u remove %6u cycles/op\n",
+	       names[c], n, insert, lookup, remove);
+}
+
+void main(void)
+{
+	tree.lessthan_fn = obj_lessthan;
+
+	/* Distinct keys, spread over the whole range */
+	for (uint32_t i = 0; i < MAX_N; i++) {
+		objs[i].key = i * 2654435761U;
+	}
+
+	for (int i = 0; i < ARRAY_SIZE(counts); i++) {
+		for (int c = HASH_MAP; c <= SLIST; c++) {
+			run(c, counts[i]);
+		}
+	}
+
+	printk("fin\n");
+}
@@ -0,0 +1,186 @@
+/*
+ * Copyright (c) 2022 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <string.h>
+#include <zephyr/kernel.h>
+#include <zephyr/sys/printk.h>
+#include <zephyr/data/json.h>
+#include <zephyr/random/rand32.h>
+
+/* json_obj_parse() vs streaming parser benchmark, see README.rst */
+
+#define N_ITEMS 64
+#define ITERATIONS 20
+#define STACK_SIZE 2048
+
+/* The parsers size array elements rounding each field up to the
+ * alignment of the enclosing struct, which only matches the C layout of
+ * this one with 32-bit pointers: see testcase.yaml.
+ */
+struct item {
+	int32_t id;
+	const char *name;
+	int32_t value;
+	bool enabled;
+};
+
+struct doc {
+	const char *name;
+	struct item items[N_ITEMS];
+	size_t items_len;
+};
+
+static const struct json_obj_descr item_descr[] = {
+	JSON_OBJ_DESCR_PRIM(struct item, id, JSON_TOK_NUMBER),
+	JSON_OBJ_DESCR_PRIM(struct item, name, JSON_TOK_STRING),
+	JSON_OBJ_DESCR_PRIM(struct item, value, JSON_TOK_NUMBER),
+	JSON_OBJ_DESCR_PRIM(struct item, enabled, JSON_TOK_TRUE),
+};
+
+static const struct json_obj_descr doc_descr[] = {
+	JSON_OBJ_DESCR_PRIM(struct doc, name, JSON_TOK_STRING),
+	JSON_OBJ_DESCR_OBJ_ARRAY(struct doc, items, N_ITEMS, items_len,
+				 item_descr, ARRAY_SIZE(item_descr)),
+};
+
+static const size_t chunks[] = { 16, 64, 512 };
+
+static char document[N_ITEMS * 128];
+static size_t document_len;
+
+/* Copy of the document json_obj_parse() works on, as it modifies it */
+static char payload[sizeof(document)];
+static char stream_buf[1024];
+static size_t stream_buf_size;
+
+static struct doc doc;
+
+static K_THREAD_STACK_DEFINE(bench_stack, STACK_SIZE);
+static struct k_thread bench_thread;
+
+static void generate(void)
+{
+	size_t len;
+
+	len = snprintk(document, sizeof(document), "{\"name\":\"benchmark\",\"items\":[");
+	for (int i = 0; i < N_ITEMS; i++) {
+		len += snprintk(&document[len], sizeof(document) - len,
+				"%s{\"id\":%d,\"name\":\"item %d\","
+				"\"description\":\"generated item number %d\","
+				"\"value\":%d,\"enabled\":%s}",
+				(i > 0) ? ",\n  " : "\n  ", i, i, i,
+				(int32_t)(sys_rand32_get() >> 8) - (1 << 23),
+				(sys_rand32_get() & 1) ? "true" : "false");
+	}
+	len += snprintk(&document[len], sizeof(document) - len, "\n]}\n");
+
+	__ASSERT(len < sizeof(document), "document truncated");
+	document_len = len;
+}
+
+static int parse_obj(void)
+{
+	memcpy(payload, document, document_len);
+
+	return json_obj_parse(payload, document_len, doc_descr,
+			      ARRAY_SIZE(doc_descr), &doc);
+}
+
+static int parse_stream(size_t chunk)
+{
+	struct json_stream_obj obj;
+	int ret = -EAGAIN;
+
+	json_stream_obj_parse_init(&obj, doc_descr, ARRAY_SIZE(doc_descr),
+				   &doc, stream_buf, stream_buf_size);
+
+	for (size_t i = 0; i < document_len; i += chunk) {
+		ret = json_stream_obj_parse(&obj, &document[i],
+					    MIN(chunk, document_len - i));
+	}
+
+	return ret;
+}
+
+static void bench_entry(void *p1, void *p2, void *p3)
+{
+	size_t chunk = POINTER_TO_UINT(p1);
+	uint32_t *cycles = p2;
+	uint32_t start;
+
+	ARG_UNUSED(p3);
+
+	start = k_cycle_get_32();
+	for (int i = 0; i < ITERATIONS; i++) {
+		int ret = (chunk == 0) ? parse_obj() : parse_stream(chunk);
+
+		if (ret != 3 || doc.items_len != N_ITEMS) {
+			printk("parsing failed: %d\n", ret);
+			return;
+		}
+	}
+	*cycles = k_cycle_get_32() - start;
+}
+
+/* Parse in a fresh thread, to measure the stack it takes */
+static void run(size_t chunk)
+{
+	uint32_t cycles = 0;
+	size_t unused = 0;
+	uint64_t kbps;
+
+	k_thread_create(&bench_thread, bench_stack, STACK_SIZE, bench_entry,
+			UINT_TO_POINTER(chunk), &cycles, NULL,
+			K_PRIO_PREEMPT(0), 0, K_NO_WAIT);
+	k_thread_join(&bench_thread, K_FOREVER);
+	(void)k_thread_stack_space_get(&bench_thread, &unused);
+
+	if (cycles == 0) {
+		return;
+	}
+
+	kbps = (uint64_t)document_len * ITERATIONS *
+	       sys_clock_hw_cycles_per_sec() / cycles / 1024;
+
+	printk("%-14s chunk %5u %7u KB/s buffer %5u stack %5u bytes\n",
+	       (chunk == 0) ? "json_obj_parse" : "json_stream",
+	       (uint32_t)((chunk == 0) ? document_len : chunk), (uint32_t)kbps,
+	       (uint32_t)((chunk == 0) ? document_len : stream_buf_size),
+	       (uint32_t)(STACK_SIZE - unused));
+}
+
+/* Smallest buffer the streaming parser needs for the document */
+static size_t stream_buf_needed(void)
+{
+	size_t lo = 1, hi = sizeof(stream_buf);
+
+	while (lo < hi) {
+		stream_buf_size = (lo + hi) / 2;
+		if (parse_stream(document_len) == 3) {
+			hi = stream_buf_size;
+		} else {
+			lo = stream_buf_size + 1;
+		}
+	}
+
+	return lo;
+}
+
+void main(void)
+{
+	generate();
+
+	stream_buf_size = stream_buf_needed();
+	printk("document %u bytes, %d items\n", (uint32_t)document_len,
+	       N_ITEMS);
+
+	run(0);
+	for (int i = 0; i < ARRAY_SIZE(chunks); i++) {
+		run(chunks[i]);
+	}
+
+	printk("fin\n");
+}
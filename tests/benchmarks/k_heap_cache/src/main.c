@@ -0,0 +1,110 @@
+/*
+ * Copyright (c) 2022 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/printk.h>
+#include <zephyr/random/rand32.h>
+
+/* k_heap small allocation microbenchmark, see README.rst */
+
+#define HEAP_SIZE 16384
+#define N_LONG_LIVED 48
+#define BURST 32
+#define N_ROUNDS 64
+#define N_MIXED 2048
+
+K_HEAP_DEFINE(bench_heap, HEAP_SIZE);
+
+static void *long_lived[N_LONG_LIVED];
+static void *burst[BURST];
+
+static void fragment_heap(void)
+{
+	for (int i = 0; i < N_LONG_LIVED; i++) {
+		long_lived[i] = k_heap_alloc(&bench_heap, 8 + sys_rand32_get() % 120,
+					     K_NO_WAIT);
+	}
+
+	/* Free every other one so the free lists hold assorted holes */
+	for (int i = 0; i < N_LONG_LIVED; i += 2) {
+		k_heap_free(&bench_heap, long_lived[i]);
+		long_lived[i] = NULL;
+	}
+}
+
+static void bench_size(size_t size)
+{
+	uint32_t start, alloc_cycles = 0U, free_cycles = 0U;
+
+	for (int r = 0; r < N_ROUNDS; r++) {
+		start = k_cycle_get_32();
+		for (int i = 0; i < BURST; i++) {
+			burst[i] = k_heap_alloc(&bench_heap, size, K_NO_WAIT);
+		}
+		alloc_cycles += k_cycle_get_32() - start;
+
+		start = k_cycle_get_32();
+		for (int i = 0; i < BURST; i++) {
+			k_heap_free(&bench_heap, burst[i]);
+		}
+		free_cycles += k_cycle_get_32() - start;
+	}
+
+	printk("size %5u alloc %5u free %5u\n", (uint32_t)size,
+	       alloc_cycles / (N_ROUNDS * BURST),
+	       free_cycles / (N_ROUNDS * BURST));
+}
+
+static void bench_mixed(void)
+{
+	uint32_t start, alloc_cycles = 0U, free_cycles = 0U;
+
+	for (int n = 0; n < N_MIXED; n += BURST) {
+		for (int i = 0; i < BURST; i++) {
+			/* Mostly small, one in eight up to 512 bytes */
+			size_t size = (sys_rand32_get() % 8 == 0) ?
+				      129 + sys_rand32_get() % 384 :
+				      4 + sys_rand32_get() % 124;
+
+			start = k_cycle_get_32();
+			burst[i] = k_heap_alloc(&bench_heap, size, K_NO_WAIT);
+			alloc_cycles += k_cycle_get_32() - start;
+		}
+
+		for (int i = BURST - 1; i >= 0; i--) {
+			start = k_cycle_get_32();
+			k_heap_free(&bench_heap, burst[i]);
+			free_cycles += k_cycle_get_32() - start;
+		}
+	}
+
+	printk("mixed alloc %5u free %5u\n", alloc_cycles / N_MIXED,
+	       free_cycles / N_MIXED);
+}
+
+void main(void)
+{
+	printk("k_heap small block cache: %s\n",
+	       IS_ENABLED(CONFIG_K_HEAP_CACHE) ? "on" : "off");
+
+	fragment_heap();
+
+	for (size_t size = 8; size <= 256; size *= 2) {
+		bench_size(size);
+	}
+
+	bench_mixed();
+
+#ifdef CONFIG_K_HEAP_CACHE
+	struct k_heap_cache_stats stats;
+
+	k_heap_cache_stats_get(&bench_heap, &stats);
+	printk("cache hits %u misses %u cached %u bytes\n",
+	       stats.hits, stats.misses, (uint32_t)stats.cached_bytes);
+#endif
+
+	printk("fin\n");
+}
@@ -0,0 +1,93 @@
+/*
+ * Copyright (c) 2022 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/printk.h>
+
+/* Kernel object lookup benchmark, see README.rst.  Cycles can't be
+ * read from user mode everywhere, so the main thread times whole runs
+ * of a user thread, and the cost of an empty run is subtracted.
+ */
+
+#define N_CALLS 10000
+#define STACK_SIZE 1024
+
+static const int obj_counts[] = { 0, 64, 512, 2048 };
+
+static K_SEM_DEFINE(static_sem, 0, 1);
+static struct k_sem *dyn_sem;
+
+static K_THREAD_STACK_DEFINE(user_stack, STACK_SIZE);
+static struct k_thread user_thread;
+
+static void user_fn(void *p1, void *p2, void *p3)
+{
+	struct k_sem *sem = p1;
+	int n = POINTER_TO_INT(p2);
+
+	ARG_UNUSED(p3);
+
+	for (int i = 0; i < n; i++) {
+		(void)k_sem_count_get(sem);
+	}
+}
+
+static uint32_t time_run(struct k_sem *sem, int n)
+{
+	uint32_t start;
+
+	k_thread_create(&user_thread, user_stack, STACK_SIZE, user_fn, sem,
+			INT_TO_POINTER(n), NULL, K_PRIO_PREEMPT(0), K_USER,
+			K_FOREVER);
+	k_object_access_grant(sem, &user_thread);
+
+	start = k_cycle_get_32();
+	k_thread_start(&user_thread);
+	k_thread_join(&user_thread, K_FOREVER);
+
+	return k_cycle_get_32() - start;
+}
+
+static uint32_t measure(struct k_sem *sem)
+{
+	uint32_t base = time_run(sem, 0);
+	uint32_t cycles = time_run(sem, N_CALLS);
+
+	return (cycles > base) ? (cycles - base) / N_CALLS : 0U;
+}
+
+void main(void)
+{
+	int allocated = 0;
+
+	printk("Dynamic object index: %s\n",
+	       IS_ENABLED(CONFIG_DYNAMIC_OBJECTS_HASH) ? "hash" : "rbtree");
+
+	k_thread_system_pool_assign(k_current_get());
+
+	dyn_sem = k_object_alloc(K_OBJ_SEM);
+	if (dyn_sem == NULL) {
+		printk("failed to allocate a semaphore\n");
+		return;
+	}
+	k_sem_init(dyn_sem, 0, 1);
+
+	for (int i = 0; i < ARRAY_SIZE(obj_counts); i++) {
+		for (; allocated < obj_counts[i]; allocated++) {
+			if (k_object_alloc(K_OBJ_SEM) == NULL) {
+				printk("out of memory after %d objects\n",
+				       allocated);
+				goto out;
+			}
+		}
+
+		printk("objects %4d static %5u dynamic %5u\n", allocated,
+		       measure(&static_sem), measure(dyn_sem));
+	}
+
+out:
+	printk("fin\n");
+}
@@ -0,0 +1,99 @@
+/*
+ * Copyright (c) 2022 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/printk.h>
+
+/* Memory slab SMP scaling benchmark, see README.rst.  One worker per
+ * CPU in use churns a shared slab; the main thread (running at a
+ * higher priority) times the window and collects the counts.
+ */
+
+#define NUM_CPUS CONFIG_MP_MAX_NUM_CPUS
+#define BLOCK_SIZE 64
+#define NUM_BLOCKS 256
+#define BURST 4
+#define RUN_MS 1000
+#define STACK_SIZE 1024
+#define WORKER_PRIO K_PRIO_PREEMPT(10)
+
+K_MEM_SLAB_DEFINE(bench_slab, BLOCK_SIZE, NUM_BLOCKS, 8);
+
+static K_THREAD_STACK_ARRAY_DEFINE(worker_stacks, NUM_CPUS, STACK_SIZE);
+static struct k_thread workers[NUM_CPUS];
+static uint32_t counts[NUM_CPUS];
+static volatile bool stop;
+
+static void worker_fn(void *p1, void *p2, void *p3)
+{
+	uint32_t *count = p1;
+	void *blocks[BURST];
+
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	while (!stop) {
+		for (int i = 0; i < BURST; i++) {
+			if (k_mem_slab_alloc(&bench_slab, &blocks[i],
+					     K_NO_WAIT) != 0) {
+				printk("allocation failed\n");
+				return;
+			}
+		}
+		for (int i = 0; i < BURST; i++) {
+			k_mem_slab_free(&bench_slab, &blocks[i]);
+		}
+		*count += BURST;
+	}
+}
+
+static void run(int ncpus)
+{
+	uint64_t total = 0U;
+
+	stop = false;
+	for (int i = 0; i < ncpus; i++) {
+		counts[i] = 0U;
+		k_thread_create(&workers[i], worker_stacks[i], STACK_SIZE,
+				worker_fn, &counts[i], NULL, NULL,
+				WORKER_PRIO, 0, K_FOREVER);
+		k_thread_cpu_pin(&workers[i], i);
+	}
+
+	for (int i = 0; i < ncpus; i++) {
+		k_thread_start(&workers[i]);
+	}
+
+	k_msleep(RUN_MS);
+	stop = true;
+
+	for (int i = 0; i < ncpus; i++) {
+		k_thread_join(&workers[i], K_FOREVER);
+		total += counts[i];
+	}
+
+	printk("cpus %d ops/s %u\n", ncpus, (uint32_t)(total * 1000U / RUN_MS));
+}
+
+void main(void)
+{
+	printk("Memory slab per-CPU cache: %s\n",
+	       IS_ENABLED(CONFIG_MEM_SLAB_PERCPU_CACHE) ? "on" : "off");
+
+	for (int ncpus = 1; ncpus <= NUM_CPUS; ncpus++) {
+		run(ncpus);
+	}
+
+#ifdef CONFIG_MEM_SLAB_PERCPU_CACHE
+	struct k_mem_slab_cache_stats stats;
+
+	k_mem_slab_cache_stats_get(&bench_slab, &stats);
+	printk("cache hits %u misses %u cached %u\n",
+	       stats.hits, stats.misses, stats.cached_blocks);
+#endif
+
+	printk("fin\n");
+}
@@ -0,0 +1,138 @@
+/*
+ * Copyright (c) 2022 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/printk.h>
+#include <zephyr/sys/ring_buffer.h>
+#include <zephyr/sys/mpsc_ring_buffer.h>
+
+/* Multiple producer ring buffer throughput benchmark, see README.rst.
+ * One worker per CPU in use writes records to a shared buffer, the
+ * worker on the first CPU also reads them back.
+ */
+
+#define NUM_CPUS CONFIG_MP_MAX_NUM_CPUS
+#define RECORD_SIZE 16
+#define BUF_SIZE 1024
+#define BURST 4
+#define RUN_MS 1000
+#define STACK_SIZE 1024
+#define WORKER_PRIO K_PRIO_PREEMPT(10)
+
+enum variant { LOCKED, MPSC };
+
+static const char *const variant_names[] = { "ring_buf_locked", "mpsc_ring_buf" };
+
+RING_BUF_DECLARE(locked_buf, BUF_SIZE);
+static struct k_spinlock lock;
+
+MPSC_RING_BUF_DECLARE(mpsc_buf, BUF_SIZE);
+
+static K_THREAD_STACK_ARRAY_DEFINE(worker_stacks, NUM_CPUS, STACK_SIZE);
+static struct k_thread workers[NUM_CPUS];
+static uint32_t counts[NUM_CPUS];
+static uint8_t drain_buf[BUF_SIZE];
+static volatile bool stop;
+
+/* Producers of the single producer buffer take turns, and only write
+ * whole records so that they never get split.
+ */
+static bool put_locked(const uint8_t *record)
+{
+	k_spinlock_key_t key = k_spin_lock(&lock);
+	bool ok = ring_buf_space_get(&locked_buf) >= RECORD_SIZE;
+
+	if (ok) {
+		(void)ring_buf_put(&locked_buf, record, RECORD_SIZE);
+	}
+	k_spin_unlock(&lock, key);
+
+	return ok;
+}
+
+static bool put_mpsc(const uint8_t *record)
+{
+	return mpsc_ring_buf_put(&mpsc_buf, record, RECORD_SIZE) != 0U;
+}
+
+/* The single consumer needs no lock with either buffer */
+static void drain(enum variant v)
+{
+	uint32_t len;
+
+	do {
+		len = (v == LOCKED) ?
+		      ring_buf_get(&locked_buf, drain_buf, sizeof(drain_buf)) :
+		      mpsc_ring_buf_get(&mpsc_buf, drain_buf, sizeof(drain_buf));
+	} while (len != 0U);
+}
+
+static void worker_fn(void *p1, void *p2, void *p3)
+{
+	uint32_t *count = p1;
+	enum variant v = POINTER_TO_UINT(p2);
+	bool consumer = POINTER_TO_UINT(p3) != 0U;
+	uint8_t record[RECORD_SIZE] = { 0 };
+
+	while (!stop) {
+		for (int i = 0; i < BURST; i++) {
+			bool ok = (v == LOCKED) ? put_locked(record) :
+				  put_mpsc(record);
+
+			if (ok) {
+				(*count)++;
+			}
+		}
+
+		if (consumer) {
+			drain(v);
+		}
+	}
+}
+
+static void run(enum variant v, int ncpus)
+{
+	uint64_t total = 0U;
+
+	ring_buf_reset(&locked_buf);
+	mpsc_ring_buf_init(&mpsc_buf, BUF_SIZE, mpsc_buf.buffer);
+
+	stop = false;
+	for (int i = 0; i < ncpus; i++) {
+		counts[i] = 0U;
+		k_thread_create(&workers[i], worker_stacks[i], STACK_SIZE,
+				worker_fn, &counts[i], UINT_TO_POINTER(v),
+				UINT_TO_POINTER(i == 0), WORKER_PRIO, 0, K_FOREVER);
+		k_thread_cpu_pin(&workers[i], i);
+	}
+
+	for (int i = 0; i < ncpus; i++) {
+		k_thread_start(&workers[i]);
+	}
+
+	k_msleep(RUN_MS);
+	stop = true;
+
+	for (int i = 0; i < ncpus; i++) {
+		k_thread_join(&workers[i], K_FOREVER);
+		total += counts[i];
+	}
+
+	printk("%-15s cpus %d records/s %u\n", variant_names[v], ncpus,
+	       (uint32_t)(total * 1000U / RUN_MS));
+}
+
+void main(void)
+{
+	printk("record %d bytes, buffer %d bytes\n", RECORD_SIZE, BUF_SIZE);
+
+	for (int ncpus = 1; ncpus <= NUM_CPUS; ncpus++) {
+		run(LOCKED, ncpus);
+		run(MPSC, ncpus);
+	}
+
+	printk("fin\n");
+}
@@ -0,0 +1,109 @@
+/*
+ * Copyright (c) 2022 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/printk.h>
+#include <string.h>
+
+/* k_msgq copy vs. zero-copy throughput benchmark, see README.rst */
+
+#define MAX_MSG_SIZE 1024
+#define QUEUE_LEN 8
+#define N_MSGS 4096
+
+static char __aligned(4) ring[QUEUE_LEN * MAX_MSG_SIZE];
+static char __aligned(4) msg_buf[MAX_MSG_SIZE];
+static struct k_msgq msgq;
+
+static void produce(void *msg, size_t size, int seq)
+{
+	memset(msg, seq, size);
+}
+
+static uint32_t consume(const void *msg, size_t size)
+{
+	const uint32_t *words = msg;
+	uint32_t sum = 0U;
+
+	for (size_t i = 0; i < size / sizeof(uint32_t); i++) {
+		sum += words[i];
+	}
+
+	return sum;
+}
+
+static uint32_t run_copy(size_t size, uint32_t *sum)
+{
+	uint32_t start = k_cycle_get_32();
+
+	for (int n = 0; n < N_MSGS; n += QUEUE_LEN) {
+		for (int i = 0; i < QUEUE_LEN; i++) {
+			produce(msg_buf, size, n + i);
+			k_msgq_put(&msgq, msg_buf, K_NO_WAIT);
+		}
+		for (int i = 0; i < QUEUE_LEN; i++) {
+			k_msgq_get(&msgq, msg_buf, K_NO_WAIT);
+			*sum += consume(msg_buf, size);
+		}
+	}
+
+	return k_cycle_get_32() - start;
+}
+
+static uint32_t run_zero_copy(size_t size, uint32_t *sum)
+{
+	uint32_t start = k_cycle_get_32();
+	void *msg;
+
+	for (int n = 0; n < N_MSGS; n += QUEUE_LEN) {
+		for (int i = 0; i < QUEUE_LEN; i++) {
+			k_msgq_reserve(&msgq, &msg, K_NO_WAIT);
+			produce(msg, size, n + i);
+			k_msgq_commit(&msgq);
+		}
+		for (int i = 0; i < QUEUE_LEN; i++) {
+			k_msgq_peek_ref(&msgq, &msg, K_NO_WAIT);
+			*sum += consume(msg, size);
+			k_msgq_release(&msgq);
+		}
+	}
+
+	return k_cycle_get_32() - start;
+}
+
+static uint32_t msgs_per_sec(uint32_t cycles)
+{
+	return (uint32_t)((uint64_t)N_MSGS * sys_clock_hw_cycles_per_sec() /
+			  cycles);
+}
+
+void main(void)
+{
+	uint32_t copy_sum = 0U, zero_copy_sum = 0U;
+
+	printk("k_msgq throughput, %d messages per size\n", N_MSGS);
+
+	for (size_t size = 16; size <= MAX_MSG_SIZE; size *= 2) {
+		uint32_t copy_cycles, zero_copy_cycles;
+
+		k_msgq_init(&msgq, ring, size, QUEUE_LEN);
+
+		copy_cycles = run_copy(size, &copy_sum);
+		zero_copy_cycles = run_zero_copy(size, &zero_copy_sum);
+
+		printk("size %4u copy %7u msgs/s zero-copy %7u msgs/s\n",
+		       (uint32_t)size, msgs_per_sec(copy_cycles),
+		       msgs_per_sec(zero_copy_cycles));
+	}
+
+	/* Both modes must have moved the same data */
+	if (copy_sum != zero_copy_sum) {
+		printk("checksum mismatch %08x != %08x\n", copy_sum,
+		       zero_copy_sum);
+	}
+
+	printk("fin\n");
+}
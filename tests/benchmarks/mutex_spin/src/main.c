@@ -0,0 +1,107 @@
+/*
+ * Copyright (c) 2022 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/printk.h>
+
+/* Contended k_mutex handoff benchmark, see README.rst */
+
+#define N_THREADS 2
+#define RUN_MS 1000
+#define STACK_SIZE 1024
+#define WORKER_PRIO K_PRIO_PREEMPT(10)
+
+static const uint32_t hold_us[] = { 1, 5, 20, 100 };
+
+static K_MUTEX_DEFINE(mutex);
+static K_THREAD_STACK_ARRAY_DEFINE(worker_stacks, N_THREADS, STACK_SIZE);
+static struct k_thread workers[N_THREADS];
+
+/* Updated with the mutex held */
+static uint32_t release_stamp;
+static int last_owner = -1;
+
+struct stats {
+	uint64_t handoff_cycles;
+	uint32_t handoffs;
+	uint32_t locks;
+};
+
+static struct stats stats[N_THREADS];
+static volatile bool stop;
+static uint32_t hold;
+
+static void worker_fn(void *p1, void *p2, void *p3)
+{
+	int me = POINTER_TO_INT(p1);
+	struct stats *st = &stats[me];
+
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	while (!stop) {
+		k_mutex_lock(&mutex, K_FOREVER);
+
+		/* Only count locks taken over from the other thread */
+		if ((last_owner >= 0) && (last_owner != me)) {
+			st->handoff_cycles += k_cycle_get_32() - release_stamp;
+			st->handoffs++;
+		}
+		last_owner = me;
+		st->locks++;
+
+		k_busy_wait(hold);
+
+		release_stamp = k_cycle_get_32();
+		k_mutex_unlock(&mutex);
+
+		/* Give the other thread a chance to win the race */
+		k_busy_wait(1);
+	}
+}
+
+static void run(uint32_t us)
+{
+	uint64_t handoff_cycles = 0U;
+	uint32_t handoffs = 0U, locks = 0U;
+
+	hold = us;
+	stop = false;
+	last_owner = -1;
+
+	for (int i = 0; i < N_THREADS; i++) {
+		stats[i] = (struct stats) { 0 };
+		k_thread_create(&workers[i], worker_stacks[i], STACK_SIZE,
+				worker_fn, INT_TO_POINTER(i), NULL, NULL,
+				WORKER_PRIO, 0, K_NO_WAIT);
+	}
+
+	k_msleep(RUN_MS);
+	stop = true;
+
+	for (int i = 0; i < N_THREADS; i++) {
+		k_thread_join(&workers[i], K_FOREVER);
+		handoff_cycles += stats[i].handoff_cycles;
+		handoffs += stats[i].handoffs;
+		locks += stats[i].locks;
+	}
+
+	printk("hold %3u us handoff %6u cycles locks/s %7u\n", us,
+	       handoffs ? (uint32_t)(handoff_cycles / handoffs) : 0U,
+	       locks * 1000U / RUN_MS);
+}
+
+void main(void)
+{
+	printk("Adaptive mutex spinning: %s\n",
+	       IS_ENABLED(CONFIG_MUTEX_ADAPTIVE_SPIN) ? "on" : "off");
+
+	for (int i = 0; i < ARRAY_SIZE(hold_us); i++) {
+		run(hold_us[i]);
+	}
+
+	printk("fin\n");
+}
@@ -0,0 +1,131 @@
+/*
+ * Copyright (c) 2022 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <string.h>
+#include <zephyr/kernel.h>
+#include <zephyr/sys/printk.h>
+#include <zephyr/sys/mem_manage.h>
+#include <zephyr/random/rand32.h>
+
+/* Demand paging backing store throughput benchmark, see README.rst */
+
+#define N_SWEEPS 4
+
+/* Pages the store holds whatever the data, keep half as a margin for
+ * the kernel's own evictable pages. Running the compressed store short
+ * of pool is tested by tests/kernel/mem_protect/demand_paging.
+ */
+#ifdef CONFIG_BACKING_STORE_RAM_COMPRESSED
+#define STORE_PAGES MIN(CONFIG_BACKING_STORE_RAM_PAGES, \
+			CONFIG_BACKING_STORE_RAM_COMPRESSED_POOL_SIZE / \
+			CONFIG_MMU_PAGE_SIZE)
+#else
+#define STORE_PAGES CONFIG_BACKING_STORE_RAM_PAGES
+#endif
+#define EXTRA_PAGES ((STORE_PAGES - 1) / 2)
+
+enum data { ZERO, TEXT, RANDOM };
+
+static const char *const data_names[] = { "zero", "text", "random" };
+
+static const char *const words[] = {
+	"page ", "frame ", "evict ", "fault ", "store ", "0x1000 ", "\n",
+};
+
+static uint8_t *arena;
+static size_t arena_pages;
+
+static void fill(enum data data)
+{
+	size_t size = arena_pages * CONFIG_MMU_PAGE_SIZE;
+	size_t pos = 0;
+
+	switch (data) {
+	case ZERO:
+		(void)memset(arena, 0, size);
+		break;
+	case TEXT:
+		while (pos < size) {
+			const char *word = words[sys_rand32_get() % ARRAY_SIZE(words)];
+
+			while (*word != '\0' && pos < size) {
+				arena[pos++] = *word++;
+			}
+		}
+		break;
+	default:
+		sys_rand_get(arena, size);
+		break;
+	}
+}
+
+#ifdef CONFIG_BACKING_STORE_RAM_COMPRESSED
+static void print_store(void)
+{
+	struct k_mem_paging_compressed_stats_t stats;
+
+	k_mem_paging_compressed_stats_get(&stats);
+
+	printk("stored %2lu zero %2lu raw %2lu bytes %6zu pool %6zu\n",
+	       stats.pages, stats.zero_pages, stats.raw_pages,
+	       stats.compressed_bytes, stats.pool_bytes);
+}
+#endif
+
+static void run(enum data data)
+{
+	struct k_mem_paging_stats_t stats;
+	unsigned long faults;
+	uint32_t start, cycles;
+
+	fill(data);
+
+	k_mem_paging_stats_get(&stats);
+	faults = stats.pagefaults.cnt;
+
+	start = k_cycle_get_32();
+	for (int i = 0; i < N_SWEEPS; i++) {
+		for (size_t page = 0; page < arena_pages; page++) {
+			(void)*(volatile uint8_t *)&arena[page *
+							 CONFIG_MMU_PAGE_SIZE];
+		}
+	}
+	cycles = k_cycle_get_32() - start;
+
+	k_mem_paging_stats_get(&stats);
+	faults = stats.pagefaults.cnt - faults;
+
+	printk("data %-6s pages/s %6u cycles/fault %6u\n", data_names[data],
+	       (uint32_t)((uint64_t)faults * sys_clock_hw_cycles_per_sec() /
+			  MAX(cycles, 1U)),
+	       (faults == 0U) ? 0U : (uint32_t)(cycles / faults));
+
+#ifdef CONFIG_BACKING_STORE_RAM_COMPRESSED
+	print_store();
+#endif
+}
+
+void main(void)
+{
+	size_t size = k_mem_free_get() + EXTRA_PAGES * CONFIG_MMU_PAGE_SIZE;
+
+	printk("Backing store: %s\n",
+	       IS_ENABLED(CONFIG_BACKING_STORE_RAM_COMPRESSED) ? "ram_compressed" :
+	       IS_ENABLED(CONFIG_BACKING_STORE_RAM) ? "ram" : "custom");
+
+	arena = k_mem_map(size, K_MEM_PERM_RW);
+	if (arena == NULL) {
+		printk("failed to map %zu bytes\n", size);
+		return;
+	}
+	arena_pages = size / CONFIG_MMU_PAGE_SIZE;
+
+	for (int d = ZERO; d <= RANDOM; d++) {
+		run(d);
+	}
+
+	printk("fin\n");
+}
@@ -0,0 +1,114 @@
+/*
+ * Copyright (c) 2022 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/printk.h>
+
+/* Poll set wakeup benchmark, see README.rst */
+
+#define MAX_EVENTS 64
+#define N_ROUNDS 256
+#define STACK_SIZE 1024
+#define WAITER_PRIO K_PRIO_PREEMPT(1)
+#define MAIN_PRIO K_PRIO_PREEMPT(2)
+
+static struct k_sem sems[MAX_EVENTS];
+static struct k_poll_event events[MAX_EVENTS];
+static struct k_poll_set set;
+static K_SEM_DEFINE(ack, 0, 1);
+
+static K_THREAD_STACK_DEFINE(waiter_stack, STACK_SIZE);
+static struct k_thread waiter_thread;
+
+static volatile uint32_t woken_at;
+static volatile bool stop;
+
+static void waiter_fn(void *p1, void *p2, void *p3)
+{
+	int n = POINTER_TO_INT(p1);
+	bool use_set = POINTER_TO_INT(p2);
+	struct k_poll_event *ready[1];
+
+	ARG_UNUSED(p3);
+
+	while (!stop) {
+		if (use_set) {
+			(void)k_poll_set_wait(&set, ready, 1, K_FOREVER);
+		} else {
+			for (int i = 0; i < n; i++) {
+				events[i].state = K_POLL_STATE_NOT_READY;
+			}
+			(void)k_poll(events, n, K_FOREVER);
+		}
+		woken_at = k_cycle_get_32();
+
+		(void)k_sem_take(&sems[n - 1], K_NO_WAIT);
+		k_sem_give(&ack);
+	}
+}
+
+static void measure(int n, bool use_set, uint32_t *wake, uint32_t *round)
+{
+	uint32_t start, wake_cycles = 0U, round_cycles = 0U;
+
+	if (use_set) {
+		k_poll_set_init(&set);
+		for (int i = 0; i < n; i++) {
+			(void)k_poll_set_add(&set, &events[i]);
+		}
+	}
+
+	stop = false;
+	k_thread_create(&waiter_thread, waiter_stack, STACK_SIZE, waiter_fn,
+			INT_TO_POINTER(n), INT_TO_POINTER(use_set), NULL,
+			WAITER_PRIO, 0, K_NO_WAIT);
+
+	for (int r = 0; r < N_ROUNDS; r++) {
+		start = k_cycle_get_32();
+		k_sem_give(&sems[n - 1]);
+		wake_cycles += woken_at - start;
+		k_sem_take(&ack, K_FOREVER);
+		round_cycles += k_cycle_get_32() - start;
+	}
+
+	/* Let the waiter leave on its own, so that k_poll() unregisters */
+	stop = true;
+	k_sem_give(&sems[n - 1]);
+	k_thread_join(&waiter_thread, K_FOREVER);
+	k_sem_reset(&ack);
+
+	if (use_set) {
+		for (int i = 0; i < n; i++) {
+			(void)k_poll_set_remove(&set, &events[i]);
+		}
+	}
+
+	*wake = wake_cycles / N_ROUNDS;
+	*round = round_cycles / N_ROUNDS;
+}
+
+void main(void)
+{
+	uint32_t poll_wake, poll_round, set_wake, set_round;
+
+	k_thread_priority_set(k_current_get(), MAIN_PRIO);
+
+	for (int i = 0; i < MAX_EVENTS; i++) {
+		k_sem_init(&sems[i], 0, 1);
+		k_poll_event_init(&events[i], K_POLL_TYPE_SEM_AVAILABLE,
+				  K_POLL_MODE_NOTIFY_ONLY, &sems[i]);
+	}
+
+	for (int n = 1; n <= MAX_EVENTS; n *= 2) {
+		measure(n, false, &poll_wake, &poll_round);
+		measure(n, true, &set_wake, &set_round);
+
+		printk("events %2d k_poll %5u %5u set %5u %5u\n", n,
+		       poll_wake, poll_round, set_wake, set_round);
+	}
+
+	printk("fin\n");
+}
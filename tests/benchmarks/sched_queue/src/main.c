@@ -0,0 +1,153 @@
+/*
+ * Copyright (c) 2022 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/printk.h>
+#include <zephyr/random/rand32.h>
+
+/* Ready queue backend benchmark, see README.rst.  Background threads
+ * fill the ready queue below the main thread, then the cost of
+ * readying a thread and of switching between two threads is timed.
+ */
+
+#define MAX_BG 64
+#define N_OPS 256
+#define STACK_SIZE 1024
+#define MAIN_PRIO K_PRIO_PREEMPT(1)
+#define BG_LEVELS 4
+#define PROBE_PRIO (MAIN_PRIO + BG_LEVELS)
+
+/* Deadlines (in cycles) are only compared against each other, so
+ * anything that keeps the main pair well ahead of the background
+ * threads will do.
+ */
+#define MAIN_DEADLINE 1000
+#define BG_DEADLINE 1000000
+
+static const int bg_counts[] = { 0, 8, 16, 32, MAX_BG };
+
+static K_THREAD_STACK_ARRAY_DEFINE(bg_stacks, MAX_BG, STACK_SIZE);
+static struct k_thread bg_threads[MAX_BG];
+
+static K_THREAD_STACK_DEFINE(partner_stack, STACK_SIZE);
+static struct k_thread partner_thread;
+
+static K_THREAD_STACK_DEFINE(probe_stack, STACK_SIZE);
+static struct k_thread probe_thread;
+
+static K_SEM_DEFINE(ping, 0, 1);
+static K_SEM_DEFINE(pong, 0, 1);
+
+static void idle_fn(void *p1, void *p2, void *p3)
+{
+	ARG_UNUSED(p1);
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	/* Never expected to run while measuring */
+	k_sleep(K_FOREVER);
+}
+
+static void partner_fn(void *p1, void *p2, void *p3)
+{
+	ARG_UNUSED(p1);
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	while (true) {
+		k_sem_take(&ping, K_FOREVER);
+		k_sem_give(&pong);
+	}
+}
+
+static void start_bg(int n)
+{
+	for (int i = 0; i < n; i++) {
+		/* Spread across priorities, sharing the main thread's
+		 * priority only when deadlines keep them behind it.
+		 */
+		int prio = MAIN_PRIO + 1 + sys_rand32_get() % BG_LEVELS;
+
+		if (IS_ENABLED(CONFIG_SCHED_DEADLINE) && (i % 2) == 0) {
+			prio = MAIN_PRIO;
+		}
+
+		k_thread_create(&bg_threads[i], bg_stacks[i], STACK_SIZE,
+				idle_fn, NULL, NULL, NULL, prio, 0, K_FOREVER);
+#ifdef CONFIG_SCHED_DEADLINE
+		k_thread_deadline_set(&bg_threads[i],
+				      BG_DEADLINE + sys_rand32_get() % BG_DEADLINE);
+#endif
+		k_thread_start(&bg_threads[i]);
+	}
+}
+
+static void stop_bg(int n)
+{
+	for (int i = 0; i < n; i++) {
+		k_thread_abort(&bg_threads[i]);
+	}
+}
+
+static void measure(int n)
+{
+	uint32_t start, ready_cycles = 0U, switch_cycles;
+
+#ifdef CONFIG_SCHED_DEADLINE
+	k_thread_deadline_set(k_current_get(), MAIN_DEADLINE);
+	k_thread_deadline_set(&partner_thread, MAIN_DEADLINE);
+	k_thread_deadline_set(&probe_thread, 3 * BG_DEADLINE);
+#endif
+
+	start_bg(n);
+
+	/* The probe ranks behind every background thread */
+	for (int i = 0; i < N_OPS; i++) {
+		start = k_cycle_get_32();
+		k_thread_resume(&probe_thread);
+		ready_cycles += k_cycle_get_32() - start;
+		k_thread_suspend(&probe_thread);
+	}
+
+	start = k_cycle_get_32();
+	for (int i = 0; i < N_OPS; i++) {
+		k_sem_give(&ping);
+		k_sem_take(&pong, K_FOREVER);
+	}
+	switch_cycles = k_cycle_get_32() - start;
+
+	stop_bg(n);
+
+	printk("threads %3d ready %5u switch %5u\n", n, ready_cycles / N_OPS,
+	       switch_cycles / (2 * N_OPS));
+}
+
+void main(void)
+{
+	const char *backend =
+		IS_ENABLED(CONFIG_SCHED_SCALABLE) ? "scalable" :
+		IS_ENABLED(CONFIG_SCHED_MULTIQ) ? "multiq" :
+		IS_ENABLED(CONFIG_SCHED_BITMAP) ? "bitmap" : "dumb";
+
+	printk("Ready queue backend: %s, deadlines %s\n", backend,
+	       IS_ENABLED(CONFIG_SCHED_DEADLINE) ? "on" : "off");
+
+	k_thread_priority_set(k_current_get(), MAIN_PRIO);
+
+	k_thread_create(&partner_thread, partner_stack, STACK_SIZE,
+			partner_fn, NULL, NULL, NULL, MAIN_PRIO, 0, K_NO_WAIT);
+
+	k_thread_create(&probe_thread, probe_stack, STACK_SIZE,
+			idle_fn, NULL, NULL, NULL, PROBE_PRIO, 0, K_FOREVER);
+	k_thread_start(&probe_thread);
+	k_thread_suspend(&probe_thread);
+
+	for (int i = 0; i < ARRAY_SIZE(bg_counts); i++) {
+		measure(bg_counts[i]);
+	}
+
+	printk("fin\n");
+}
@@ -0,0 +1,112 @@
+/*
+ * Copyright (c) 2022 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/printk.h>
+
+/* Scheduler SMP throughput benchmark, see README.rst.  Pairs of
+ * threads ping-pong through semaphores; the main thread (running at
+ * a higher priority) times the window and collects the counts.
+ */
+
+#define MAX_PAIRS (2 * CONFIG_MP_MAX_NUM_CPUS)
+#define RUN_MS 1000
+#define STACK_SIZE 1024
+#define WORKER_PRIO K_PRIO_PREEMPT(10)
+
+struct pair {
+	struct k_sem sems[2];
+	/* one per thread, as both may run at once on different CPUs */
+	uint32_t counts[2];
+};
+
+static K_THREAD_STACK_ARRAY_DEFINE(worker_stacks, 2 * MAX_PAIRS, STACK_SIZE);
+static struct k_thread workers[2 * MAX_PAIRS];
+static struct pair pairs[MAX_PAIRS];
+static volatile bool stop;
+
+static void worker_fn(void *p1, void *p2, void *p3)
+{
+	struct pair *pair = p1;
+	int me = POINTER_TO_INT(p2);
+
+	ARG_UNUSED(p3);
+
+	while (!stop) {
+		k_sem_take(&pair->sems[me], K_FOREVER);
+		k_sem_give(&pair->sems[!me]);
+		pair->counts[me]++;
+	}
+}
+
+static uint64_t ipi_count(void)
+{
+	k_thread_runtime_stats_t stats;
+
+	k_thread_runtime_stats_all_get(&stats);
+
+	return stats.ipi_count;
+}
+
+static void run(int npairs)
+{
+	uint64_t switches = 0U, ipis;
+
+	stop = false;
+	for (int i = 0; i < npairs; i++) {
+		pairs[i].counts[0] = 0U;
+		pairs[i].counts[1] = 0U;
+		k_sem_init(&pairs[i].sems[0], 0, 1);
+		k_sem_init(&pairs[i].sems[1], 0, 1);
+
+		for (int j = 0; j < 2; j++) {
+			k_thread_create(&workers[2 * i + j], worker_stacks[2 * i + j],
+					STACK_SIZE, worker_fn, &pairs[i],
+					INT_TO_POINTER(j), NULL, WORKER_PRIO, 0,
+					K_NO_WAIT);
+		}
+	}
+
+	ipis = ipi_count();
+	for (int i = 0; i < npairs; i++) {
+		k_sem_give(&pairs[i].sems[0]);
+	}
+
+	k_msleep(RUN_MS);
+	stop = true;
+	ipis = ipi_count() - ipis;
+
+	/* Make sure nobody stays blocked on a semaphore */
+	for (int i = 0; i < npairs; i++) {
+		k_sem_give(&pairs[i].sems[0]);
+		k_sem_give(&pairs[i].sems[1]);
+	}
+
+	for (int i = 0; i < 2 * npairs; i++) {
+		k_thread_join(&workers[i], K_FOREVER);
+	}
+
+	for (int i = 0; i < npairs; i++) {
+		switches += pairs[i].counts[0] + pairs[i].counts[1];
+	}
+
+	printk("pairs %d switches/s %u ipis/s %u\n", npairs,
+	       (uint32_t)(switches * 1000U / RUN_MS),
+	       (uint32_t)(ipis * 1000U / RUN_MS));
+}
+
+void main(void)
+{
+	printk("Per-CPU ready queues: %s, targeted IPIs: %s\n",
+	       IS_ENABLED(CONFIG_SCHED_CPU_RUNQ) ? "on" : "off",
+	       IS_ENABLED(CONFIG_SCHED_IPI_TARGETED) ? "on" : "off");
+
+	for (int npairs = 1; npairs <= MAX_PAIRS; npairs *= 2) {
+		run(npairs);
+	}
+
+	printk("fin\n");
+}
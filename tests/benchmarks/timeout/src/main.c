@@ -0,0 +1,124 @@
+/*
+ * Copyright (c) 2022 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/printk.h>
+#include <zephyr/timeout_q.h>
+#include <zephyr/random/rand32.h>
+
+/* This is a timeout queue microbenchmark.  It measures the cost of
+ * z_add_timeout(), z_abort_timeout() and of expiring timeouts in
+ * sys_clock_announce() with an increasing number of unrelated
+ * timeouts already armed, which is where the different timeout queue
+ * backends diverge.  See README.rst for details.
+ */
+
+#define MAX_ACTIVE 1024
+#define N_OPS 64
+#define N_EXPIRE 64
+
+static const int active_counts[] = { 0, 16, 64, 256, MAX_ACTIVE };
+
+static struct _timeout background[MAX_ACTIVE];
+static struct _timeout ops[N_OPS];
+static k_ticks_t op_ticks[N_OPS];
+static struct _timeout expiring[N_EXPIRE];
+
+static volatile uint32_t expire_first;
+static volatile uint32_t expire_last;
+static volatile int expire_count;
+
+static void idle_fn(struct _timeout *t)
+{
+	ARG_UNUSED(t);
+}
+
+static void expire_fn(struct _timeout *t)
+{
+	uint32_t now = k_cycle_get_32();
+
+	ARG_UNUSED(t);
+
+	if (expire_count++ == 0) {
+		expire_first = now;
+	}
+	expire_last = now;
+}
+
+static void arm_background(int n)
+{
+	for (int i = 0; i < n; i++) {
+		z_init_timeout(&background[i]);
+		z_add_timeout(&background[i], idle_fn,
+			      K_TICKS(1000 + sys_rand32_get() % 8000));
+	}
+}
+
+static void abort_background(int n)
+{
+	for (int i = 0; i < n; i++) {
+		z_abort_timeout(&background[i]);
+	}
+}
+
+static void measure(int active)
+{
+	uint32_t start, insert_cycles, abort_cycles, expire_cycles;
+
+	arm_background(active);
+
+	/* Keep the random generator out of the measurement */
+	for (int i = 0; i < N_OPS; i++) {
+		op_ticks[i] = 10 + sys_rand32_get() % 8000;
+	}
+
+	start = k_cycle_get_32();
+	for (int i = 0; i < N_OPS; i++) {
+		z_init_timeout(&ops[i]);
+		z_add_timeout(&ops[i], idle_fn, K_TICKS(op_ticks[i]));
+	}
+	insert_cycles = k_cycle_get_32() - start;
+
+	start = k_cycle_get_32();
+	for (int i = 0; i < N_OPS; i++) {
+		z_abort_timeout(&ops[i]);
+	}
+	abort_cycles = k_cycle_get_32() - start;
+
+	/* Synchronize to a tick boundary so the whole batch lands on
+	 * the same tick.
+	 */
+	expire_count = 0;
+	k_sleep(K_TICKS(1));
+	for (int i = 0; i < N_EXPIRE; i++) {
+		z_init_timeout(&expiring[i]);
+		z_add_timeout(&expiring[i], expire_fn, K_TICKS(2));
+	}
+	k_sleep(K_TICKS(5));
+
+	if (expire_count != N_EXPIRE) {
+		printk("expired %d of %d timeouts\n", expire_count, N_EXPIRE);
+	}
+	expire_cycles = expire_last - expire_first;
+
+	abort_background(active);
+
+	printk("active %5d insert %5u abort %5u expire %5u\n",
+	       active, insert_cycles / N_OPS, abort_cycles / N_OPS,
+	       expire_cycles / (N_EXPIRE - 1));
+}
+
+void main(void)
+{
+	printk("Timeout queue backend: %s\n",
+	       IS_ENABLED(CONFIG_TIMEOUT_QUEUE_WHEEL) ? "wheel" : "dlist");
+
+	for (int i = 0; i < ARRAY_SIZE(active_counts); i++) {
+		measure(active_counts[i]);
+	}
+
+	printk("fin\n");
+}
@@ -0,0 +1,91 @@
+/*
+ * Copyright (c) 2022 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/printk.h>
+
+/* Batched wake-up benchmark, see README.rst.  Waiters preempt the main
+ * thread as soon as they are readied, so the time until the last one
+ * runs covers both the wake-ups and the switches into the waiters.
+ */
+
+#define MAX_WAITERS 64
+#define N_RUNS 16
+#define STACK_SIZE 1024
+#define MAIN_PRIO K_PRIO_PREEMPT(5)
+#define WAITER_PRIO K_PRIO_PREEMPT(2)
+
+static K_THREAD_STACK_ARRAY_DEFINE(waiter_stacks, MAX_WAITERS, STACK_SIZE);
+static struct k_thread waiters[MAX_WAITERS];
+
+static K_SEM_DEFINE(wake_sem, 0, MAX_WAITERS);
+
+static volatile uint32_t last_wake;
+static volatile int wake_count;
+
+static void waiter_fn(void *p1, void *p2, void *p3)
+{
+	ARG_UNUSED(p1);
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	while (true) {
+		k_sem_take(&wake_sem, K_FOREVER);
+		last_wake = k_cycle_get_32();
+		wake_count++;
+	}
+}
+
+static uint32_t release(int n, bool batch)
+{
+	uint32_t start;
+
+	wake_count = 0;
+
+	start = k_cycle_get_32();
+	if (batch) {
+		k_sem_give_n(&wake_sem, n);
+	} else {
+		for (int i = 0; i < n; i++) {
+			k_sem_give(&wake_sem);
+		}
+	}
+
+	/* Every waiter woken up has already run and blocked again */
+	__ASSERT(wake_count == n, "woke %d of %d", wake_count, n);
+
+	return last_wake - start;
+}
+
+static void measure(int n)
+{
+	uint32_t loop_cycles = 0U, batch_cycles = 0U;
+
+	for (int i = 0; i < N_RUNS; i++) {
+		loop_cycles += release(n, false);
+		batch_cycles += release(n, true);
+	}
+
+	printk("waiters %2d loop %5u batch %5u\n", n, loop_cycles / N_RUNS,
+	       batch_cycles / N_RUNS);
+}
+
+void main(void)
+{
+	k_thread_priority_set(k_current_get(), MAIN_PRIO);
+
+	for (int i = 0; i < MAX_WAITERS; i++) {
+		k_thread_create(&waiters[i], waiter_stacks[i], STACK_SIZE,
+				waiter_fn, NULL, NULL, NULL, WAITER_PRIO, 0,
+				K_NO_WAIT);
+	}
+
+	for (int n = 1; n <= MAX_WAITERS; n *= 2) {
+		measure(n);
+	}
+
+	printk("fin\n");
+}
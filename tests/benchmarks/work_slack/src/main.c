@@ -0,0 +1,111 @@
+/*
+ * Copyright (c) 2022 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/printk.h>
+#include <zephyr/random/rand32.h>
+
+/* Delayable work slack benchmark, see README.rst */
+
+#define N_ITEMS 500
+#define MIN_DELAY_MS 100
+#define DELAY_SPREAD_MS 100
+
+static const int slacks_ms[] = { 0, 1, 5, 10, 50 };
+
+struct item {
+	struct k_work_delayable dwork;
+	int64_t due;
+	int64_t fired;
+};
+
+static struct item items[N_ITEMS];
+static int64_t ticks[N_ITEMS];
+static K_SEM_DEFINE(done_sem, 0, 1);
+static atomic_t pending;
+
+static void item_handler(struct k_work *work)
+{
+	struct k_work_delayable *dwork = k_work_delayable_from_work(work);
+	struct item *item = CONTAINER_OF(dwork, struct item, dwork);
+
+	item->fired = k_uptime_ticks();
+	if (atomic_dec(&pending) == 1) {
+		k_sem_give(&done_sem);
+	}
+}
+
+static int count_distinct(int64_t *values, int n)
+{
+	int distinct = 0;
+
+	for (int i = 1; i < n; i++) {
+		int64_t v = values[i];
+		int j = i;
+
+		for (; (j > 0) && (values[j - 1] > v); j--) {
+			values[j] = values[j - 1];
+		}
+		values[j] = v;
+	}
+
+	for (int i = 0; i < n; i++) {
+		if ((i == 0) || (values[i] != values[i - 1])) {
+			distinct++;
+		}
+	}
+
+	return distinct;
+}
+
+static void run(int slack_ms)
+{
+	int64_t max_late = 0;
+	int timeouts, wakeups;
+
+	atomic_set(&pending, N_ITEMS);
+
+	for (int i = 0; i < N_ITEMS; i++) {
+		uint32_t delay_ms = MIN_DELAY_MS + sys_rand32_get() % DELAY_SPREAD_MS;
+
+		k_work_delayable_slack_set(&items[i].dwork, K_MSEC(slack_ms));
+		items[i].due = k_uptime_ticks() + k_ms_to_ticks_ceil32(delay_ms);
+		k_work_schedule(&items[i].dwork, K_MSEC(delay_ms));
+	}
+
+	for (int i = 0; i < N_ITEMS; i++) {
+		ticks[i] = k_work_delayable_expires_get(&items[i].dwork);
+	}
+	timeouts = count_distinct(ticks, N_ITEMS);
+
+	k_sem_take(&done_sem, K_FOREVER);
+
+	for (int i = 0; i < N_ITEMS; i++) {
+		ticks[i] = items[i].fired;
+		max_late = MAX(max_late, items[i].fired - items[i].due);
+	}
+	wakeups = count_distinct(ticks, N_ITEMS);
+
+	printk("slack %3d ms timeouts %3d wakeups %3d max late %3u ms\n",
+	       slack_ms, timeouts, wakeups,
+	       k_ticks_to_ms_ceil32((uint32_t)MAX(max_late, 0)));
+}
+
+void main(void)
+{
+	printk("Tickless kernel: %s\n",
+	       IS_ENABLED(CONFIG_TICKLESS_KERNEL) ? "yes" : "no");
+
+	for (int i = 0; i < N_ITEMS; i++) {
+		k_work_init_delayable(&items[i].dwork, item_handler);
+	}
+
+	for (int i = 0; i < ARRAY_SIZE(slacks_ms); i++) {
+		run(slacks_ms[i]);
+	}
+
+	printk("fin\n");
+}
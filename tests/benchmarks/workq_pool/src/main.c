@@ -0,0 +1,121 @@
+/*
+ * Copyright (c) 2022 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/printk.h>
+
+/* Work queue pool benchmark, see README.rst.  Bursts of independent
+ * work items are submitted to work queues served by more and more
+ * threads, timing the whole burst and the start latency of each item.
+ */
+
+#define MAX_THREADS (2 * CONFIG_MP_MAX_NUM_CPUS)
+#define N_ITEMS 256
+#define N_BURSTS 8
+#define ITEM_US 50
+#define STACK_SIZE 1024
+
+/* Pools of 1, 2, 4... MAX_THREADS threads */
+#define TOTAL_THREADS (2 * MAX_THREADS - 1)
+#define POOL_PRIO K_PRIO_PREEMPT(1)
+
+struct item {
+	struct k_work work;
+	uint32_t submitted;
+};
+
+static struct item items[N_ITEMS];
+static uint32_t latencies[N_ITEMS * N_BURSTS];
+static atomic_t done;
+
+static K_THREAD_STACK_ARRAY_DEFINE(pool_stacks, TOTAL_THREADS, STACK_SIZE);
+static struct k_thread pool_threads[TOTAL_THREADS];
+
+static void item_handler(struct k_work *work)
+{
+	struct item *item = CONTAINER_OF(work, struct item, work);
+	atomic_val_t n = atomic_inc(&done);
+
+	latencies[n] = k_cycle_get_32() - item->submitted;
+
+	/* Stand-in for the actual work */
+	k_busy_wait(ITEM_US);
+}
+
+static void sort(uint32_t *values, int n)
+{
+	for (int i = 1; i < n; i++) {
+		uint32_t v = values[i];
+		int j = i;
+
+		for (; (j > 0) && (values[j - 1] > v); j--) {
+			values[j] = values[j - 1];
+		}
+		values[j] = v;
+	}
+}
+
+static void run(struct k_work_q *queue, int nthreads)
+{
+	uint32_t start, cycles;
+	int n = N_ITEMS * N_BURSTS;
+
+	atomic_set(&done, 0);
+
+	start = k_cycle_get_32();
+	for (int b = 0; b < N_BURSTS; b++) {
+		for (int i = 0; i < N_ITEMS; i++) {
+			items[i].submitted = k_cycle_get_32();
+			k_work_submit_to_queue(queue, &items[i].work);
+		}
+		k_work_queue_drain(queue, false);
+	}
+	cycles = k_cycle_get_32() - start;
+
+	sort(latencies, n);
+
+	printk("threads %2d items/s %7u latency p50 %6u p99 %6u max %6u us\n",
+	       nthreads,
+	       (uint32_t)((uint64_t)n * sys_clock_hw_cycles_per_sec() / cycles),
+	       k_cyc_to_us_near32(latencies[n / 2]),
+	       k_cyc_to_us_near32(latencies[n * 99 / 100]),
+	       k_cyc_to_us_near32(latencies[n - 1]));
+}
+
+void main(void)
+{
+	static struct k_work_q queues[MAX_THREADS];
+	k_thread_stack_t *stacks[TOTAL_THREADS];
+	struct k_work_queue_config cfg = {
+		.name = "pool",
+		.pin_cpus = IS_ENABLED(CONFIG_SCHED_CPU_MASK),
+	};
+	int q = 0;
+
+	printk("CPUs %u, threads pinned: %s\n", arch_num_cpus(),
+	       cfg.pin_cpus ? "yes" : "no");
+
+	for (int i = 0; i < N_ITEMS; i++) {
+		k_work_init(&items[i].work, item_handler);
+	}
+
+	for (int i = 0; i < TOTAL_THREADS; i++) {
+		stacks[i] = pool_stacks[i];
+	}
+
+	/* Queues can't be stopped, so each one gets its own threads and
+	 * is left idle once measured.
+	 */
+	for (int nthreads = 1, used = 0; nthreads <= MAX_THREADS;
+	     used += nthreads, nthreads *= 2) {
+		k_work_queue_start_pool(&queues[q], &pool_threads[used],
+					&stacks[used], STACK_SIZE, nthreads,
+					POOL_PRIO, &cfg);
+		run(&queues[q++], nthreads);
+	}
+
+	printk("fin\n");
+}
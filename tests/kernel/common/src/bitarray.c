@@ -11,6 +11,7 @@
 #include <zephyr/tc_util.h>
 #include <zephyr/sys/bitarray.h>
 #include <zephyr/sys/util.h>
+#include <zephyr/random/rand32.h>
 
 #ifdef CONFIG_BIG_ENDIAN
 #define BIT_INDEX(bit)  ((3 - ((bit >> 3) & 0x3)) + 4*(bit >> 5))
@@ -502,6 +503,83 @@ ZTEST(bitarray, test_bitarray_alloc_free)
 	alloc_and_free_interval();
 }
 
+/* First fit, bit by bit */
+static int alloc_reference(sys_bitarray_t *ba, size_t num_bits,
+			   size_t *offset)
+{
+	size_t off;
+
+	for (off = 0; off + num_bits <= ba->num_bits; off++) {
+		if (sys_bitarray_is_region_cleared(ba, num_bits, off)) {
+			*offset = off;
+			return 0;
+		}
+	}
+
+	return -ENOSPC;
+}
+
+/**
+ * @brief Test bitarrays allocation against a bit by bit search
+ *
+ * @details Allocate and free regions of random sizes, so that the
+ * bitarray gets fragmented, and check that each allocation takes the
+ * first large enough region.
+ *
+ * @see sys_bitarray_alloc()
+ */
+ZTEST(bitarray, test_bitarray_alloc_first_fit)
+{
+	SYS_BITARRAY_DEFINE_STATIC(ba, 1000);
+	size_t offsets[32], sizes[32];
+	size_t count = 0;
+	size_t offset, expected_offset;
+	size_t num_bits;
+	uint32_t r;
+	int ret, expected_ret;
+	int i;
+
+	for (i = 0; i < 400; i++) {
+		r = sys_rand32_get();
+
+		if ((count == ARRAY_SIZE(offsets)) ||
+		    ((count > 0) && ((r >> 16) % 3 == 0))) {
+			/* Free a random region */
+			size_t j = (r >> 8) % count;
+
+			ret = sys_bitarray_free(&ba, sizes[j], offsets[j]);
+			zassert_equal(ret, 0, "sys_bitarray_free() failed: %d", ret);
+
+			count--;
+			offsets[j] = offsets[count];
+			sizes[j] = sizes[count];
+			continue;
+		}
+
+		/* Mostly small regions, some up to the whole bitarray */
+		num_bits = 1 + (r >> 8) % (((r >> 20) % 8 == 0) ? 1000 : 64);
+
+		expected_ret = alloc_reference(&ba, num_bits, &expected_offset);
+		ret = sys_bitarray_alloc(&ba, num_bits, &offset);
+		zassert_equal(ret, expected_ret,
+			      "sys_bitarray_alloc(%zu) returned %d, expected %d",
+			      num_bits, ret, expected_ret);
+		if (ret != 0) {
+			continue;
+		}
+
+		zassert_equal(offset, expected_offset,
+			      "sys_bitarray_alloc(%zu) offset expected %zu, got %zu",
+			      num_bits, expected_offset, offset);
+		zassert_true(sys_bitarray_is_region_set(&ba, num_bits, offset),
+			     "sys_bitarray_alloc() failed to set the region");
+
+		offsets[count] = offset;
+		sizes[count] = num_bits;
+		count++;
+	}
+}
+
 ZTEST(bitarray, test_bitarray_region_set_clear)
 {
 	int ret;
@@ -0,0 +1,235 @@
+/*
+ * Copyright (c) 2022 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "test_msgq.h"
+
+static K_THREAD_STACK_DEFINE(zc_stack, STACK_SIZE);
+static struct k_thread zc_thread;
+static char __aligned(4) zc_buffer[MSG_SIZE * MSGQ_LEN];
+static struct k_msgq zc_msgq;
+static uint32_t data[MSGQ_LEN] = { MSG0, MSG1 };
+static K_SEM_DEFINE(zc_sem, 0, 1);
+
+static void zc_reader_entry(void *p1, void *p2, void *p3)
+{
+	void *msg;
+
+	zassert_equal(k_msgq_peek_ref(&zc_msgq, &msg, K_FOREVER), 0);
+	zassert_equal(*(uint32_t *)msg, MSG0);
+	zassert_equal(k_msgq_release(&zc_msgq), 0);
+
+	k_sem_give(&zc_sem);
+}
+
+static void zc_writer_entry(void *p1, void *p2, void *p3)
+{
+	void *msg;
+
+	zassert_equal(k_msgq_reserve(&zc_msgq, &msg, K_FOREVER), 0);
+	*(uint32_t *)msg = MSG1;
+	zassert_equal(k_msgq_commit(&zc_msgq), 0);
+
+	k_sem_give(&zc_sem);
+}
+
+static void zc_put_entry(void *p1, void *p2, void *p3)
+{
+	zassert_equal(k_msgq_put(&zc_msgq, &data[1], K_FOREVER), 0);
+
+	k_sem_give(&zc_sem);
+}
+
+static void zc_get_entry(void *p1, void *p2, void *p3)
+{
+	uint32_t rx_data;
+
+	zassert_equal(k_msgq_get(&zc_msgq, &rx_data, K_FOREVER), 0);
+	zassert_equal(rx_data, MSG1);
+
+	k_sem_give(&zc_sem);
+}
+
+static void zc_purge_entry(void *p1, void *p2, void *p3)
+{
+	k_msgq_purge(&zc_msgq);
+
+	k_sem_give(&zc_sem);
+}
+
+/**
+ * @addtogroup kernel_message_queue_tests
+ * @{
+ */
+
+/**
+ * @brief Test writing and reading messages in place
+ * @details
+ * - Reserve, fill and commit slots until the queue is full, and verify
+ *   copying senders not waiting are refused while a slot is reserved.
+ * - Claim and release the messages, and verify they come out in order
+ *   from the ring buffer itself while copying receivers not waiting are
+ *   refused.
+ * @see k_msgq_reserve(), k_msgq_commit(), k_msgq_peek_ref(),
+ * k_msgq_release()
+ */
+ZTEST(msgq_api, test_msgq_zero_copy)
+{
+	void *msg, *other;
+
+	k_msgq_init(&zc_msgq, zc_buffer, MSG_SIZE, MSGQ_LEN);
+
+	zassert_equal(k_msgq_commit(&zc_msgq), -EINVAL);
+	zassert_equal(k_msgq_release(&zc_msgq), -EINVAL);
+
+	for (int i = 0; i < MSGQ_LEN; i++) {
+		zassert_equal(k_msgq_reserve(&zc_msgq, &msg, K_NO_WAIT), 0);
+		zassert_true((char *)msg >= zc_buffer &&
+			     (char *)msg < zc_buffer + sizeof(zc_buffer));
+
+		zassert_equal(k_msgq_reserve(&zc_msgq, &other, K_NO_WAIT),
+			      -EBUSY);
+		zassert_equal(k_msgq_put(&zc_msgq, &data[i], K_NO_WAIT),
+			      -EBUSY);
+		zassert_equal(k_msgq_num_used_get(&zc_msgq), i);
+
+		*(uint32_t *)msg = data[i];
+		zassert_equal(k_msgq_commit(&zc_msgq), 0);
+	}
+
+	zassert_equal(k_msgq_reserve(&zc_msgq, &msg, K_NO_WAIT), -ENOMSG);
+
+	for (int i = 0; i < MSGQ_LEN; i++) {
+		uint32_t rx_data;
+
+		zassert_equal(k_msgq_peek_ref(&zc_msgq, &msg, K_NO_WAIT), 0);
+		zassert_equal(*(uint32_t *)msg, data[i]);
+
+		zassert_equal(k_msgq_peek_ref(&zc_msgq, &other, K_NO_WAIT),
+			      -EBUSY);
+		zassert_equal(k_msgq_get(&zc_msgq, &rx_data, K_NO_WAIT),
+			      -EBUSY);
+
+		zassert_equal(k_msgq_release(&zc_msgq), 0);
+	}
+
+	zassert_equal(k_msgq_peek_ref(&zc_msgq, &msg, K_NO_WAIT), -ENOMSG);
+	zassert_equal(k_msgq_num_used_get(&zc_msgq), 0);
+}
+
+/**
+ * @brief Test blocking zero-copy readers and writers
+ * @details
+ * - A thread waiting in k_msgq_peek_ref() on an empty queue is handed
+ *   the message committed by another thread.
+ * - A thread waiting in k_msgq_reserve() on a full queue is handed the
+ *   slot freed by k_msgq_get().
+ * @see k_msgq_reserve(), k_msgq_commit(), k_msgq_peek_ref(),
+ * k_msgq_release()
+ */
+ZTEST(msgq_api_1cpu, test_msgq_zero_copy_pend)
+{
+	int pri = k_thread_priority_get(k_current_get()) - 1;
+	uint32_t rx_data;
+	void *msg;
+
+	k_msgq_init(&zc_msgq, zc_buffer, MSG_SIZE, 1);
+
+	k_thread_create(&zc_thread, zc_stack, STACK_SIZE, zc_reader_entry,
+			NULL, NULL, NULL, pri, 0, K_NO_WAIT);
+
+	zassert_equal(k_msgq_reserve(&zc_msgq, &msg, K_NO_WAIT), 0);
+	*(uint32_t *)msg = MSG0;
+	zassert_equal(k_msgq_commit(&zc_msgq), 0);
+
+	zassert_equal(k_sem_take(&zc_sem, TIMEOUT), 0);
+	zassert_equal(k_msgq_num_used_get(&zc_msgq), 0);
+	k_thread_join(&zc_thread, K_FOREVER);
+
+	zassert_equal(k_msgq_put(&zc_msgq, &data[0], K_NO_WAIT), 0);
+
+	k_thread_create(&zc_thread, zc_stack, STACK_SIZE, zc_writer_entry,
+			NULL, NULL, NULL, pri, 0, K_NO_WAIT);
+
+	zassert_equal(k_msgq_get(&zc_msgq, &rx_data, K_NO_WAIT), 0);
+	zassert_equal(rx_data, MSG0);
+
+	zassert_equal(k_sem_take(&zc_sem, TIMEOUT), 0);
+	zassert_equal(k_msgq_get(&zc_msgq, &rx_data, K_NO_WAIT), 0);
+	zassert_equal(rx_data, MSG1);
+	k_thread_join(&zc_thread, K_FOREVER);
+}
+
+/**
+ * @brief Test copying senders and receivers waiting for zero-copy access
+ * @details
+ * - A thread putting a message while a slot is reserved waits for the
+ *   commit, and its message comes after the committed one.
+ * - A thread getting a message while the first one is claimed waits for
+ *   the release, and gets the next message.
+ * @see k_msgq_reserve(), k_msgq_commit(), k_msgq_peek_ref(),
+ * k_msgq_release()
+ */
+ZTEST(msgq_api_1cpu, test_msgq_zero_copy_busy)
+{
+	int pri = k_thread_priority_get(k_current_get()) - 1;
+	void *msg;
+
+	k_msgq_init(&zc_msgq, zc_buffer, MSG_SIZE, MSGQ_LEN);
+
+	zassert_equal(k_msgq_reserve(&zc_msgq, &msg, K_NO_WAIT), 0);
+	k_thread_create(&zc_thread, zc_stack, STACK_SIZE, zc_put_entry,
+			NULL, NULL, NULL, pri, 0, K_NO_WAIT);
+	zassert_equal(k_sem_take(&zc_sem, K_NO_WAIT), -EBUSY);
+
+	*(uint32_t *)msg = MSG0;
+	zassert_equal(k_msgq_commit(&zc_msgq), 0);
+	zassert_equal(k_sem_take(&zc_sem, TIMEOUT), 0);
+	k_thread_join(&zc_thread, K_FOREVER);
+	zassert_equal(k_msgq_num_used_get(&zc_msgq), 2);
+
+	zassert_equal(k_msgq_peek_ref(&zc_msgq, &msg, K_NO_WAIT), 0);
+	zassert_equal(*(uint32_t *)msg, MSG0);
+	k_thread_create(&zc_thread, zc_stack, STACK_SIZE, zc_get_entry,
+			NULL, NULL, NULL, pri, 0, K_NO_WAIT);
+	zassert_equal(k_sem_take(&zc_sem, K_NO_WAIT), -EBUSY);
+
+	zassert_equal(k_msgq_release(&zc_msgq), 0);
+	zassert_equal(k_sem_take(&zc_sem, TIMEOUT), 0);
+	k_thread_join(&zc_thread, K_FOREVER);
+	zassert_equal(k_msgq_num_used_get(&zc_msgq), 0);
+}
+
+/**
+ * @brief Test purging a message queue with a reserved slot
+ * @details
+ * - Purging waits for the reservation to be committed, so that the slot
+ *   isn't reused while it is written, then drops the message.
+ * @see k_msgq_reserve(), k_msgq_commit(), k_msgq_purge()
+ */
+ZTEST(msgq_api_1cpu, test_msgq_zero_copy_purge)
+{
+	int pri = k_thread_priority_get(k_current_get()) - 1;
+	void *msg;
+
+	k_msgq_init(&zc_msgq, zc_buffer, MSG_SIZE, MSGQ_LEN);
+
+	zassert_equal(k_msgq_put(&zc_msgq, &data[0], K_NO_WAIT), 0);
+	zassert_equal(k_msgq_reserve(&zc_msgq, &msg, K_NO_WAIT), 0);
+	k_thread_create(&zc_thread, zc_stack, STACK_SIZE, zc_purge_entry,
+			NULL, NULL, NULL, pri, 0, K_NO_WAIT);
+	zassert_equal(k_sem_take(&zc_sem, K_NO_WAIT), -EBUSY);
+	zassert_equal(k_msgq_num_used_get(&zc_msgq), 1);
+
+	*(uint32_t *)msg = MSG1;
+	zassert_equal(k_msgq_commit(&zc_msgq), 0);
+	zassert_equal(k_sem_take(&zc_sem, TIMEOUT), 0);
+	k_thread_join(&zc_thread, K_FOREVER);
+	zassert_equal(k_msgq_num_used_get(&zc_msgq), 0);
+}
+
+/**
+ * @}
+ */
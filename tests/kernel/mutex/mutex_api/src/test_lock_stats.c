@@ -0,0 +1,128 @@
+/*
+ * Copyright (c) 2022 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/ztest.h>
+
+#ifdef CONFIG_LOCK_STATS
+
+#define HOLDER_STACK_SIZE (512 + CONFIG_TEST_EXTRA_STACK_SIZE)
+#define HOLD_MS 20
+
+static struct k_lock_stats all_stats[CONFIG_LOCK_STATS_MAX_LOCKS];
+static struct k_spinlock stats_spinlock;
+static K_MUTEX_DEFINE(stats_mutex);
+
+static struct k_thread waiter_thread;
+static K_THREAD_STACK_DEFINE(waiter_stack, HOLDER_STACK_SIZE);
+
+static const struct k_lock_stats *stats_find(const void *lock)
+{
+	int n = k_lock_stats_get(all_stats, ARRAY_SIZE(all_stats));
+
+	for (int i = 0; i < n; i++) {
+		if (all_stats[i].lock == lock) {
+			return &all_stats[i];
+		}
+	}
+
+	return NULL;
+}
+
+static void waiter(void *p1, void *p2, void *p3)
+{
+	ARG_UNUSED(p1);
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	k_mutex_lock(&stats_mutex, K_FOREVER);
+	k_mutex_unlock(&stats_mutex);
+}
+
+static void lock_stats_before(void *fixture)
+{
+	ARG_UNUSED(fixture);
+
+	k_lock_stats_reset();
+}
+
+/* Uncontended spinlock acquisitions are counted with their hold time. */
+ZTEST(lock_stats, test_spinlock_stats)
+{
+	const struct k_lock_stats *stats;
+
+	for (int i = 0; i < 5; i++) {
+		k_spinlock_key_t key = k_spin_lock(&stats_spinlock);
+
+		k_busy_wait(100);
+		k_spin_unlock(&stats_spinlock, key);
+	}
+
+	stats = stats_find(&stats_spinlock);
+	zassert_not_null(stats, "spinlock not tracked");
+	zassert_false(stats->mutex, NULL);
+	zassert_equal(stats->acquisitions, 5, NULL);
+	zassert_equal(stats->contended, 0, NULL);
+	zassert_true(stats->max_hold_cycles >= k_us_to_cyc_floor32(100),
+		     NULL);
+	zassert_not_null(stats->max_hold_site, NULL);
+}
+
+/* Waiting for a mutex held by another thread counts as contention, and
+ * recursive locks by the owner are not counted.
+ */
+ZTEST(lock_stats, test_mutex_stats)
+{
+	const struct k_lock_stats *stats;
+
+	k_mutex_lock(&stats_mutex, K_FOREVER);
+	k_mutex_lock(&stats_mutex, K_FOREVER);
+
+	k_thread_create(&waiter_thread, waiter_stack,
+			K_THREAD_STACK_SIZEOF(waiter_stack), waiter, NULL,
+			NULL, NULL, K_PRIO_PREEMPT(0), 0, K_NO_WAIT);
+	k_msleep(HOLD_MS);
+
+	k_mutex_unlock(&stats_mutex);
+	k_mutex_unlock(&stats_mutex);
+	k_thread_join(&waiter_thread, K_FOREVER);
+
+	stats = stats_find(&stats_mutex);
+	zassert_not_null(stats, "mutex not tracked");
+	zassert_true(stats->mutex, NULL);
+	zassert_equal(stats->acquisitions, 2, NULL);
+	zassert_equal(stats->contended, 1, NULL);
+	zassert_true(stats->wait_cycles >= k_ms_to_cyc_floor32(HOLD_MS / 2),
+		     NULL);
+	zassert_true(stats->max_hold_cycles >= k_ms_to_cyc_floor32(HOLD_MS / 2),
+		     NULL);
+
+	/* It's the most contended lock around */
+	zassert_equal(k_lock_stats_get(all_stats, 1), 1, NULL);
+	zassert_equal(all_stats[0].lock, &stats_mutex, NULL);
+}
+
+/* A reset drops the statistics of every lock, held ones included. */
+ZTEST(lock_stats, test_reset)
+{
+	k_spinlock_key_t key = k_spin_lock(&stats_spinlock);
+
+	k_spin_unlock(&stats_spinlock, key);
+	zassert_not_null(stats_find(&stats_spinlock), NULL);
+
+	k_mutex_lock(&stats_mutex, K_FOREVER);
+	k_lock_stats_reset();
+	zassert_is_null(stats_find(&stats_spinlock), NULL);
+	zassert_is_null(stats_find(&stats_mutex), NULL);
+	k_mutex_unlock(&stats_mutex);
+
+	key = k_spin_lock(&stats_spinlock);
+	k_spin_unlock(&stats_spinlock, key);
+	zassert_equal(stats_find(&stats_spinlock)->acquisitions, 1, NULL);
+}
+
+ZTEST_SUITE(lock_stats, NULL, NULL, lock_stats_before, NULL, NULL);
+
+#endif /* CONFIG_LOCK_STATS */
@@ -0,0 +1,197 @@
+/*
+ * Copyright (c) 2022 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/ztest.h>
+#include <zephyr/kernel.h>
+
+#define N_SEMS 8
+#define STACK_SIZE (1024 + CONFIG_TEST_EXTRA_STACK_SIZE)
+
+static struct k_poll_set set;
+static struct k_sem sems[N_SEMS];
+static struct k_poll_event sem_events[N_SEMS];
+static struct k_fifo fifo;
+static struct k_poll_event fifo_event;
+static struct k_poll_signal signal;
+static struct k_poll_event signal_event;
+
+static struct k_thread giver_thread;
+K_THREAD_STACK_DEFINE(giver_stack, STACK_SIZE);
+
+static void setup_set(void)
+{
+	k_poll_set_init(&set);
+
+	for (int i = 0; i < N_SEMS; i++) {
+		k_sem_init(&sems[i], 0, 2);
+		k_poll_event_init(&sem_events[i], K_POLL_TYPE_SEM_AVAILABLE,
+				  K_POLL_MODE_NOTIFY_ONLY, &sems[i]);
+		zassert_equal(k_poll_set_add(&set, &sem_events[i]), 0, NULL);
+	}
+}
+
+static void teardown_set(void)
+{
+	for (int i = 0; i < N_SEMS; i++) {
+		zassert_equal(k_poll_set_remove(&set, &sem_events[i]), 0, NULL);
+	}
+}
+
+/**
+ * @brief Test that a poll set only returns the events that are ready
+ *
+ * @ingroup kernel_poll_tests
+ *
+ * @see k_poll_set_add(), k_poll_set_wait()
+ */
+ZTEST(poll_api_1cpu, test_poll_set_ready_subset)
+{
+	struct k_poll_event *ready[N_SEMS];
+	int n;
+
+	setup_set();
+
+	zassert_equal(k_poll_set_wait(&set, ready, N_SEMS, K_NO_WAIT),
+		      -EAGAIN, "nothing should be ready");
+
+	k_sem_give(&sems[2]);
+	k_sem_give(&sems[5]);
+	k_sem_give(&sems[5]);
+
+	n = k_poll_set_wait(&set, ready, N_SEMS, K_NO_WAIT);
+	zassert_equal(n, 2, "expected two ready events, got %d", n);
+	zassert_equal_ptr(ready[0], &sem_events[2], NULL);
+	zassert_equal_ptr(ready[1], &sem_events[5], NULL);
+	zassert_equal(ready[0]->state, K_POLL_STATE_SEM_AVAILABLE, NULL);
+	zassert_equal(ready[1]->state, K_POLL_STATE_SEM_AVAILABLE, NULL);
+
+	/* Level triggered: only what is still available comes back */
+	zassert_equal(k_sem_take(&sems[2], K_NO_WAIT), 0, NULL);
+	zassert_equal(k_sem_take(&sems[5], K_NO_WAIT), 0, NULL);
+
+	n = k_poll_set_wait(&set, ready, N_SEMS, K_NO_WAIT);
+	zassert_equal(n, 1, "expected one ready event, got %d", n);
+	zassert_equal_ptr(ready[0], &sem_events[5], NULL);
+
+	zassert_equal(k_sem_take(&sems[5], K_NO_WAIT), 0, NULL);
+	zassert_equal(k_poll_set_wait(&set, ready, N_SEMS, K_NO_WAIT),
+		      -EAGAIN, "nothing should be ready");
+
+	/* Registrations survive being signaled */
+	k_sem_give(&sems[7]);
+	n = k_poll_set_wait(&set, ready, 1, K_NO_WAIT);
+	zassert_equal(n, 1, NULL);
+	zassert_equal_ptr(ready[0], &sem_events[7], NULL);
+	zassert_equal(k_sem_take(&sems[7], K_NO_WAIT), 0, NULL);
+
+	teardown_set();
+}
+
+static void giver_fn(void *p1, void *p2, void *p3)
+{
+	static struct fifo_item {
+		void *fifo_reserved;
+		uint32_t value;
+	} item = { NULL, 0x600d };
+
+	ARG_UNUSED(p1);
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	k_msleep(10);
+	k_fifo_put(&fifo, &item);
+}
+
+/**
+ * @brief Test blocking on a poll set and adding/removing events
+ *
+ * @ingroup kernel_poll_tests
+ *
+ * @see k_poll_set_init(), k_poll_set_add(), k_poll_set_remove(),
+ * k_poll_set_wait()
+ */
+ZTEST(poll_api_1cpu, test_poll_set_wait)
+{
+	struct k_poll_event *ready[2];
+	unsigned int signaled;
+	int result;
+
+	setup_set();
+
+	k_fifo_init(&fifo);
+	k_poll_event_init(&fifo_event, K_POLL_TYPE_FIFO_DATA_AVAILABLE,
+			  K_POLL_MODE_NOTIFY_ONLY, &fifo);
+	zassert_equal(k_poll_set_add(&set, &fifo_event), 0, NULL);
+	zassert_equal(k_poll_set_add(&set, &fifo_event), -EBUSY, NULL);
+
+	/* An event that is ready when added is reported right away */
+	k_poll_signal_init(&signal);
+	k_poll_signal_raise(&signal, 0x1ee7);
+	k_poll_event_init(&signal_event, K_POLL_TYPE_SIGNAL,
+			  K_POLL_MODE_NOTIFY_ONLY, &signal);
+	zassert_equal(k_poll_set_add(&set, &signal_event), 0, NULL);
+
+	zassert_equal(k_poll_set_wait(&set, ready, 2, K_NO_WAIT), 1, NULL);
+	zassert_equal_ptr(ready[0], &signal_event, NULL);
+	zassert_equal(ready[0]->state, K_POLL_STATE_SIGNALED, NULL);
+	k_poll_signal_check(&signal, &signaled, &result);
+	zassert_equal(result, 0x1ee7, NULL);
+	k_poll_signal_reset(&signal);
+
+	zassert_equal(k_poll_set_wait(&set, ready, 2, K_MSEC(1)), -EAGAIN,
+		      NULL);
+
+	k_thread_create(&giver_thread, giver_stack, STACK_SIZE, giver_fn,
+			NULL, NULL, NULL, K_PRIO_PREEMPT(0), 0, K_NO_WAIT);
+
+	zassert_equal(k_poll_set_wait(&set, ready, 2, K_FOREVER), 1, NULL);
+	zassert_equal_ptr(ready[0], &fifo_event, NULL);
+	zassert_equal(ready[0]->state, K_POLL_STATE_FIFO_DATA_AVAILABLE, NULL);
+	zassert_not_null(k_fifo_get(&fifo, K_NO_WAIT), NULL);
+	k_thread_join(&giver_thread, K_FOREVER);
+
+	zassert_equal(k_poll_set_remove(&set, &fifo_event), 0, NULL);
+	zassert_equal(k_poll_set_remove(&set, &fifo_event), -EINVAL, NULL);
+	zassert_equal(k_poll_set_remove(&set, &signal_event), 0, NULL);
+
+	/* Removed events no longer wake the set up */
+	k_poll_signal_raise(&signal, 0);
+	zassert_equal(k_poll_set_wait(&set, ready, 2, K_NO_WAIT), -EAGAIN,
+		      NULL);
+	zassert_true(sys_dlist_is_empty(&signal.poll_events), NULL);
+
+	teardown_set();
+}
+
+/**
+ * @brief Test k_poll() on an object that is also part of a poll set
+ *
+ * @ingroup kernel_poll_tests
+ *
+ * @see k_poll_set_add(), k_poll()
+ */
+ZTEST(poll_api_1cpu, test_poll_set_and_k_poll)
+{
+	struct k_poll_event *ready[1];
+	struct k_poll_event event;
+
+	setup_set();
+
+	k_poll_event_init(&event, K_POLL_TYPE_SEM_AVAILABLE,
+			  K_POLL_MODE_NOTIFY_ONLY, &sems[0]);
+	zassert_equal(k_poll(&event, 1, K_NO_WAIT), -EAGAIN, NULL);
+
+	k_sem_give(&sems[0]);
+	zassert_equal(k_poll(&event, 1, K_NO_WAIT), 0, NULL);
+	zassert_equal(event.state, K_POLL_STATE_SEM_AVAILABLE, NULL);
+
+	/* The set was signaled too, and still sees the semaphore */
+	zassert_equal(k_poll_set_wait(&set, ready, 1, K_NO_WAIT), 1, NULL);
+	zassert_equal_ptr(ready[0], &sem_events[0], NULL);
+	zassert_equal(k_sem_take(&sems[0], K_NO_WAIT), 0, NULL);
+
+	teardown_set();
+}
@@ -873,6 +873,69 @@ ZTEST(semaphore, test_sem_multiple_threads_wait)
 	}
 }
 
+/**
+ * @brief Test giving several semaphore units at once
+ * @details
+ * - Give fewer units than there are waiters and verify that exactly
+ *   that many waiters are woken up, without the count changing.
+ * - Give more units than there are waiters and verify the remaining
+ *   waiters are woken up and the excess is added to the count.
+ * - Verify the count saturates at the semaphore's limit.
+ * @ingroup kernel_semaphore_tests
+ * @see k_sem_give_n()
+ */
+ZTEST(semaphore, test_sem_give_n)
+{
+	const int first = TOTAL_THREADS_WAITING - 2;
+
+	k_sem_reset(&simple_sem);
+	k_sem_reset(&multiple_thread_sem);
+
+	for (int i = 0; i < TOTAL_THREADS_WAITING; i++) {
+		k_thread_create(&multiple_tid[i],
+				multiple_stack[i], STACK_SIZE,
+				sem_multiple_threads_wait_helper,
+				NULL, NULL, NULL,
+				K_PRIO_PREEMPT(1),
+				K_USER | K_INHERIT_PERMS, K_NO_WAIT);
+	}
+
+	/* giving time for the other threads to block */
+	k_sleep(K_MSEC(500));
+
+	k_sem_give_n(&multiple_thread_sem, first);
+	k_sleep(K_MSEC(500));
+
+	for (int i = 0; i < first; i++) {
+		expect_k_sem_take(&simple_sem, K_NO_WAIT, 0,
+			"Too few threads got multiple_thread_sem: %d != %d");
+	}
+	expect_k_sem_take(&simple_sem, K_NO_WAIT, -EBUSY,
+		"Too many threads got multiple_thread_sem: %d != %d");
+	expect_k_sem_count_get_nomsg(&multiple_thread_sem, 0U);
+
+	/* wake the remaining waiters, the rest goes to the count */
+	k_sem_give_n(&multiple_thread_sem, SEM_MAX_VAL);
+	k_sleep(K_MSEC(500));
+
+	for (int i = first; i < TOTAL_THREADS_WAITING; i++) {
+		expect_k_sem_take(&simple_sem, K_NO_WAIT, 0,
+			"Some of the threads did not get multiple_thread_sem: %d != %d");
+	}
+	expect_k_sem_count_get_nomsg(&multiple_thread_sem,
+				     SEM_MAX_VAL - (TOTAL_THREADS_WAITING - first));
+
+	/* the count does not go past the limit */
+	k_sem_give_n(&multiple_thread_sem, SEM_MAX_VAL);
+	expect_k_sem_count_get_nomsg(&multiple_thread_sem, SEM_MAX_VAL);
+
+	k_sem_reset(&multiple_thread_sem);
+
+	for (int i = 0; i < TOTAL_THREADS_WAITING; i++) {
+		k_thread_join(&multiple_tid[i], K_FOREVER);
+	}
+}
+
 /**
  * @brief Test semaphore timeout period
  * @ingroup kernel_semaphore_tests
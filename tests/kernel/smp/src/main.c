@@ -594,10 +594,12 @@ ZTEST(smp, test_get_cpu)
 #ifdef CONFIG_TRACE_SCHED_IPI
 /* global variable for testing send IPI */
 static volatile int sched_ipi_has_called;
+static volatile int sched_ipi_cpu_called[CONFIG_MP_MAX_NUM_CPUS];
 
 void z_trace_sched_ipi(void)
 {
 	sched_ipi_has_called++;
+	sched_ipi_cpu_called[arch_curr_cpu()->id]++;
 }
 #endif
 
@@ -673,6 +675,44 @@ ZTEST(smp, test_smp_ipi)
 }
 #endif
 
+/**
+ * @brief Test directed interprocessor interrupts
+ *
+ * @ingroup kernel_smp_integration_tests
+ *
+ * @details Send arch_sched_directed_ipi() to each CPU in turn and
+ * check that the scheduler IPI hook ran on that CPU.
+ *
+ * @see arch_sched_directed_ipi()
+ */
+#ifdef CONFIG_ARCH_HAS_DIRECTED_IPIS
+ZTEST(smp, test_smp_directed_ipi)
+{
+#ifndef CONFIG_TRACE_SCHED_IPI
+	ztest_test_skip();
+#endif
+
+	unsigned int num_cpus = arch_num_cpus();
+
+	for (int target = 0; target < num_cpus; target++) {
+		for (int i = 0; i < num_cpus; i++) {
+			sched_ipi_cpu_called[i] = 0;
+		}
+
+		arch_sched_directed_ipi(BIT(target));
+
+		k_msleep(100);
+
+		/**TESTPOINT: the target entered the IPI handler.  Other
+		 * CPUs may legitimately see scheduler IPIs too (e.g. when
+		 * this thread wakes up), so they are not checked.
+		 */
+		zassert_true(sched_ipi_cpu_called[target] != 0,
+			     "CPU %d did not receive IPI", target);
+	}
+}
+#endif
+
 void k_sys_fatal_error_handler(unsigned int reason, const z_arch_esf_t *esf)
 {
 	static int trigger;
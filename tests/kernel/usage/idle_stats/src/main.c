@@ -0,0 +1,86 @@
+/*
+ * Copyright (c) 2022 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/ztest.h>
+
+#define SLEEP_MS 50
+#define N_SLEEPS 5
+#define TIMER_MS 10
+
+static K_TIMER_DEFINE(test_timer, NULL, NULL);
+
+static void idle_before(void *fixture)
+{
+	ARG_UNUSED(fixture);
+
+	k_idle_stats_reset();
+}
+
+ZTEST(idle_stats, test_invalid)
+{
+	struct k_idle_stats stats;
+
+	zassert_equal(k_idle_stats_get(-1, &stats), -EINVAL, NULL);
+	zassert_equal(k_idle_stats_get(arch_num_cpus(), &stats), -EINVAL,
+		      NULL);
+	zassert_equal(k_idle_stats_get(0, NULL), -EINVAL, NULL);
+}
+
+/* Sleeping puts the CPU in idle periods ended by the thread timeout. */
+ZTEST(idle_stats, test_residency)
+{
+	struct k_idle_stats stats;
+	struct k_idle_wakeup wakeup;
+	uint32_t periods = 0;
+	int bucket = find_msb_set(SLEEP_MS * 1000 / 2) - 1;
+
+	for (int i = 0; i < N_SLEEPS; i++) {
+		k_msleep(SLEEP_MS);
+	}
+
+	zassert_equal(k_idle_stats_get(0, &stats), 0, NULL);
+	zassert_true(stats.timeout_wakeups >= N_SLEEPS, NULL);
+	zassert_true(stats.idle_us >= N_SLEEPS * SLEEP_MS * 1000 / 2,
+		     "idle %u ms", (uint32_t)(stats.idle_us / 1000U));
+	zassert_true(stats.longest_us >= SLEEP_MS * 1000 / 2, NULL);
+
+	/* Most of each sleep is one long idle period (ticked kernels
+	 * wake up for every tick though)
+	 */
+	for (int i = 0; i < K_IDLE_STATS_BUCKETS; i++) {
+		periods += stats.periods[i];
+	}
+	zassert_equal(periods, stats.timeout_wakeups + stats.tick_wakeups +
+		      stats.other_wakeups, NULL);
+	if (IS_ENABLED(CONFIG_TICKLESS_KERNEL)) {
+		zassert_true(stats.periods[bucket] +
+			     stats.periods[bucket + 1] >= N_SLEEPS, NULL);
+	}
+
+	zassert_equal(k_idle_wakeups_get(&wakeup, 1), 1, NULL);
+	zassert_equal(wakeup.last, &k_current_get()->base.timeout, NULL);
+	zassert_true(wakeup.count >= N_SLEEPS, NULL);
+}
+
+/* Wakeup sources are attributed to their callbacks, most frequent first. */
+ZTEST(idle_stats, test_wakeup_sources)
+{
+	struct k_idle_wakeup wakeups[2];
+
+	k_timer_start(&test_timer, K_MSEC(TIMER_MS), K_MSEC(TIMER_MS));
+	k_msleep(10 * TIMER_MS + TIMER_MS / 2);
+	k_timer_stop(&test_timer);
+
+	zassert_equal(k_idle_wakeups_get(wakeups, ARRAY_SIZE(wakeups)), 2,
+		      NULL);
+	zassert_true(wakeups[0].count >= wakeups[1].count, NULL);
+	zassert_equal(wakeups[0].last, &test_timer.timeout, NULL);
+	zassert_true(wakeups[0].count >= 9, "count %u", wakeups[0].count);
+	zassert_equal(wakeups[1].last, &k_current_get()->base.timeout, NULL);
+	zassert_equal(k_idle_wakeups_get(wakeups, 0), 0, NULL);
+}
+
+ZTEST_SUITE(idle_stats, NULL, NULL, idle_before, NULL, NULL);
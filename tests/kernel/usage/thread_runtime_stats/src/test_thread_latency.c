@@ -0,0 +1,78 @@
+/*
+ * Copyright (c) 2022 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/ztest.h>
+
+#ifdef CONFIG_SCHED_THREAD_LATENCY
+
+#define WAKER_STACK_SIZE (512 + CONFIG_TEST_EXTRA_STACK_SIZE)
+#define N_WAKEUPS 10
+
+static struct k_thread waiter_thread;
+static K_THREAD_STACK_DEFINE(waiter_stack, WAKER_STACK_SIZE);
+static K_SEM_DEFINE(wake_sem, 0, 1);
+static K_SEM_DEFINE(done_sem, 0, 1);
+
+static void waiter(void *p1, void *p2, void *p3)
+{
+	ARG_UNUSED(p1);
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	for (int i = 0; i < N_WAKEUPS; i++) {
+		k_sem_take(&wake_sem, K_FOREVER);
+	}
+	k_sem_give(&done_sem);
+}
+
+static uint32_t latency_count(const k_thread_latency_stats_t *stats)
+{
+	uint32_t count = 0U;
+
+	for (int i = 0; i < K_THREAD_LATENCY_BUCKETS; i++) {
+		count += stats->hist[i];
+	}
+
+	return count;
+}
+
+/* Each wakeup of a thread records one latency. */
+ZTEST(latency_api, test_thread_latency)
+{
+	k_thread_latency_stats_t stats;
+	k_tid_t tid;
+
+	zassert_equal(k_thread_latency_stats_get(NULL, &stats), -EINVAL,
+		      NULL);
+	zassert_equal(k_thread_latency_stats_get(k_current_get(), NULL),
+		      -EINVAL, NULL);
+
+	/* Started, then woken up N_WAKEUPS times */
+	tid = k_thread_create(&waiter_thread, waiter_stack,
+			      K_THREAD_STACK_SIZEOF(waiter_stack), waiter,
+			      NULL, NULL, NULL, K_PRIO_PREEMPT(1), 0,
+			      K_NO_WAIT);
+
+	for (int i = 0; i < N_WAKEUPS; i++) {
+		k_msleep(1);
+		k_sem_give(&wake_sem);
+	}
+	zassert_equal(k_sem_take(&done_sem, K_MSEC(100)), 0, NULL);
+	k_thread_join(tid, K_FOREVER);
+
+	zassert_equal(k_thread_latency_stats_get(tid, &stats), 0, NULL);
+	zassert_equal(latency_count(&stats), N_WAKEUPS + 1, NULL);
+	zassert_true(stats.max_cycles < k_ms_to_cyc_ceil32(10), NULL);
+
+	zassert_equal(k_thread_latency_stats_reset(tid), 0, NULL);
+	zassert_equal(k_thread_latency_stats_get(tid, &stats), 0, NULL);
+	zassert_equal(latency_count(&stats), 0, NULL);
+	zassert_equal(stats.max_cycles, 0, NULL);
+}
+
+ZTEST_SUITE(latency_api, NULL, NULL, NULL, NULL, NULL);
+
+#endif /* CONFIG_SCHED_THREAD_LATENCY */
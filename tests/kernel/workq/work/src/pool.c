@@ -0,0 +1,161 @@
+/*
+ * Copyright (c) 2022 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/ztest.h>
+
+#ifdef CONFIG_WORK_QUEUE_POOL
+
+#define STACK_SIZE (1024 + CONFIG_TEST_EXTRA_STACK_SIZE)
+#define POOL_THREADS 3
+#define POOL_PRIORITY K_PRIO_PREEMPT(1)
+
+static K_THREAD_STACK_ARRAY_DEFINE(pool_stacks, POOL_THREADS, STACK_SIZE);
+static struct k_thread pool_threads[POOL_THREADS - 1];
+static struct k_work_q pool_queue;
+
+static struct k_work pool_work[POOL_THREADS];
+static struct k_work_sync pool_sync;
+
+/* Given by handlers when they start, and to let them complete */
+static struct k_sem started_sem;
+static struct k_sem release_sem;
+
+static atomic_t running;
+static atomic_t max_running;
+static atomic_t completed;
+
+static void blocking_handler(struct k_work *work)
+{
+	atomic_val_t now = atomic_inc(&running) + 1;
+
+	ARG_UNUSED(work);
+
+	if (now > atomic_get(&max_running)) {
+		atomic_set(&max_running, now);
+	}
+
+	k_sem_give(&started_sem);
+	k_sem_take(&release_sem, K_FOREVER);
+
+	atomic_dec(&running);
+	atomic_inc(&completed);
+}
+
+static void release_fn(struct k_timer *timer)
+{
+	ARG_UNUSED(timer);
+
+	k_sem_give(&release_sem);
+}
+
+static K_TIMER_DEFINE(release_timer, release_fn, NULL);
+
+static void *pool_setup(void)
+{
+	k_thread_stack_t *stacks[POOL_THREADS];
+
+	for (int i = 0; i < POOL_THREADS; i++) {
+		stacks[i] = pool_stacks[i];
+	}
+
+	k_work_queue_start_pool(&pool_queue, pool_threads, stacks, STACK_SIZE,
+				POOL_THREADS, POOL_PRIORITY, NULL);
+
+	return NULL;
+}
+
+static void pool_before(void *fixture)
+{
+	ARG_UNUSED(fixture);
+
+	k_sem_init(&started_sem, 0, POOL_THREADS);
+	k_sem_init(&release_sem, 0, POOL_THREADS);
+	atomic_set(&running, 0);
+	atomic_set(&max_running, 0);
+	atomic_set(&completed, 0);
+
+	for (int i = 0; i < POOL_THREADS; i++) {
+		k_work_init(&pool_work[i], blocking_handler);
+	}
+}
+
+/* All the threads of a pool take work items. */
+ZTEST(work_pool, test_pool_parallel)
+{
+	for (int i = 0; i < POOL_THREADS; i++) {
+		zassert_equal(k_work_submit_to_queue(&pool_queue, &pool_work[i]),
+			      1, NULL);
+	}
+
+	for (int i = 0; i < POOL_THREADS; i++) {
+		zassert_equal(k_sem_take(&started_sem, K_MSEC(100)), 0,
+			      "item %d did not start", i);
+	}
+	zassert_equal(atomic_get(&max_running), POOL_THREADS, NULL);
+
+	for (int i = 0; i < POOL_THREADS; i++) {
+		k_sem_give(&release_sem);
+	}
+	zassert_equal(k_work_queue_drain(&pool_queue, false), 1, NULL);
+	zassert_equal(atomic_get(&completed), POOL_THREADS, NULL);
+}
+
+/* An item resubmitted while running is not run by another thread. */
+ZTEST(work_pool, test_pool_no_reentrancy)
+{
+	struct k_work *wp = &pool_work[0];
+
+	zassert_equal(k_work_submit_to_queue(&pool_queue, wp), 1, NULL);
+	zassert_equal(k_sem_take(&started_sem, K_MSEC(100)), 0, NULL);
+
+	zassert_equal(k_work_submit_to_queue(&pool_queue, wp), 2, NULL);
+	zassert_equal(k_work_busy_get(wp), K_WORK_RUNNING | K_WORK_QUEUED,
+		      NULL);
+
+	/* Idle threads must leave it alone */
+	zassert_equal(k_sem_take(&started_sem, K_MSEC(50)), -EAGAIN, NULL);
+
+	k_sem_give(&release_sem);
+	zassert_equal(k_sem_take(&started_sem, K_MSEC(100)), 0, NULL);
+	k_sem_give(&release_sem);
+
+	zassert_equal(k_work_queue_drain(&pool_queue, false), 1, NULL);
+	zassert_equal(atomic_get(&max_running), 1, NULL);
+	zassert_equal(atomic_get(&completed), 2, NULL);
+}
+
+/* Flushing a running item waits for it even with idle threads. */
+ZTEST(work_pool, test_pool_running_flush)
+{
+	struct k_work *wp = &pool_work[0];
+
+	zassert_equal(k_work_submit_to_queue(&pool_queue, wp), 1, NULL);
+	zassert_equal(k_sem_take(&started_sem, K_MSEC(100)), 0, NULL);
+
+	k_timer_start(&release_timer, K_MSEC(50), K_NO_WAIT);
+	zassert_true(k_work_flush(wp, &pool_sync), NULL);
+	zassert_equal(atomic_get(&completed), 1, NULL);
+	zassert_equal(k_work_busy_get(wp), 0, NULL);
+}
+
+/* Cancelling a running item waits for it even with idle threads. */
+ZTEST(work_pool, test_pool_running_cancel_sync)
+{
+	struct k_work *wp = &pool_work[0];
+
+	zassert_equal(k_work_submit_to_queue(&pool_queue, wp), 1, NULL);
+	zassert_equal(k_sem_take(&started_sem, K_MSEC(100)), 0, NULL);
+	zassert_equal(k_work_submit_to_queue(&pool_queue, wp), 2, NULL);
+
+	k_timer_start(&release_timer, K_MSEC(50), K_NO_WAIT);
+	zassert_true(k_work_cancel_sync(wp, &pool_sync), NULL);
+	zassert_equal(atomic_get(&completed), 1, NULL);
+	zassert_equal(k_work_busy_get(wp), 0, NULL);
+}
+
+ZTEST_SUITE(work_pool, NULL, pool_setup, pool_before, NULL, NULL);
+
+#endif /* CONFIG_WORK_QUEUE_POOL */
@@ -0,0 +1,133 @@
+/*
+ * Copyright (c) 2022 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/ztest.h>
+
+#ifdef CONFIG_WORK_DELAYABLE_SLACK
+
+#define N_SLACK_WORK 3
+#define SLACK_MS 50
+
+static struct k_work_delayable slack_work[N_SLACK_WORK];
+static int64_t fired_ms[N_SLACK_WORK];
+static struct k_sem fired_sem;
+static struct k_work_sync slack_sync;
+
+static void slack_handler(struct k_work *work)
+{
+	struct k_work_delayable *dwork = k_work_delayable_from_work(work);
+
+	fired_ms[dwork - slack_work] = k_uptime_get();
+	k_sem_give(&fired_sem);
+}
+
+static void slack_before(void *fixture)
+{
+	ARG_UNUSED(fixture);
+
+	k_sem_init(&fired_sem, 0, N_SLACK_WORK);
+
+	for (int i = 0; i < N_SLACK_WORK; i++) {
+		k_work_init_delayable(&slack_work[i], slack_handler);
+		k_work_delayable_slack_set(&slack_work[i], K_MSEC(SLACK_MS));
+		fired_ms[i] = 0;
+	}
+}
+
+static void slack_after(void *fixture)
+{
+	ARG_UNUSED(fixture);
+
+	for (int i = 0; i < N_SLACK_WORK; i++) {
+		(void)k_work_cancel_delayable_sync(&slack_work[i], &slack_sync);
+	}
+}
+
+/* Items expiring within each other's slack share a timeout. */
+ZTEST(work_slack, test_slack_coalesce)
+{
+	int64_t start = k_uptime_get();
+
+	zassert_equal(k_work_schedule(&slack_work[0], K_MSEC(100)), 1, NULL);
+	zassert_equal(k_work_schedule(&slack_work[1], K_MSEC(120)), 1, NULL);
+	zassert_equal(k_work_schedule(&slack_work[2], K_MSEC(300)), 1, NULL);
+
+	zassert_equal(k_work_delayable_expires_get(&slack_work[0]),
+		      k_work_delayable_expires_get(&slack_work[1]), NULL);
+	zassert_not_equal(k_work_delayable_expires_get(&slack_work[0]),
+			  k_work_delayable_expires_get(&slack_work[2]), NULL);
+
+	for (int i = 0; i < N_SLACK_WORK; i++) {
+		zassert_equal(k_sem_take(&fired_sem, K_MSEC(500)), 0, NULL);
+	}
+
+	/* Never early, and late by no more than the slack */
+	zassert_true(fired_ms[0] - start >= 100, NULL);
+	zassert_true(fired_ms[1] - start >= 120, NULL);
+	zassert_true(fired_ms[2] - start >= 300, NULL);
+	zassert_true(fired_ms[0] - start <= 100 + SLACK_MS + 10, NULL);
+	zassert_true(fired_ms[2] - start <= 300 + SLACK_MS + 10, NULL);
+}
+
+/* Cancelling the item owning a shared timeout keeps the others on time. */
+ZTEST(work_slack, test_slack_cancel_leader)
+{
+	int64_t start = k_uptime_get();
+	k_ticks_t expires;
+
+	zassert_equal(k_work_schedule(&slack_work[0], K_MSEC(100)), 1, NULL);
+	zassert_equal(k_work_schedule(&slack_work[1], K_MSEC(110)), 1, NULL);
+	expires = k_work_delayable_expires_get(&slack_work[1]);
+
+	zassert_equal(k_work_cancel_delayable(&slack_work[0]), 0, NULL);
+	zassert_equal(k_work_delayable_busy_get(&slack_work[1]),
+		      K_WORK_DELAYED, NULL);
+	zassert_equal(k_work_delayable_expires_get(&slack_work[1]), expires,
+		      NULL);
+
+	zassert_equal(k_sem_take(&fired_sem, K_MSEC(500)), 0, NULL);
+	zassert_equal(fired_ms[0], 0, "cancelled item ran");
+	zassert_true(fired_ms[1] - start >= 110, NULL);
+	zassert_equal(k_sem_take(&fired_sem, K_MSEC(100)), -EAGAIN, NULL);
+}
+
+/* Rescheduling an item leaves the timeout it shared. */
+ZTEST(work_slack, test_slack_reschedule)
+{
+	int64_t start = k_uptime_get();
+
+	zassert_equal(k_work_schedule(&slack_work[0], K_MSEC(200)), 1, NULL);
+	zassert_equal(k_work_schedule(&slack_work[1], K_MSEC(210)), 1, NULL);
+	zassert_equal(k_work_reschedule(&slack_work[1], K_MSEC(20)), 1, NULL);
+
+	zassert_equal(k_sem_take(&fired_sem, K_MSEC(150)), 0, NULL);
+	zassert_true(fired_ms[1] - start >= 20, NULL);
+	zassert_equal(fired_ms[0], 0, NULL);
+
+	zassert_equal(k_sem_take(&fired_sem, K_MSEC(500)), 0, NULL);
+	zassert_true(fired_ms[0] - start >= 200, NULL);
+}
+
+/* An item scheduled forever never fires, even next to one which does. */
+ZTEST(work_slack, test_slack_forever)
+{
+	zassert_equal(k_work_schedule(&slack_work[0], K_MSEC(20)), 1, NULL);
+	zassert_equal(k_work_schedule(&slack_work[1], K_FOREVER), 1, NULL);
+	zassert_equal(k_work_delayable_busy_get(&slack_work[1]),
+		      K_WORK_DELAYED, NULL);
+
+	zassert_equal(k_sem_take(&fired_sem, K_MSEC(500)), 0, NULL);
+	zassert_not_equal(fired_ms[0], 0, NULL);
+	zassert_equal(k_sem_take(&fired_sem, K_MSEC(2 * SLACK_MS)), -EAGAIN,
+		      NULL);
+	zassert_equal(fired_ms[1], 0, "item scheduled forever ran");
+	zassert_equal(k_work_delayable_busy_get(&slack_work[1]),
+		      K_WORK_DELAYED, NULL);
+}
+
+ZTEST_SUITE(work_slack, NULL, NULL, slack_before, slack_after, NULL);
+
+#endif /* CONFIG_WORK_DELAYABLE_SLACK */
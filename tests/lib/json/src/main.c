@@ -662,4 +662,308 @@ ZTEST(lib_json_test, test_json_encode_bounds_check)
 	zassert_equal(ret, -ENOMEM, "Bounds check failed");
 }
 
+static int stream_obj_parse_chunked(const char *encoded, size_t chunk,
+				    const struct json_obj_descr *descr,
+				    size_t descr_len, void *val,
+				    char *buf, size_t buf_size)
+{
+	struct json_stream_obj obj;
+	size_t len = strlen(encoded);
+	int ret = -EAGAIN;
+
+	json_stream_obj_parse_init(&obj, descr, descr_len, val, buf, buf_size);
+
+	for (size_t i = 0; i < len; i += chunk) {
+		ret = json_stream_obj_parse(&obj, &encoded[i],
+					    MIN(chunk, len - i));
+	}
+
+	return ret;
+}
+
+ZTEST(lib_json_test, test_json_stream_tokens)
+{
+	static const struct {
+		enum json_tokens type;
+		bool key;
+		const char *str;
+	} expected[] = {
+		{ JSON_TOK_OBJECT_START },
+		{ JSON_TOK_STRING, true, "a" },
+		{ JSON_TOK_ARRAY_START },
+		{ JSON_TOK_NUMBER, false, "1" },
+		{ JSON_TOK_NUMBER, false, "-2.5e+3" },
+		{ JSON_TOK_TRUE },
+		{ JSON_TOK_FALSE },
+		{ JSON_TOK_NULL },
+		{ JSON_TOK_STRING, false, "x\\\"y\\u00e9" },
+		{ JSON_TOK_ARRAY_END },
+		{ JSON_TOK_STRING, true, "b" },
+		{ JSON_TOK_OBJECT_START },
+		{ JSON_TOK_OBJECT_END },
+		{ JSON_TOK_OBJECT_END },
+	};
+	const char encoded[] = " {\"a\" : [1,-2.5e+3, true,false,null,"
+			       "\"x\\\"y\\u00e9\"],\n\"b\":{ } }\n";
+	struct json_stream_token tok;
+	struct json_stream stream;
+	char buf[16];
+
+	/* Whole, then byte by byte */
+	for (size_t chunk = sizeof(encoded) - 1; chunk > 0;
+	     chunk = (chunk == 1) ? 0 : 1) {
+		const char *data = encoded;
+		size_t len = 0;
+		size_t i = 0;
+		int ret;
+
+		json_stream_init(&stream, buf, sizeof(buf));
+
+		while (true) {
+			if (len == 0 && data < encoded + sizeof(encoded) - 1) {
+				len = MIN(chunk, encoded + sizeof(encoded) - 1 - data);
+			}
+
+			ret = json_stream_next(&stream, &data, &len, &tok);
+			if (ret == -EAGAIN) {
+				zassert_true(data < encoded + sizeof(encoded) - 1,
+					     "Document not complete at its end");
+				continue;
+			}
+			if (ret <= 0) {
+				break;
+			}
+
+			zassert_true(i < ARRAY_SIZE(expected), "Too many tokens");
+			zassert_equal(tok.type, expected[i].type,
+				      "Token %zu has wrong type", i);
+			zassert_equal(tok.key, expected[i].key,
+				      "Token %zu has wrong key flag", i);
+			if (expected[i].str != NULL) {
+				zassert_equal(tok.length, strlen(expected[i].str),
+					      "Token %zu has wrong length", i);
+				zassert_true(!strcmp(tok.start, expected[i].str),
+					     "Token %zu has wrong contents", i);
+			}
+			i++;
+		}
+
+		zassert_equal(ret, 0, "Stream parsing failed: %d", ret);
+		zassert_equal(i, ARRAY_SIZE(expected), "Missing tokens");
+		zassert_equal(data, encoded + sizeof(encoded) - 1,
+			      "Trailing whitespace not consumed");
+	}
+}
+
+ZTEST(lib_json_test, test_json_stream_decoding)
+{
+	/* Same as test_json_decoding, with the comma the streaming parser
+	 * requires after some_array.
+	 */
+	const char encoded[] = "{\"some_string\":\"zephyr 123\\uABCD456\","
+		"\"some_int\":\t42\n,"
+		"\"some_bool\":true    \t  "
+		"\n"
+		"\r   ,"
+		"\"some_nested_struct\":{    "
+		"\"nested_int\":-1234,\n\n"
+		"\"nested_bool\":false,\t"
+		"\"nested_string\":\"this should be escaped: \\t\"},"
+		"\"some_array\":[11,22, 33,\t45,\n299],"
+		"\"another_b!@l\":true,"
+		"\"if\":false,"
+		"\"another-array\":[2,3,5,7],"
+		"\"4nother_ne$+\":{\"nested_int\":1234,"
+		"\"nested_bool\":true,"
+		"\"nested_string\":\"no escape necessary\"}"
+		"}\n";
+	char payload[sizeof(encoded)];
+	struct test_struct expected;
+	struct test_struct ts;
+	char buf[96];
+	int ret;
+
+	memcpy(payload, encoded, sizeof(encoded));
+	ret = json_obj_parse(payload, sizeof(payload) - 1, test_descr,
+			     ARRAY_SIZE(test_descr), &expected);
+	zassert_equal(ret, (1 << ARRAY_SIZE(test_descr)) - 1,
+		      "Not all fields decoded correctly");
+
+	for (size_t chunk = 1; chunk < sizeof(encoded); chunk++) {
+		memset(&ts, 0, sizeof(ts));
+		ret = stream_obj_parse_chunked(encoded, chunk, test_descr,
+					       ARRAY_SIZE(test_descr), &ts,
+					       buf, sizeof(buf));
+		zassert_equal(ret, (1 << ARRAY_SIZE(test_descr)) - 1,
+			      "Not all fields decoded with chunks of %zu", chunk);
+
+		zassert_true(!strcmp(ts.some_string, expected.some_string),
+			     "String not decoded correctly");
+		zassert_equal(ts.some_int, expected.some_int,
+			      "Integer not decoded correctly");
+		zassert_equal(ts.some_bool, expected.some_bool,
+			      "Boolean not decoded correctly");
+		zassert_equal(ts.some_nested_struct.nested_int,
+			      expected.some_nested_struct.nested_int,
+			      "Nested integer not decoded correctly");
+		zassert_equal(ts.some_nested_struct.nested_bool,
+			      expected.some_nested_struct.nested_bool,
+			      "Nested boolean not decoded correctly");
+		zassert_true(!strcmp(ts.some_nested_struct.nested_string,
+				     expected.some_nested_struct.nested_string),
+			     "Nested string not decoded correctly");
+		zassert_equal(ts.some_array_len, expected.some_array_len,
+			      "Array doesn't have correct number of items");
+		zassert_true(!memcmp(ts.some_array, expected.some_array,
+				     sizeof(int) * expected.some_array_len),
+			     "Array not decoded correctly");
+		zassert_equal(ts.another_bxxl, expected.another_bxxl,
+			      "Named boolean not decoded correctly");
+		zassert_equal(ts.if_, expected.if_,
+			      "Named boolean not decoded correctly");
+		zassert_equal(ts.another_array_len, expected.another_array_len,
+			      "Named array doesn't have correct number of items");
+		zassert_true(!memcmp(ts.another_array, expected.another_array,
+				     sizeof(int) * expected.another_array_len),
+			     "Named array not decoded correctly");
+		zassert_equal(ts.xnother_nexx.nested_int,
+			      expected.xnother_nexx.nested_int,
+			      "Named nested integer not decoded correctly");
+		zassert_equal(ts.xnother_nexx.nested_bool,
+			      expected.xnother_nexx.nested_bool,
+			      "Named nested boolean not decoded correctly");
+		zassert_true(!strcmp(ts.xnother_nexx.nested_string,
+				     expected.xnother_nexx.nested_string),
+			     "Named nested string not decoded correctly");
+	}
+}
+
+ZTEST(lib_json_test, test_json_stream_decoding_arrays)
+{
+	const char obj_array[] = "{\"elements\":["
+				 "{\"height\":168,\"name\":\"Simón Bolívar\"},"
+				 "{\"height\":173,\"name\":\"Pelé\"},"
+				 "{\"height\":195,\"name\":\"Usain Bolt\"}]}";
+	const char array_array[] = "{\"objects_array\":["
+				   "[{\"height\":168,\"name\":\"Simón Bolívar\"}],"
+				   "[{\"height\":173,\"name\":\"Pelé\"}],"
+				   "[{\"height\":195,\"name\":\"Usain Bolt\"}]]"
+				   "}";
+	static const char *const names[] = { "Simón Bolívar", "Pelé", "Usain Bolt" };
+	static const int heights[] = { 168, 173, 195 };
+	struct obj_array_array aa;
+	struct obj_array oa;
+	char buf[64];
+	int ret;
+
+	for (size_t chunk = 1; chunk < sizeof(array_array); chunk++) {
+		ret = stream_obj_parse_chunked(obj_array, chunk, obj_array_descr,
+					       ARRAY_SIZE(obj_array_descr), &oa,
+					       buf, sizeof(buf));
+		zassert_equal(ret, 1, "Array of objects not decoded: %d", ret);
+		zassert_equal(oa.num_elements, 3,
+			      "Array doesn't have correct number of items");
+
+		ret = stream_obj_parse_chunked(array_array, chunk,
+					       array_array_descr,
+					       ARRAY_SIZE(array_array_descr), &aa,
+					       buf, sizeof(buf));
+		zassert_equal(ret, 1, "Array of arrays not decoded: %d", ret);
+		zassert_equal(aa.objects_array_len, 3,
+			      "Array doesn't have correct number of items");
+
+		for (int i = 0; i < 3; i++) {
+			zassert_true(!strcmp(oa.elements[i].name, names[i]),
+				     "String not decoded correctly");
+			zassert_equal(oa.elements[i].height, heights[i],
+				      "Height not decoded correctly");
+			zassert_true(!strcmp(aa.objects_array[i].objects.name,
+					     names[i]),
+				     "String not decoded correctly");
+			zassert_equal(aa.objects_array[i].objects.height,
+				      heights[i], "Height not decoded correctly");
+		}
+	}
+}
+
+ZTEST(lib_json_test, test_json_stream_skip_unknown)
+{
+	const char encoded[] = "{\"unknown\":{\"some_int\":[1,{\"x\":[]}]},"
+			       "\"some_int\":5,\"other\":[[],{}],"
+			       "\"some_int\":6,\"some_bool\":true}";
+	struct test_struct ts;
+	char buf[16];
+	int ret;
+
+	for (size_t chunk = 1; chunk < sizeof(encoded); chunk++) {
+		ret = stream_obj_parse_chunked(encoded, chunk, test_descr,
+					       ARRAY_SIZE(test_descr), &ts,
+					       buf, sizeof(buf));
+		zassert_equal(ret, BIT(1) | BIT(2), "Unexpected result %d", ret);
+		zassert_equal(ts.some_int, 5, "Integer not decoded correctly");
+		zassert_true(ts.some_bool, "Boolean not decoded correctly");
+	}
+}
+
+ZTEST(lib_json_test, test_json_stream_invalid)
+{
+	struct encoding_test encoded[] = {
+		{ "{\"some_string\":\"\\uABC@\"}", -EINVAL },
+		{ "{\"some_string\":\"\\X\"}", -EINVAL },
+		{ "{\"some_bool\":truffle }", -EINVAL },
+		{ "{\"some_string\":null }", -EINVAL },
+		{ "{\"some_int\":xxx }", -EINVAL },
+		{ "{\"some_int\":1- }", -EINVAL },
+		{ "{\"some_string\",}", -EINVAL },
+		{ "{\"some_string\":false}", -EINVAL },
+		{ "{\"some_int\" 1}", -EINVAL },
+		{ "{\"some_int\":1,}", -EINVAL },
+		{ "{\"some_int\":1 \"some_bool\":true}", -EINVAL },
+		{ "{\"some_array\":[1,2}", -EINVAL },
+		{ "[{\"some_int\":1}]", -EINVAL },
+		{ "{\"some_int\":1}}", -EINVAL },
+		{ "{\"some_int\":1} x", -EINVAL },
+		{ "{\"some_int\":1} \n", BIT(1) },
+		{ "{\"another-array\":[1,2,3,4,5,6,7,8,9,10,11]}", -ENOSPC },
+		{ "{\"some_string\":\"too long for the buffer\"}", -ENOMEM },
+		{ "{\"unknown\":[[[[[[[[[[[[[[[[[[[[[[[[[[[[[[[[]]]]]]]]]]]]]]]"
+		  "]]]]]]]]]]]]]]]]]}", -E2BIG },
+	};
+	struct test_struct ts;
+	char buf[16];
+	int ret;
+
+	for (int i = 0; i < ARRAY_SIZE(encoded); i++) {
+		ret = stream_obj_parse_chunked(encoded[i].str, 1, test_descr,
+					       ARRAY_SIZE(test_descr), &ts,
+					       buf, sizeof(buf));
+		zassert_equal(ret, encoded[i].result,
+			      "Decoding '%s' result %d, expected %d",
+			      encoded[i].str, ret, encoded[i].result);
+	}
+}
+
+ZTEST(lib_json_test, test_json_stream_obj_array_unsupported)
+{
+	struct obj_array_data {
+		struct json_obj_token arr;
+	} data;
+	const struct json_obj_descr descr[] = {
+		JSON_OBJ_DESCR_PRIM(struct obj_array_data, arr, JSON_TOK_OBJ_ARRAY),
+	};
+	const char encoded[] = "{\"arr\":[{\"a\":1}]}";
+	struct json_stream_obj obj;
+	char buf[16];
+	int ret;
+
+	json_stream_obj_parse_init(&obj, descr, ARRAY_SIZE(descr), &data,
+				   buf, sizeof(buf));
+	ret = json_stream_obj_parse(&obj, encoded, sizeof(encoded) - 1);
+	zassert_equal(ret, -ENOTSUP, "Unexpected result %d", ret);
+
+	/* Errors are final */
+	ret = json_stream_obj_parse(&obj, "}", 1);
+	zassert_equal(ret, -ENOTSUP, "Unexpected result %d", ret);
+}
+
 ZTEST_SUITE(lib_json_test, NULL, NULL, NULL, NULL, NULL);
@@ -0,0 +1,308 @@
+/*
+ * Copyright (c) 2022 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#include <zephyr/ztest.h>
+#include <zephyr/ztress.h>
+#include <zephyr/sys/mpsc_ring_buffer.h>
+
+#define N_PRODUCERS 3
+
+MPSC_RING_BUF_DECLARE(mpsc_ringbuf, 64);
+MPSC_RING_BUF_DECLARE(mpsc_stressbuf, 256);
+
+static void mpsc_reset(struct mpsc_ring_buf *buf)
+{
+	mpsc_ring_buf_init(buf, mpsc_ring_buf_capacity_get(buf), buf->buffer);
+}
+
+static void fill(uint8_t *data, uint32_t len, uint8_t seed)
+{
+	for (uint32_t i = 0; i < len; i++) {
+		data[i] = seed + i;
+	}
+}
+
+static void check(const uint8_t *data, uint32_t len, uint8_t seed)
+{
+	for (uint32_t i = 0; i < len; i++) {
+		zassert_equal(data[i], (uint8_t)(seed + i),
+			      "Got %02x, exp: %02x", data[i], (uint8_t)(seed + i));
+	}
+}
+
+ZTEST(mpsc_ringbuffer_api, test_mpsc_ringbuffer_put_get)
+{
+	uint8_t in[20], out[20];
+	uint8_t *data;
+	uint32_t len;
+
+	mpsc_reset(&mpsc_ringbuf);
+	fill(in, sizeof(in), 0);
+
+	/* Records of 5, 7 and 8 bytes take 12, 12 and 12 bytes */
+	zassert_equal(mpsc_ring_buf_put(&mpsc_ringbuf, in, 5), 5);
+	zassert_equal(mpsc_ring_buf_put(&mpsc_ringbuf, &in[5], 7), 7);
+	zassert_equal(mpsc_ring_buf_put(&mpsc_ringbuf, &in[12], 8), 8);
+	zassert_equal(mpsc_ring_buf_space_get(&mpsc_ringbuf), 64 - 36);
+
+	/* Records read one at a time */
+	len = mpsc_ring_buf_get_claim(&mpsc_ringbuf, &data, UINT32_MAX);
+	zassert_equal(len, 5);
+	check(data, len, 0);
+	zassert_equal(mpsc_ring_buf_get_finish(&mpsc_ringbuf, len), 0);
+	zassert_equal(mpsc_ring_buf_space_get(&mpsc_ringbuf), 64 - 24);
+
+	/* Or as a byte stream */
+	zassert_equal(mpsc_ring_buf_get(&mpsc_ringbuf, out, 3), 3);
+	check(out, 3, 5);
+	zassert_equal(mpsc_ring_buf_get(&mpsc_ringbuf, out, sizeof(out)), 12);
+	check(out, 12, 8);
+	zassert_equal(mpsc_ring_buf_get(&mpsc_ringbuf, out, sizeof(out)), 0);
+	zassert_equal(mpsc_ring_buf_space_get(&mpsc_ringbuf), 64);
+}
+
+ZTEST(mpsc_ringbuffer_api, test_mpsc_ringbuffer_in_order_commit)
+{
+	uint8_t *a, *b, *data;
+
+	mpsc_reset(&mpsc_ringbuf);
+
+	zassert_equal(mpsc_ring_buf_put_claim(&mpsc_ringbuf, &a, 4), 4);
+	zassert_equal(mpsc_ring_buf_put_claim(&mpsc_ringbuf, &b, 4), 4);
+	zassert_true(b > a);
+
+	fill(b, 4, 0xb0);
+	zassert_equal(mpsc_ring_buf_put_finish(&mpsc_ringbuf, b, 4), 0);
+
+	/* b waits for a, reserved before it */
+	zassert_equal(mpsc_ring_buf_get_claim(&mpsc_ringbuf, &data, 4), 0);
+
+	fill(a, 4, 0xa0);
+	zassert_equal(mpsc_ring_buf_put_finish(&mpsc_ringbuf, a, 4), 0);
+
+	zassert_equal(mpsc_ring_buf_get_claim(&mpsc_ringbuf, &data, 4), 4);
+	check(data, 4, 0xa0);
+	zassert_equal(mpsc_ring_buf_get_finish(&mpsc_ringbuf, 4), 0);
+	zassert_equal(mpsc_ring_buf_get_claim(&mpsc_ringbuf, &data, 4), 4);
+	check(data, 4, 0xb0);
+	zassert_equal(mpsc_ring_buf_get_finish(&mpsc_ringbuf, 4), 0);
+}
+
+ZTEST(mpsc_ringbuffer_api, test_mpsc_ringbuffer_wrap)
+{
+	uint8_t in[28];
+	uint8_t *data;
+
+	mpsc_reset(&mpsc_ringbuf);
+	fill(in, sizeof(in), 0);
+
+	zassert_equal(mpsc_ring_buf_put(&mpsc_ringbuf, in, 28), 28);
+	zassert_equal(mpsc_ring_buf_put(&mpsc_ringbuf, in, 8), 8);
+	zassert_equal(mpsc_ring_buf_get(&mpsc_ringbuf, NULL, 36), 36);
+
+	/* 20 bytes are left before the end, too few for this record */
+	zassert_equal(mpsc_ring_buf_put_claim(&mpsc_ringbuf, &data, 24), 24);
+	zassert_equal_ptr(data, (uint8_t *)mpsc_ringbuf.buffer + 4);
+	zassert_equal(mpsc_ring_buf_space_get(&mpsc_ringbuf), 64 - 20 - 28);
+
+	/* The skipped space only returns once the consumer gets past it */
+	zassert_equal(mpsc_ring_buf_put_claim(&mpsc_ringbuf, &data, 20), 0);
+
+	fill(data, 24, 0x40);
+	zassert_equal(mpsc_ring_buf_put_finish(&mpsc_ringbuf, data, 24), 0);
+
+	zassert_equal(mpsc_ring_buf_get_claim(&mpsc_ringbuf, &data, UINT32_MAX), 24);
+	check(data, 24, 0x40);
+	zassert_equal(mpsc_ring_buf_get_finish(&mpsc_ringbuf, 24), 0);
+	zassert_equal(mpsc_ring_buf_space_get(&mpsc_ringbuf), 64);
+}
+
+ZTEST(mpsc_ringbuffer_api, test_mpsc_ringbuffer_finish_short)
+{
+	uint8_t *data;
+
+	mpsc_reset(&mpsc_ringbuf);
+
+	zassert_equal(mpsc_ring_buf_put_claim(&mpsc_ringbuf, &data, 28), 28);
+	fill(data, 5, 0);
+	zassert_equal(mpsc_ring_buf_put_finish(&mpsc_ringbuf, data, 5), 0);
+
+	/* Discarded */
+	zassert_equal(mpsc_ring_buf_put_claim(&mpsc_ringbuf, &data, 8), 8);
+	zassert_equal(mpsc_ring_buf_put_finish(&mpsc_ringbuf, data, 0), 0);
+
+	zassert_equal(mpsc_ring_buf_put_claim(&mpsc_ringbuf, &data, 3), 3);
+	fill(data, 3, 0x30);
+	zassert_equal(mpsc_ring_buf_put_finish(&mpsc_ringbuf, data, 3), 0);
+
+	/* Partial claims within a record */
+	zassert_equal(mpsc_ring_buf_get_claim(&mpsc_ringbuf, &data, 2), 2);
+	check(data, 2, 0);
+	zassert_equal(mpsc_ring_buf_get_claim(&mpsc_ringbuf, &data, 8), 3);
+	check(data, 3, 2);
+	zassert_equal(mpsc_ring_buf_get_finish(&mpsc_ringbuf, 5), 0);
+
+	zassert_equal(mpsc_ring_buf_get_claim(&mpsc_ringbuf, &data, 8), 3);
+	check(data, 3, 0x30);
+	zassert_equal(mpsc_ring_buf_get_finish(&mpsc_ringbuf, 3), 0);
+
+	zassert_equal(mpsc_ring_buf_get_claim(&mpsc_ringbuf, &data, 8), 0);
+	zassert_equal(mpsc_ring_buf_space_get(&mpsc_ringbuf), 64);
+}
+
+ZTEST(mpsc_ringbuffer_api, test_mpsc_ringbuffer_invalid)
+{
+	uint8_t *data;
+
+	mpsc_reset(&mpsc_ringbuf);
+
+	zassert_equal(mpsc_ring_buf_put_claim(&mpsc_ringbuf, &data, 0), 0);
+	/* More than half the buffer with its header */
+	zassert_equal(mpsc_ring_buf_put_claim(&mpsc_ringbuf, &data, 29), 0);
+
+	zassert_equal(mpsc_ring_buf_put_claim(&mpsc_ringbuf, &data, 28), 28);
+	zassert_equal(mpsc_ring_buf_put_finish(&mpsc_ringbuf, data, 29), -EINVAL);
+	zassert_equal(mpsc_ring_buf_put_finish(&mpsc_ringbuf, data, 28), 0);
+	zassert_equal(mpsc_ring_buf_put_finish(&mpsc_ringbuf, data, 28), -EINVAL);
+
+	zassert_equal(mpsc_ring_buf_put_claim(&mpsc_ringbuf, &data, 28), 28);
+	zassert_equal(mpsc_ring_buf_put_finish(&mpsc_ringbuf, data, 28), 0);
+
+	/* Full */
+	zassert_equal(mpsc_ring_buf_put_claim(&mpsc_ringbuf, &data, 1), 0);
+
+	zassert_equal(mpsc_ring_buf_get_claim(&mpsc_ringbuf, &data, 10), 10);
+	zassert_equal(mpsc_ring_buf_get_finish(&mpsc_ringbuf, 11), -EINVAL);
+	zassert_equal(mpsc_ring_buf_get_finish(&mpsc_ringbuf, 10), 0);
+	zassert_equal(mpsc_ring_buf_get_finish(&mpsc_ringbuf, 1), -EINVAL);
+	zassert_equal(mpsc_ring_buf_get(&mpsc_ringbuf, NULL, 64), 46);
+}
+
+/* The largest record fits in an empty buffer whatever the offset the
+ * previous records left it at, even when it needs padding.
+ */
+ZTEST(mpsc_ringbuffer_api, test_mpsc_ringbuffer_max_record)
+{
+	uint32_t max = mpsc_ring_buf_capacity_get(&mpsc_ringbuf) / 2 - 4;
+	uint8_t in[28];
+	uint8_t *data;
+
+	mpsc_reset(&mpsc_ringbuf);
+	fill(in, sizeof(in), 0);
+
+	for (uint32_t i = 0; i < 32; i++) {
+		uint32_t len = 1 + (i * 5) % max;
+
+		zassert_equal(mpsc_ring_buf_put(&mpsc_ringbuf, in, len), len);
+		zassert_equal(mpsc_ring_buf_get(&mpsc_ringbuf, NULL, len), len);
+		zassert_equal(mpsc_ring_buf_space_get(&mpsc_ringbuf), 64);
+
+		zassert_equal(mpsc_ring_buf_put_claim(&mpsc_ringbuf, &data, max),
+			      max, "head at %u",
+			      (uint32_t)atomic_get(&mpsc_ringbuf.put_head) % 64);
+		zassert_equal(mpsc_ring_buf_put_finish(&mpsc_ringbuf, data, max), 0);
+		zassert_equal(mpsc_ring_buf_get(&mpsc_ringbuf, NULL, max), max);
+	}
+}
+
+/* Each producer writes records of its id and a sequence number, followed
+ * by a pattern of varying length. The consumer checks that no record of
+ * a producer is lost, reordered or mixed with those of other producers.
+ */
+struct record {
+	uint32_t id;
+	uint32_t seq;
+	uint8_t pattern[];
+};
+
+static uint32_t produced[N_PRODUCERS];
+static uint32_t consumed[N_PRODUCERS];
+
+static uint32_t record_len(uint32_t seq)
+{
+	return sizeof(struct record) + seq % 23;
+}
+
+static bool mpsc_produce(void *user_data, uint32_t cnt, bool last, int prio)
+{
+	uint32_t id = POINTER_TO_UINT(user_data);
+	uint32_t seq = produced[id];
+	uint32_t len = record_len(seq);
+	struct record *rec;
+	uint8_t *data;
+
+	if (mpsc_ring_buf_put_claim(&mpsc_stressbuf, &data, len) == 0) {
+		return true;
+	}
+
+	rec = (struct record *)data;
+	rec->id = id;
+	rec->seq = seq;
+	fill(rec->pattern, len - sizeof(*rec), (uint8_t)seq);
+
+	zassert_equal(mpsc_ring_buf_put_finish(&mpsc_stressbuf, data, len), 0);
+	produced[id] = seq + 1;
+
+	return true;
+}
+
+static bool mpsc_consume(void *user_data, uint32_t cnt, bool last, int prio)
+{
+	struct record *rec;
+	uint8_t *data;
+	uint32_t len;
+
+	while ((len = mpsc_ring_buf_get_claim(&mpsc_stressbuf, &data,
+					      UINT32_MAX)) != 0) {
+		rec = (struct record *)data;
+
+		zassert_true(rec->id < N_PRODUCERS, "id %u", rec->id);
+		zassert_equal(rec->seq, consumed[rec->id], "producer %u", rec->id);
+		zassert_equal(len, record_len(rec->seq));
+		check(rec->pattern, len - sizeof(*rec), (uint8_t)rec->seq);
+
+		consumed[rec->id]++;
+		zassert_equal(mpsc_ring_buf_get_finish(&mpsc_stressbuf, len), 0);
+	}
+
+	return true;
+}
+
+/* Producers in a timer and two threads, which run on different CPUs on
+ * SMP targets, with the consumer at the lowest priority.
+ */
+ZTEST(mpsc_ringbuffer_api, test_mpsc_ringbuffer_stress)
+{
+	k_timeout_t timeout;
+
+	mpsc_reset(&mpsc_stressbuf);
+	memset(produced, 0, sizeof(produced));
+	memset(consumed, 0, sizeof(consumed));
+
+	/* Force the free running indexes to roll over */
+	atomic_set(&mpsc_stressbuf.put_head, (atomic_val_t)(UINT32_MAX - 1023U));
+	atomic_set(&mpsc_stressbuf.get_tail, (atomic_val_t)(UINT32_MAX - 1023U));
+
+	timeout = (CONFIG_SYS_CLOCK_TICKS_PER_SEC < 10000) ? K_MSEC(1000) : K_MSEC(10000);
+
+	ztress_set_timeout(timeout);
+	ZTRESS_EXECUTE(ZTRESS_TIMER(mpsc_produce, UINT_TO_POINTER(0), 0, Z_TIMEOUT_TICKS(20)),
+		       ZTRESS_THREAD(mpsc_produce, UINT_TO_POINTER(1), 0, 0,
+				     Z_TIMEOUT_TICKS(20)),
+		       ZTRESS_THREAD(mpsc_produce, UINT_TO_POINTER(2), 0, 10,
+				     Z_TIMEOUT_TICKS(20)),
+		       ZTRESS_THREAD(mpsc_consume, NULL, 0, 2000, Z_TIMEOUT_TICKS(20)));
+
+	(void)mpsc_consume(NULL, 0, true, 0);
+
+	for (int i = 0; i < N_PRODUCERS; i++) {
+		zassert_true(produced[i] > 0, "producer %d starved", i);
+		zassert_equal(consumed[i], produced[i], "producer %d", i);
+	}
+	zassert_equal(mpsc_ring_buf_space_get(&mpsc_stressbuf),
+		      mpsc_ring_buf_capacity_get(&mpsc_stressbuf));
+}
+
+ZTEST_SUITE(mpsc_ringbuffer_api, NULL, NULL, NULL, NULL, NULL);
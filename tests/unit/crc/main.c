@@ -4,6 +4,7 @@
  * SPDX-License-Identifier: Apache-2.0
  */
 
+#include <stdlib.h>
 #include <zephyr/ztest.h>
 #include <zephyr/sys/crc.h>
 #include "../../../lib/os/crc8_sw.c"
@@ -11,6 +12,9 @@
 #include "../../../lib/os/crc32_sw.c"
 #include "../../../lib/os/crc32c_sw.c"
 #include "../../../lib/os/crc7_sw.c"
+#ifdef CONFIG_CRC32_X86
+#include "../../../lib/os/crc32_x86.c"
+#endif
 
 ZTEST(crc, test_crc32c)
 {
@@ -50,6 +54,60 @@ ZTEST(crc, test_crc32_ieee)
 	zassert_equal(crc32_ieee(test3, sizeof(test3)), 0x20089AA4);
 }
 
+/* Bitwise reference for the reflected CRC32 variants */
+static uint32_t crc32_reference(uint32_t poly, const uint8_t *data, size_t len)
+{
+	uint32_t crc = 0xffffffff;
+
+	for (size_t i = 0; i < len; i++) {
+		crc ^= data[i];
+		for (int b = 0; b < 8; b++) {
+			crc = (crc >> 1) ^ ((crc & 1) ? poly : 0);
+		}
+	}
+
+	return ~crc;
+}
+
+ZTEST(crc, test_crc32_equivalence)
+{
+	static uint8_t buf[1024 + 8];
+
+	srand(12345);
+	for (size_t i = 0; i < sizeof(buf); i++) {
+		buf[i] = (uint8_t)rand();
+	}
+
+	/* Every length around the slicing and folding block sizes, at
+	 * every alignment
+	 */
+	for (size_t off = 0; off < 8; off++) {
+		for (size_t len = 0; len <= 300; len++) {
+			zassert_equal(crc32_ieee(buf + off, len),
+				      crc32_reference(0xedb88320, buf + off, len),
+				      "crc32_ieee off %zu len %zu", off, len);
+			zassert_equal(crc32_c(0, buf + off, len, true, true),
+				      crc32_reference(0x82f63b78, buf + off, len),
+				      "crc32_c off %zu len %zu", off, len);
+		}
+	}
+
+	/* Streams split at every point of a large buffer */
+	for (size_t split = 0; split <= sizeof(buf) - 8; split += 13) {
+		uint32_t crc;
+
+		crc = crc32_ieee_update(crc32_ieee(buf, split), buf + split,
+					sizeof(buf) - split);
+		zassert_equal(crc, crc32_reference(0xedb88320, buf, sizeof(buf)),
+			      "crc32_ieee split %zu", split);
+
+		crc = crc32_c(crc32_c(0, buf, split, true, false), buf + split,
+			      sizeof(buf) - split, false, true);
+		zassert_equal(crc, crc32_reference(0x82f63b78, buf, sizeof(buf)),
+			      "crc32_c split %zu", split);
+	}
+}
+
 ZTEST(crc, test_crc16)
 {
 	uint8_t test[] = { '1', '2', '3', '4', '5', '6', '7', '8', '9' };
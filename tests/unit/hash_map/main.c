@@ -0,0 +1,228 @@
+/*
+ * Copyright (c) 2022 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <limits.h>
+#include <stdlib.h>
+#include <string.h>
+#include <zephyr/ztest.h>
+#include <zephyr/sys/hash_map.h>
+
+#include "../../../lib/os/hash_map.c"
+
+#define CAPACITY 64
+#define MANY 10000
+
+SYS_HASH_MAP_DEFINE_FIXED_STATIC(fixed, SYS_HASH_MAP_KEY_INT, CAPACITY);
+
+static int values[MANY];
+
+/* Allocator failing once the given number of allocations is reached */
+static int allocs_left;
+static int allocated;
+
+static void *test_alloc(void *ptr, size_t size)
+{
+	if (size == 0) {
+		free(ptr);
+		allocated--;
+		return NULL;
+	}
+
+	if (allocs_left == 0) {
+		return NULL;
+	}
+	allocs_left--;
+	allocated++;
+
+	return malloc(size);
+}
+
+static void count_cb(uintptr_t key, void *value, void *user_data)
+{
+	int *count = user_data;
+
+	zassert_equal_ptr(value, &values[key], "bad value for %lu",
+			  (unsigned long)key);
+	(*count)++;
+}
+
+ZTEST(hash_map, test_fixed)
+{
+	void *old;
+	int count = 0;
+
+	zassert_is_null(sys_hash_map_get(&fixed, 0));
+	zassert_is_null(sys_hash_map_remove(&fixed, 0));
+
+	for (int i = 0; i < CAPACITY; i++) {
+		zassert_equal(sys_hash_map_insert(&fixed, i, &values[i], &old), 0);
+		zassert_is_null(old);
+	}
+	zassert_equal(sys_hash_map_size(&fixed), CAPACITY);
+
+	/* Full, but replacement is still possible */
+	zassert_equal(sys_hash_map_insert(&fixed, CAPACITY, &values[0], NULL),
+		      -ENOSPC);
+	zassert_equal(sys_hash_map_insert(&fixed, 3, &values[4], &old), 1);
+	zassert_equal_ptr(old, &values[3]);
+	zassert_equal(sys_hash_map_insert(&fixed, 3, &values[3], NULL), 1);
+
+	for (int i = 0; i < CAPACITY; i++) {
+		zassert_equal_ptr(sys_hash_map_get(&fixed, i), &values[i]);
+	}
+	zassert_is_null(sys_hash_map_get(&fixed, CAPACITY));
+
+	sys_hash_map_foreach(&fixed, count_cb, &count);
+	zassert_equal(count, CAPACITY);
+
+	for (int i = 0; i < CAPACITY; i += 2) {
+		zassert_equal_ptr(sys_hash_map_remove(&fixed, i), &values[i]);
+	}
+	zassert_equal(sys_hash_map_size(&fixed), CAPACITY / 2);
+	for (int i = 0; i < CAPACITY; i++) {
+		zassert_equal_ptr(sys_hash_map_get(&fixed, i),
+				  (i % 2 != 0) ? &values[i] : NULL);
+	}
+
+	sys_hash_map_clear(&fixed);
+	zassert_equal(sys_hash_map_size(&fixed), 0);
+	zassert_is_null(sys_hash_map_get(&fixed, 1));
+}
+
+ZTEST(hash_map, test_strings)
+{
+	static const char *const names[] = {
+		"alpha", "beta", "gamma", "delta", "epsilon", "zeta", "eta",
+		"theta", "", "a", "aa", "aaa",
+	};
+	struct sys_hash_map_slot slots[16];
+	struct sys_hash_map map;
+	char key[16];
+
+	sys_hash_map_init_fixed(&map, SYS_HASH_MAP_KEY_STR, slots,
+				ARRAY_SIZE(slots));
+
+	for (int i = 0; i < ARRAY_SIZE(names); i++) {
+		zassert_equal(sys_hash_map_insert(&map, (uintptr_t)names[i],
+						  &values[i], NULL), 0);
+	}
+
+	/* Keys are compared by content, not address */
+	for (int i = 0; i < ARRAY_SIZE(names); i++) {
+		strcpy(key, names[i]);
+		zassert_equal_ptr(sys_hash_map_get(&map, (uintptr_t)key),
+				  &values[i], "%s", names[i]);
+	}
+
+	zassert_is_null(sys_hash_map_get(&map, (uintptr_t)"aaaa"));
+	zassert_equal_ptr(sys_hash_map_remove(&map, (uintptr_t)"aa"),
+			  &values[10]);
+	zassert_is_null(sys_hash_map_get(&map, (uintptr_t)"aa"));
+	zassert_equal_ptr(sys_hash_map_get(&map, (uintptr_t)"aaa"),
+			  &values[11]);
+}
+
+ZTEST(hash_map, test_dynamic)
+{
+	struct sys_hash_map map;
+	int count = 0;
+
+	sys_hash_map_init_dynamic(&map, SYS_HASH_MAP_KEY_INT, test_alloc);
+	allocs_left = INT_MAX;
+	allocated = 0;
+
+	zassert_is_null(sys_hash_map_get(&map, 0));
+	zassert_is_null(sys_hash_map_remove(&map, 0));
+
+	for (int i = 0; i < MANY; i++) {
+		zassert_equal(sys_hash_map_insert(&map, i, &values[i], NULL), 0);
+	}
+	zassert_equal(sys_hash_map_size(&map), MANY);
+	zassert_equal(allocated, 1, "old arrays not freed");
+	zassert_true(map.capacity * 3 >= MANY * 4, "not grown enough");
+	zassert_true(map.capacity * 3 < MANY * 8, "grown too much");
+
+	for (int i = 0; i < MANY; i++) {
+		zassert_equal_ptr(sys_hash_map_get(&map, i), &values[i]);
+	}
+	sys_hash_map_foreach(&map, count_cb, &count);
+	zassert_equal(count, MANY);
+
+	/* A failed growth leaves the map as it was */
+	allocs_left = 0;
+	while (sys_hash_map_insert(&map, count, &values[0], NULL) == 0) {
+		count++;
+	}
+	zassert_equal(sys_hash_map_insert(&map, count, &values[0], NULL),
+		      -ENOMEM);
+	zassert_equal(sys_hash_map_size(&map), count);
+	for (int i = 0; i < MANY; i++) {
+		zassert_equal_ptr(sys_hash_map_get(&map, i), &values[i]);
+	}
+
+	sys_hash_map_clear(&map);
+	zassert_equal(allocated, 0);
+	zassert_is_null(sys_hash_map_get(&map, 1));
+}
+
+/* Random operations on few enough keys for collisions, removals and
+ * reinsertions, checked against a plain array
+ */
+static void random_ops(struct sys_hash_map *map, size_t max_size)
+{
+	static int *model[CAPACITY * 2];
+	size_t size = 0;
+
+	(void)memset(model, 0, sizeof(model));
+	/* Reproducible */
+	srand(12345);
+
+	for (int n = 0; n < 100000; n++) {
+		uint32_t r = rand();
+		uintptr_t key = r % ARRAY_SIZE(model);
+		int *value = &values[(r >> 8) % MANY];
+		int expected;
+
+		if (((r >> 4) % 3) == 0) {
+			zassert_equal_ptr(sys_hash_map_remove(map, key),
+					  model[key]);
+			size -= (model[key] != NULL) ? 1 : 0;
+			model[key] = NULL;
+		} else {
+			expected = (model[key] != NULL) ? 1 :
+				   (size == max_size) ? -ENOSPC : 0;
+			zassert_equal(sys_hash_map_insert(map, key, value, NULL),
+				      expected);
+			if (expected >= 0) {
+				size += 1 - expected;
+				model[key] = value;
+			}
+		}
+
+		zassert_equal(sys_hash_map_size(map), size);
+		key = rand() % ARRAY_SIZE(model);
+		zassert_equal_ptr(sys_hash_map_get(map, key), model[key]);
+	}
+
+	for (int i = 0; i < ARRAY_SIZE(model); i++) {
+		zassert_equal_ptr(sys_hash_map_get(map, i), model[i]);
+	}
+}
+
+ZTEST(hash_map, test_random)
+{
+	struct sys_hash_map map;
+
+	random_ops(&fixed, CAPACITY);
+	sys_hash_map_clear(&fixed);
+
+	sys_hash_map_init_dynamic(&map, SYS_HASH_MAP_KEY_INT, test_alloc);
+	allocs_left = INT_MAX;
+	random_ops(&map, SIZE_MAX);
+	sys_hash_map_clear(&map);
+}
+
+ZTEST_SUITE(hash_map, NULL, NULL, NULL, NULL, NULL);